@@ -22,6 +22,7 @@
 #include <ArcadeDrive.h>            // This class
 #include <IChassis.h>               // Class the control the drive motors
 #include <IChassisFactory.h>        // Class constructs the correct chassis
+#include <InputSnapshot.h>          // Inputs sampled this cycle
 #include <OperatorInterface.h>      // Controls creating singleton of the gamepads
 
 //--------------------------------------------------------------------
@@ -35,9 +36,7 @@ ArcadeDrive::ArcadeDrive() : IJoystickDrive(),
     m_oi->SetAxisProfile( ARCADE_DRIVE_STEER, CUBIC_SCALING );
     m_oi->SetScaleFactor( ARCADE_DRIVE_STEER, 0.5 );
 
-    // Set to Coast Mode
     m_chassis = IChassisFactory::GetInstance()->GetIChassis();
-    m_chassis->SetCoastMode();
 }
 
 //--------------------------------------------------------------------
@@ -47,17 +46,23 @@ ArcadeDrive::ArcadeDrive() : IJoystickDrive(),
 //              to drive in arcade drive mode.
 // Returns:     void
 //--------------------------------------------------------------------
-void ArcadeDrive::DriveWithJoysticks() const
+void ArcadeDrive::DriveWithJoysticks
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+) const
 {
     // Read the desired motor speeds
-    float steer  = m_oi->GetRawAxis( ARCADE_DRIVE_STEER );
-    float throttle  = m_oi->GetRawAxis( ARCADE_DRIVE_THROTTLE );
+    float steer  = inputs.axis[ ARCADE_DRIVE_STEER ];
+    float throttle  = inputs.axis[ ARCADE_DRIVE_THROTTLE ];
 
     // Convert to using arcade equations to give motor speeds on
     // both sides of the robot.
     float leftSpeed  = throttle + steer;
     float rightSpeed = throttle - steer;
 
+    // Coast while driving with the joysticks (only sent when the mode changes)
+    m_chassis->SetCoastMode();
+
     // Set the motors
     m_chassis->SetMotorSpeeds( leftSpeed, rightSpeed );
 }
@@ -24,6 +24,7 @@
 //  Team 302 includes
 #include <IJoystickDrive.h>     // Interface being implemented
 #include <IChassis.h>           // Class that controls the motors on the drive chassis
+#include <InputSnapshot.h>      // Inputs sampled this cycle
 
 class ArcadeDrive: public IJoystickDrive
 {
@@ -41,7 +42,10 @@ class ArcadeDrive: public IJoystickDrive
         //              to drive in arcade drive mode.
         // Returns:     void
         //--------------------------------------------------------------------
-        void DriveWithJoysticks() const override;
+        void DriveWithJoysticks
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const override;
 
         //--------------------------------------------------------------------
         // Method:      GetIdentifier
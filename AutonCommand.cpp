@@ -0,0 +1,102 @@
+/*=============================================================================================
+ * AutonCommand.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a command that runs an autonomous routine.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonCommand.h>           // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonCommand <<constructor>>
+// Description: This will create the command without a routine
+//----------------------------------------------------------------------------------
+AutonCommand::AutonCommand() : ICommand(),
+                               m_routine( nullptr )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetRoutine
+// Description: Picks the routine to run.  Only call this while the command isn't
+//              scheduled.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonCommand::SetRoutine
+(
+    IAutonAction*               routine     // <I> - routine to run (still owned by the caller)
+)
+{
+    m_routine = routine;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRequirements
+// Description: This gets the subsystems the command drives
+// Returns:     unsigned int    the chassis and the shooter
+//----------------------------------------------------------------------------------
+unsigned int AutonCommand::GetRequirements() const
+{
+    return SUBSYSTEM_CHASSIS | SUBSYSTEM_SHOOTER;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts the routine
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonCommand::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( m_routine != nullptr )
+    {
+        m_routine->Start( inputs );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Runs the routine for this cycle
+// Returns:     bool    true  = the routine is done
+//                      false = call Run() again next cycle
+//----------------------------------------------------------------------------------
+bool AutonCommand::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    ScopedLoopTimer timer( PROFILE_AUTON );
+    return ( m_routine == nullptr ) || m_routine->Run( inputs );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Ends the routine
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonCommand::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    if ( m_routine != nullptr )
+    {
+        m_routine->End( interrupted );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the routine
+// Returns:     const char*     name of the routine
+//----------------------------------------------------------------------------------
+const char* AutonCommand::GetName() const
+{
+    return ( m_routine != nullptr ) ? m_routine->GetName() : "auton";
+}
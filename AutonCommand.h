@@ -0,0 +1,106 @@
+/*=============================================================================================
+ * AutonCommand.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a command that runs an autonomous routine (an IAutonAction), so the ControlLoop can
+ * run the routine in its drive task with the chassis sampled at the drive rate.  The routine
+ * drives the chassis and the shooter, so the command requires both and nothing else runs
+ * while it does.  It ends when the routine says it is done, or when it is cut off (the routine
+ * is then ended as interrupted).
+ *
+ * The command is created once, when the robot starts; SetRoutine() picks the routine before
+ * the command is scheduled.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONCOMMAND_H_
+#define SRC_AUTONCOMMAND_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Routine being run
+#include <ICommand.h>               // Interface being implemented
+#include <LoopProfiler.h>           // Times each run
+
+class AutonCommand : public ICommand
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonCommand <<constructor>>
+        // Description: This will create the command without a routine
+        //----------------------------------------------------------------------------------
+        AutonCommand();
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetRoutine
+        // Description: Picks the routine to run.  Only call this while the command isn't
+        //              scheduled.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetRoutine
+        (
+            IAutonAction*               routine     // <I> - routine to run (still owned by the caller)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetRequirements
+        // Description: This gets the subsystems the command drives
+        // Returns:     unsigned int    the chassis and the shooter
+        //----------------------------------------------------------------------------------
+        unsigned int GetRequirements() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts the routine
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Runs the routine for this cycle
+        // Returns:     bool    true  = the routine is done
+        //                      false = call Run() again next cycle
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Ends the routine
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the routine
+        // Returns:     const char*     name of the routine
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonCommand <<destructor>>
+        // Description: This will clean up the object (the routine isn't deleted)
+        //----------------------------------------------------------------------------------
+        virtual ~AutonCommand() = default;
+
+    private:
+        // Attributes
+        IAutonAction*           m_routine;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonCommand( const AutonCommand& ) = delete;
+        AutonCommand& operator= ( const AutonCommand& ) = delete;
+        explicit AutonCommand( AutonCommand* other ) = delete;
+};
+
+#endif /* SRC_AUTONCOMMAND_H_ */
@@ -0,0 +1,99 @@
+/*=============================================================================================
+ * AutonDriveTrajectory.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action drives one of the trajectories made ahead of time on the drive motor
+ * controllers.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+
+// Team 302 includes
+#include <AutonDriveTrajectory.h>   // This class
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonDriveTrajectory <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonDriveTrajectory::AutonDriveTrajectory
+(
+    const char*             trajectoryName, // <I> - name in the trajectory file
+    MotionProfileExecutor*  executor        // <I> - runs the points (shared by the drive actions)
+) : IAutonAction(),
+    m_name( trajectoryName ),
+    m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+    m_executor( executor ),
+    m_started( false )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Looks up the trajectory and starts streaming it to the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonDriveTrajectory::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    Trajectory trajectory;
+    m_started = TrajectoryFile::GetInstance()->Find( m_name, trajectory ) &&
+                m_executor->Start( trajectory );
+    if ( !m_started )
+    {
+        printf( "Auton: can't drive trajectory %s\n", m_name );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Streams the points to the drive motors and checks whether they
+//              have reached the last point
+// Returns:     bool    true  = trajectory finished (or couldn't be driven)
+//----------------------------------------------------------------------------------
+bool AutonDriveTrajectory::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( !m_started )
+    {
+        return true;
+    }
+    m_executor->Stream( inputs.timestamp );
+    return m_executor->IsDone();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops streaming and stops the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonDriveTrajectory::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    if ( m_started )
+    {
+        m_executor->Stop();
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );      // back to normal driving
+        m_started = false;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the trajectory
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonDriveTrajectory::GetName() const
+{
+    return m_name;
+}
@@ -0,0 +1,92 @@
+/*=============================================================================================
+ * AutonDriveTrajectory.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action drives one of the trajectories made ahead of time (see TrajectoryFile)
+ * with the MotionProfileExecutor, from wherever the robot is when it starts.  Starting it only
+ * looks the trajectory up in the mapped file and copies its points.  If the trajectory isn't in
+ * the file (or there is no file) the action is done right away without moving.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONDRIVETRAJECTORY_H_
+#define SRC_AUTONDRIVETRAJECTORY_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <IChassis.h>
+#include <MotionProfileExecutor.h>  // Runs the trajectory on the drive motor controllers
+#include <TrajectoryFile.h>         // Trajectories made ahead of time
+
+class AutonDriveTrajectory : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonDriveTrajectory <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonDriveTrajectory
+        (
+            const char*             trajectoryName, // <I> - name in the trajectory file
+            MotionProfileExecutor*  executor        // <I> - runs the points (shared by the drive actions)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Looks up the trajectory and starts streaming it to the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Streams the points to the drive motors and checks whether they
+        //              have reached the last point
+        // Returns:     bool    true  = trajectory finished (or couldn't be driven)
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops streaming and stops the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the trajectory
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonDriveTrajectory <<destructor>>
+        // Description: This will clean up the object (the executor isn't deleted)
+        //----------------------------------------------------------------------------------
+        virtual ~AutonDriveTrajectory() = default;
+
+    private:
+        // Attributes
+        const char*             m_name;
+        IChassis*               m_chassis;
+        MotionProfileExecutor*  m_executor;
+        bool                    m_started;      // true = the executor is running the trajectory
+
+        // Default methods we don't want the compiler to implement for us
+        AutonDriveTrajectory() = delete;
+        AutonDriveTrajectory( const AutonDriveTrajectory& ) = delete;
+        AutonDriveTrajectory& operator= ( const AutonDriveTrajectory& ) = delete;
+};
+
+#endif /* SRC_AUTONDRIVETRAJECTORY_H_ */
@@ -0,0 +1,77 @@
+/*=============================================================================================
+ * AutonFollowLine.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action follows the line until the goal detection bumper trips.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonFollowLine.h>        // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonFollowLine <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonFollowLine::AutonFollowLine
+(
+    FollowLine*     followLine      // <I> - line follower (shared with teleop)
+) : IAutonAction(),
+    m_followLine( followLine )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Nothing to get ready; the line follower picks up where it is
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonFollowLine::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Follows the line for this cycle
+// Returns:     bool    true  = the bumper tripped
+//----------------------------------------------------------------------------------
+bool AutonFollowLine::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( inputs.bumperPressed )
+    {
+        return true;
+    }
+    m_followLine->Drive( inputs );
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonFollowLine::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    m_followLine->Stop();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the action
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonFollowLine::GetName() const
+{
+    return "follow line";
+}
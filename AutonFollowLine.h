@@ -0,0 +1,83 @@
+/*=============================================================================================
+ * AutonFollowLine.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action follows the line with FollowLine until the goal detection bumper
+ * trips.  Give it a timeout in case the robot never reaches the goal.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONFOLLOWLINE_H_
+#define SRC_AUTONFOLLOWLINE_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <FollowLine.h>             // Follows the line
+
+class AutonFollowLine : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonFollowLine <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonFollowLine
+        (
+            FollowLine*     followLine      // <I> - line follower (shared with teleop)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Nothing to get ready; the line follower picks up where it is
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Follows the line for this cycle
+        // Returns:     bool    true  = the bumper tripped
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonFollowLine <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~AutonFollowLine() = default;
+
+    private:
+        // Attributes
+        FollowLine*         m_followLine;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonFollowLine() = delete;
+        AutonFollowLine( const AutonFollowLine& ) = delete;
+        AutonFollowLine& operator= ( const AutonFollowLine& ) = delete;
+};
+
+#endif /* SRC_AUTONFOLLOWLINE_H_ */
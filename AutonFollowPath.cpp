@@ -0,0 +1,93 @@
+/*=============================================================================================
+ * AutonFollowPath.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action drives a path of waypoints with the PathFollower.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+
+// Team 302 includes
+#include <AutonFollowPath.h>        // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonFollowPath <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonFollowPath::AutonFollowPath
+(
+    const char*             name,       // <I> - name of the path (string literal)
+    const PathWaypoint*     waypoints,  // <I> - path (must stay valid; e.g. a static table)
+    int                     count,      // <I> - number of waypoints
+    bool                    reversed,   // <I> - true = drive the path backwards
+    PathFollower*           follower    // <I> - drives the path (shared by the path actions)
+) : IAutonAction(),
+    m_name( name ),
+    m_waypoints( waypoints ),
+    m_count( count ),
+    m_reversed( reversed ),
+    m_follower( follower ),
+    m_odometry( Odometry::GetInstance() )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Hands the path to the follower
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonFollowPath::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( !m_follower->SetPath( m_waypoints, m_count, m_reversed ) )
+    {
+        printf( "Auton: can't follow path %s\n", m_name );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Steers along the path from the latest pose
+// Returns:     bool    true  = end of the path reached (or the path was bad)
+//----------------------------------------------------------------------------------
+bool AutonFollowPath::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    RobotPose pose;
+    if ( !m_odometry->GetPose( pose ) )
+    {
+        return m_follower->IsDone();        // no pose yet; wait for one
+    }
+    return m_follower->Drive( pose );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops the follower and the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonFollowPath::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    m_follower->Stop();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the path
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonFollowPath::GetName() const
+{
+    return m_name;
+}
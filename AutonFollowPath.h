@@ -0,0 +1,97 @@
+/*=============================================================================================
+ * AutonFollowPath.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action drives a path of waypoints with the PathFollower, steering on the
+ * Odometry pose.  The waypoints are in the Odometry field frame, which is reset to the robot's
+ * starting position at the start of autonomous.  The action is done when the follower reaches
+ * the end of the path.
+ *
+ * The Odometry must be updated each cycle before the action is run.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONFOLLOWPATH_H_
+#define SRC_AUTONFOLLOWPATH_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <Odometry.h>               // Tracks the robot pose from the drive encoders
+#include <PathFollower.h>           // Drives the path with pure pursuit
+
+class AutonFollowPath : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonFollowPath <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonFollowPath
+        (
+            const char*             name,       // <I> - name of the path (string literal)
+            const PathWaypoint*     waypoints,  // <I> - path (must stay valid; e.g. a static table)
+            int                     count,      // <I> - number of waypoints
+            bool                    reversed,   // <I> - true = drive the path backwards
+            PathFollower*           follower    // <I> - drives the path (shared by the path actions)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Hands the path to the follower
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Steers along the path from the latest pose
+        // Returns:     bool    true  = end of the path reached (or the path was bad)
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops the follower and the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the path
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonFollowPath <<destructor>>
+        // Description: This will clean up the object (the follower isn't deleted)
+        //----------------------------------------------------------------------------------
+        virtual ~AutonFollowPath() = default;
+
+    private:
+        // Attributes
+        const char*             m_name;
+        const PathWaypoint*     m_waypoints;
+        int                     m_count;
+        bool                    m_reversed;
+        PathFollower*           m_follower;
+        Odometry*               m_odometry;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonFollowPath() = delete;
+        AutonFollowPath( const AutonFollowPath& ) = delete;
+        AutonFollowPath& operator= ( const AutonFollowPath& ) = delete;
+};
+
+#endif /* SRC_AUTONFOLLOWPATH_H_ */
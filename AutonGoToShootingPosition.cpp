@@ -0,0 +1,73 @@
+/*=============================================================================================
+ * AutonGoToShootingPosition.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action drives to the goal and backs up to the shooting position.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonGoToShootingPosition.h>  // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonGoToShootingPosition <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonGoToShootingPosition::AutonGoToShootingPosition
+(
+    GoToShootingPosition*   position    // <I> - drives to the shooting position
+) : IAutonAction(),
+    m_position( position )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Gets ready to drive at the goal
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonGoToShootingPosition::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_position->ChangeState( READY_TO_START );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Drives toward the goal or backs up from it
+// Returns:     bool    true  = at the shooting position
+//----------------------------------------------------------------------------------
+bool AutonGoToShootingPosition::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    return m_position->Drive( inputs );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops the drive motors (and the back up move)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonGoToShootingPosition::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    m_position->ChangeState( READY_TO_START );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the action
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonGoToShootingPosition::GetName() const
+{
+    return "go to shooting position";
+}
@@ -0,0 +1,83 @@
+/*=============================================================================================
+ * AutonGoToShootingPosition.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action runs GoToShootingPosition: drive at the goal until the bumper trips,
+ * then back up to the shooting position.  It is done when the robot is in position.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONGOTOSHOOTINGPOSITION_H_
+#define SRC_AUTONGOTOSHOOTINGPOSITION_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <GoToShootingPosition.h>   // Drives to the goal and backs up
+
+class AutonGoToShootingPosition : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonGoToShootingPosition <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonGoToShootingPosition
+        (
+            GoToShootingPosition*   position    // <I> - drives to the shooting position
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Gets ready to drive at the goal
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Drives toward the goal or backs up from it
+        // Returns:     bool    true  = at the shooting position
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops the drive motors (and the back up move)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonGoToShootingPosition <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~AutonGoToShootingPosition() = default;
+
+    private:
+        // Attributes
+        GoToShootingPosition*   m_position;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonGoToShootingPosition() = delete;
+        AutonGoToShootingPosition( const AutonGoToShootingPosition& ) = delete;
+        AutonGoToShootingPosition& operator= ( const AutonGoToShootingPosition& ) = delete;
+};
+
+#endif /* SRC_AUTONGOTOSHOOTINGPOSITION_H_ */
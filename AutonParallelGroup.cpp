@@ -0,0 +1,170 @@
+/*=============================================================================================
+ * AutonParallelGroup.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs autonomous actions at the same time until the group's completion is met.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+
+// Team 302 includes
+#include <AutonParallelGroup.h>     // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonParallelGroup <<constructor>>
+// Description: This will create an empty group
+//----------------------------------------------------------------------------------
+AutonParallelGroup::AutonParallelGroup
+(
+    const char*         name,           // <I> - name of the group (string literal)
+    PARALLEL_COMPLETION completion      // <I> - when the group is done
+) : IAutonAction(),
+    m_name( name ),
+    m_completion( completion ),
+    m_actions(),
+    m_timeouts(),
+    m_count( 0 ),
+    m_running(),
+    m_start( 0.0 )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddAction
+// Description: Adds an action to the group.  Only call this while the routines
+//              are built.
+// Returns:     bool    true  = added
+//                      false = the group is full (MAX_ACTIONS)
+//----------------------------------------------------------------------------------
+bool AutonParallelGroup::AddAction
+(
+    IAutonAction*   action,         // <I> - action to run
+    double          timeout         // <I> - seconds before it is cut off (0.0 = never)
+)
+{
+    if ( action == nullptr || m_count >= MAX_ACTIONS )
+    {
+        return false;
+    }
+    m_actions[m_count]  = action;
+    m_timeouts[m_count] = timeout;
+    m_running[m_count]  = false;
+    ++m_count;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts every action
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonParallelGroup::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_start = inputs.timestamp;
+    for ( int inx=0; inx<m_count; ++inx )
+    {
+        m_running[inx] = true;
+        m_actions[inx]->Start( inputs );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Runs the actions that are still going and ends the ones that are
+//              done or time out
+// Returns:     bool    true  = the group's completion was met
+//----------------------------------------------------------------------------------
+bool AutonParallelGroup::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    bool anyDone   = false;
+    bool allDone   = true;
+    bool firstDone = ( m_count == 0 );
+    for ( int inx=0; inx<m_count; ++inx )
+    {
+        if ( m_running[inx] )
+        {
+            IAutonAction* action = m_actions[inx];
+            bool done     = action->Run( inputs );
+            bool timedOut = !done && m_timeouts[inx] > 0.0 &&
+                            ( inputs.timestamp - m_start ) >= m_timeouts[inx];
+            if ( done || timedOut )
+            {
+                if ( timedOut )
+                {
+                    printf( "Auton: %s timed out\n", action->GetName() );
+                }
+                action->End( timedOut );
+                m_running[inx] = false;
+            }
+        }
+
+        if ( m_running[inx] )
+        {
+            allDone = false;
+        }
+        else
+        {
+            anyDone = true;
+            if ( inx == 0 )
+            {
+                firstDone = true;
+            }
+        }
+    }
+
+    bool groupDone = allDone;
+    if ( m_completion == WAIT_FOR_ANY )
+    {
+        groupDone = anyDone || m_count == 0;
+    }
+    else if ( m_completion == WAIT_FOR_FIRST )
+    {
+        groupDone = firstDone;
+    }
+
+    if ( groupDone )
+    {
+        End( false );
+    }
+    return groupDone;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Cuts off the actions that are still running
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonParallelGroup::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    for ( int inx=0; inx<m_count; ++inx )
+    {
+        if ( m_running[inx] )
+        {
+            m_actions[inx]->End( true );
+            m_running[inx] = false;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the group
+// Returns:     const char*     name of the group
+//----------------------------------------------------------------------------------
+const char* AutonParallelGroup::GetName() const
+{
+    return m_name;
+}
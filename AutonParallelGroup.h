@@ -0,0 +1,123 @@
+/*=============================================================================================
+ * AutonParallelGroup.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs autonomous actions at the same time (e.g. spinning up the shooter wheel while the
+ * robot drives to the goal).  Every action is started together and run each cycle until it is
+ * done or reaches its own timeout.  When the group is done depends on its completion:
+ *
+ *      WAIT_FOR_ALL        every action is done
+ *      WAIT_FOR_ANY        any one action is done
+ *      WAIT_FOR_FIRST      the first action added is done (the others run alongside it)
+ *
+ * and any actions still running then are cut off.  The actions must not use the same motors.
+ * They are added when the routines are built and belong to whoever created them.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONPARALLELGROUP_H_
+#define SRC_AUTONPARALLELGROUP_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+
+enum PARALLEL_COMPLETION
+{
+    WAIT_FOR_ALL,
+    WAIT_FOR_ANY,
+    WAIT_FOR_FIRST
+};
+
+class AutonParallelGroup : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonParallelGroup <<constructor>>
+        // Description: This will create an empty group
+        //----------------------------------------------------------------------------------
+        AutonParallelGroup
+        (
+            const char*         name,           // <I> - name of the group (string literal)
+            PARALLEL_COMPLETION completion      // <I> - when the group is done
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      AddAction
+        // Description: Adds an action to the group.  Only call this while the routines
+        //              are built.
+        // Returns:     bool    true  = added
+        //                      false = the group is full (MAX_ACTIONS)
+        //----------------------------------------------------------------------------------
+        bool AddAction
+        (
+            IAutonAction*   action,         // <I> - action to run
+            double          timeout         // <I> - seconds before it is cut off (0.0 = never)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts every action
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Runs the actions that are still going and ends the ones that are
+        //              done or time out
+        // Returns:     bool    true  = the group's completion was met
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Cuts off the actions that are still running
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the group
+        // Returns:     const char*     name of the group
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonParallelGroup <<destructor>>
+        // Description: This will clean up the object (the actions aren't deleted)
+        //----------------------------------------------------------------------------------
+        virtual ~AutonParallelGroup() = default;
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static const int    MAX_ACTIONS = 8;
+
+        const char*         m_name;
+        PARALLEL_COMPLETION m_completion;
+        IAutonAction*       m_actions[MAX_ACTIONS];
+        double              m_timeouts[MAX_ACTIONS];    // seconds (0.0 = never)
+        int                 m_count;
+
+        bool                m_running[MAX_ACTIONS];     // true = started and not ended yet
+        double              m_start;                    // inputs timestamp the group started
+
+        // Default methods we don't want the compiler to implement for us
+        AutonParallelGroup() = delete;
+        AutonParallelGroup( const AutonParallelGroup& ) = delete;
+        AutonParallelGroup& operator= ( const AutonParallelGroup& ) = delete;
+};
+
+#endif /* SRC_AUTONPARALLELGROUP_H_ */
@@ -0,0 +1,220 @@
+/*=============================================================================================
+ * AutonRoutines.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This builds the autonomous routines that can be picked from the dashboard.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonRoutines.h>              // This class
+#include <AutonDriveTrajectory.h>       // Drives a trajectory from the trajectory file
+#include <AutonFollowLine.h>            // Follows the line to the goal
+#include <AutonFollowPath.h>            // Drives a waypoint path
+#include <AutonGoToShootingPosition.h>  // Drives to the goal and backs up
+#include <AutonParallelGroup.h>         // Runs actions at the same time
+#include <AutonSerialGroup.h>           // Runs actions one after another
+#include <AutonShoot.h>                 // Shoots one ball
+#include <AutonSpinUpShooter.h>         // Starts the shooter wheel
+#include <IChassisFactory.h>            // Creates the chassis for this robot
+
+// Shooter wheel velocity for the autonomous shots (same as teleop)
+static const float  AUTON_SHOOTER_VELOCITY = 3750.0;    // RPM
+
+// Timeouts (seconds) so a routine can't hang if a sensor never trips
+static const double DRIVE_TIMEOUT        = 6.0;
+static const double FOLLOW_LINE_TIMEOUT  = 5.0;
+static const double BACK_UP_TIMEOUT      = 3.0;
+static const double SHOOT_TIMEOUT        = 3.0;
+static const double SPIN_UP_TIMEOUT      = 3.0;
+
+// Path from the start line to the shot, in feet from where autonomous starts
+static const PathWaypoint PATH_TO_SHOT[] =
+{
+    {  0.0, 0.0 },
+    {  8.0, 0.0 },
+    { 13.0, 3.0 }
+};
+static const int PATH_TO_SHOT_COUNT = sizeof( PATH_TO_SHOT ) / sizeof( PATH_TO_SHOT[0] );
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonRoutines <<constructor>>
+// Description: This will build all of the routines.  The first routine is the
+//              default (it does nothing).
+//----------------------------------------------------------------------------------
+AutonRoutines::AutonRoutines
+(
+    FollowLine*     followLine      // <I> - line follower (shared with teleop)
+) : m_executor( new MotionProfileExecutor() ),
+    m_pathFollower( new PathFollower( IChassisFactory::GetInstance()->GetIChassis() ) ),
+    m_shootingPosition( new GoToShootingPosition() ),
+    m_routines(),
+    m_routineCount( 0 ),
+    m_owned(),
+    m_ownedCount( 0 )
+{
+    // Do nothing
+    AutonSerialGroup* doNothing = new AutonSerialGroup( "Do nothing" );
+    Own( doNothing );
+    AddRoutine( doNothing );
+
+    // Cross the defense in front of the robot
+    AutonSerialGroup* crossDefense = new AutonSerialGroup( "Cross defense" );
+    Own( crossDefense );
+    AutonDriveTrajectory* cross = new AutonDriveTrajectory( "CrossDefense", m_executor );
+    Own( cross );
+    crossDefense->AddAction( cross, DRIVE_TIMEOUT );
+    AddRoutine( crossDefense );
+
+    // Cross the defense and turn to the goal while the shooter spins up, then shoot
+    AutonSerialGroup* crossAndShoot = new AutonSerialGroup( "Cross and shoot" );
+    Own( crossAndShoot );
+    AutonParallelGroup* crossAndSpinUp = new AutonParallelGroup( "cross and spin up", WAIT_FOR_ALL );
+    Own( crossAndSpinUp );
+    AutonDriveTrajectory* crossAndAim = new AutonDriveTrajectory( "CrossAndAim", m_executor );
+    Own( crossAndAim );
+    AutonSpinUpShooter* spinUp = new AutonSpinUpShooter( AUTON_SHOOTER_VELOCITY );
+    Own( spinUp );
+    AutonShoot* shoot = new AutonShoot( AUTON_SHOOTER_VELOCITY );
+    Own( shoot );
+    crossAndSpinUp->AddAction( crossAndAim, DRIVE_TIMEOUT );
+    crossAndSpinUp->AddAction( spinUp, SPIN_UP_TIMEOUT );
+    crossAndShoot->AddAction( crossAndSpinUp, 0.0 );
+    crossAndShoot->AddAction( shoot, SHOOT_TIMEOUT );
+    AddRoutine( crossAndShoot );
+
+    // Follow the line to the goal and back up to the shot while the shooter spins up
+    AutonSerialGroup* lineAndShoot = new AutonSerialGroup( "Line to goal and shoot" );
+    Own( lineAndShoot );
+    AutonParallelGroup* lineAndSpinUp = new AutonParallelGroup( "line and spin up", WAIT_FOR_ALL );
+    Own( lineAndSpinUp );
+    AutonSerialGroup* lineThenBackUp = new AutonSerialGroup( "line then back up" );
+    Own( lineThenBackUp );
+    AutonFollowLine* line = new AutonFollowLine( followLine );
+    Own( line );
+    AutonDriveTrajectory* backUp = new AutonDriveTrajectory( "BackUpToShot", m_executor );
+    Own( backUp );
+    lineThenBackUp->AddAction( line, FOLLOW_LINE_TIMEOUT );
+    lineThenBackUp->AddAction( backUp, BACK_UP_TIMEOUT );
+    lineAndSpinUp->AddAction( lineThenBackUp, 0.0 );
+    lineAndSpinUp->AddAction( spinUp, SPIN_UP_TIMEOUT );
+    lineAndShoot->AddAction( lineAndSpinUp, 0.0 );
+    lineAndShoot->AddAction( shoot, SHOOT_TIMEOUT );
+    AddRoutine( lineAndShoot );
+
+    // Drive straight to the goal, back up to the shot and shoot
+    AutonSerialGroup* positionAndShoot = new AutonSerialGroup( "Bump goal and shoot" );
+    Own( positionAndShoot );
+    AutonParallelGroup* positionAndSpinUp = new AutonParallelGroup( "position and spin up", WAIT_FOR_ALL );
+    Own( positionAndSpinUp );
+    AutonGoToShootingPosition* position = new AutonGoToShootingPosition( m_shootingPosition );
+    Own( position );
+    positionAndSpinUp->AddAction( position, DRIVE_TIMEOUT );
+    positionAndSpinUp->AddAction( spinUp, SPIN_UP_TIMEOUT );
+    positionAndShoot->AddAction( positionAndSpinUp, 0.0 );
+    positionAndShoot->AddAction( shoot, SHOOT_TIMEOUT );
+    AddRoutine( positionAndShoot );
+
+    // Drive the waypoint path to the shot while the shooter spins up, then shoot
+    AutonSerialGroup* pathAndShoot = new AutonSerialGroup( "Path to shot and shoot" );
+    Own( pathAndShoot );
+    AutonParallelGroup* pathAndSpinUp = new AutonParallelGroup( "path and spin up", WAIT_FOR_ALL );
+    Own( pathAndSpinUp );
+    AutonFollowPath* path = new AutonFollowPath( "path to shot", PATH_TO_SHOT, PATH_TO_SHOT_COUNT,
+                                                 false, m_pathFollower );
+    Own( path );
+    pathAndSpinUp->AddAction( path, DRIVE_TIMEOUT );
+    pathAndSpinUp->AddAction( spinUp, SPIN_UP_TIMEOUT );
+    pathAndShoot->AddAction( pathAndSpinUp, 0.0 );
+    pathAndShoot->AddAction( shoot, SHOOT_TIMEOUT );
+    AddRoutine( pathAndShoot );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetCount
+// Description: This gets the number of routines
+// Returns:     int     number of routines
+//----------------------------------------------------------------------------------
+int AutonRoutines::GetCount() const
+{
+    return m_routineCount;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of a routine to show on the dashboard
+// Returns:     const char*     name of the routine
+//----------------------------------------------------------------------------------
+const char* AutonRoutines::GetName
+(
+    int             index           // <I> - routine (0 to GetCount() - 1)
+) const
+{
+    return GetRoutine( index )->GetName();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRoutine
+// Description: This gets a routine
+// Returns:     IAutonAction*   routine (the first one if the index is bad)
+//----------------------------------------------------------------------------------
+IAutonAction* AutonRoutines::GetRoutine
+(
+    int             index           // <I> - routine (0 to GetCount() - 1)
+) const
+{
+    if ( index < 0 || index >= m_routineCount )
+    {
+        index = 0;
+    }
+    return m_routines[index];
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~AutonRoutines <<destructor>>
+// Description: This will delete the routines and their actions
+//----------------------------------------------------------------------------------
+AutonRoutines::~AutonRoutines()
+{
+    for ( int inx = 0; inx < m_ownedCount; inx++ )
+    {
+        delete m_owned[inx];
+    }
+    delete m_shootingPosition;
+    delete m_pathFollower;
+    delete m_executor;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Own
+// Description: Remembers an action so the destructor deletes it
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonRoutines::Own
+(
+    IAutonAction*   action          // <I> - action created by the constructor
+)
+{
+    if ( m_ownedCount < MAX_OWNED )
+    {
+        m_owned[m_ownedCount++] = action;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddRoutine
+// Description: Adds a routine to the list shown on the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonRoutines::AddRoutine
+(
+    IAutonAction*   routine         // <I> - routine (already owned)
+)
+{
+    if ( m_routineCount < MAX_ROUTINES )
+    {
+        m_routines[m_routineCount++] = routine;
+    }
+}
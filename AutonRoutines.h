@@ -0,0 +1,112 @@
+/*=============================================================================================
+ * AutonRoutines.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This builds the autonomous routines that can be picked from the dashboard.  Every routine
+ * and every action in it is created once, when the robot starts, so running a routine
+ * doesn't allocate anything.  A routine can be run again after it ends (Start() resets it).
+ *
+ * The routines share one MotionProfileExecutor and one PathFollower; only one drive action
+ * runs at a time in any routine, and the action using the executor streams its points from
+ * its Run().  The spin up and shoot actions are shared by the routines
+ * too, since only one routine runs at a time.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONROUTINES_H_
+#define SRC_AUTONROUTINES_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Routines and their actions
+#include <FollowLine.h>             // Follows the line
+#include <GoToShootingPosition.h>   // Drives to the goal and backs up
+#include <MotionProfileExecutor.h>  // Streams trajectories to the drive motor controllers
+#include <PathFollower.h>           // Drives waypoint paths with pure pursuit
+
+class AutonRoutines
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonRoutines <<constructor>>
+        // Description: This will build all of the routines.  The first routine is the
+        //              default (it does nothing).
+        //----------------------------------------------------------------------------------
+        AutonRoutines
+        (
+            FollowLine*     followLine      // <I> - line follower (shared with teleop)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetCount
+        // Description: This gets the number of routines
+        // Returns:     int     number of routines
+        //----------------------------------------------------------------------------------
+        int GetCount() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of a routine to show on the dashboard
+        // Returns:     const char*     name of the routine
+        //----------------------------------------------------------------------------------
+        const char* GetName
+        (
+            int             index           // <I> - routine (0 to GetCount() - 1)
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetRoutine
+        // Description: This gets a routine
+        // Returns:     IAutonAction*   routine (the first one if the index is bad)
+        //----------------------------------------------------------------------------------
+        IAutonAction* GetRoutine
+        (
+            int             index           // <I> - routine (0 to GetCount() - 1)
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonRoutines <<destructor>>
+        // Description: This will delete the routines and their actions
+        //----------------------------------------------------------------------------------
+        virtual ~AutonRoutines();
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      Own
+        // Description: Remembers an action so the destructor deletes it
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Own
+        (
+            IAutonAction*   action          // <I> - action created by the constructor
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      AddRoutine
+        // Description: Adds a routine to the list shown on the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void AddRoutine
+        (
+            IAutonAction*   routine         // <I> - routine (already owned)
+        );
+
+        static const int        MAX_ROUTINES = 8;
+        static const int        MAX_OWNED    = 48;
+
+        // Attributes
+        MotionProfileExecutor*  m_executor;
+        PathFollower*           m_pathFollower;
+        GoToShootingPosition*   m_shootingPosition;
+        IAutonAction*           m_routines[MAX_ROUTINES];
+        int                     m_routineCount;
+        IAutonAction*           m_owned[MAX_OWNED];
+        int                     m_ownedCount;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonRoutines() = delete;
+        AutonRoutines( const AutonRoutines& ) = delete;
+        AutonRoutines& operator= ( const AutonRoutines& ) = delete;
+};
+
+#endif /* SRC_AUTONROUTINES_H_ */
@@ -0,0 +1,148 @@
+/*=============================================================================================
+ * AutonSerialGroup.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs autonomous actions one after the other, cutting off any that run past their
+ * timeout.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+
+// Team 302 includes
+#include <AutonSerialGroup.h>       // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonSerialGroup <<constructor>>
+// Description: This will create an empty group
+//----------------------------------------------------------------------------------
+AutonSerialGroup::AutonSerialGroup
+(
+    const char*     name            // <I> - name of the group (string literal)
+) : IAutonAction(),
+    m_name( name ),
+    m_actions(),
+    m_timeouts(),
+    m_count( 0 ),
+    m_current( 0 ),
+    m_currentStart( 0.0 )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddAction
+// Description: Adds an action to the end of the group.  Only call this while the
+//              routines are built.
+// Returns:     bool    true  = added
+//                      false = the group is full (MAX_ACTIONS)
+//----------------------------------------------------------------------------------
+bool AutonSerialGroup::AddAction
+(
+    IAutonAction*   action,         // <I> - action to run
+    double          timeout         // <I> - seconds before it is cut off (0.0 = never)
+)
+{
+    if ( action == nullptr || m_count >= MAX_ACTIONS )
+    {
+        return false;
+    }
+    m_actions[m_count]  = action;
+    m_timeouts[m_count] = timeout;
+    ++m_count;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts the first action
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonSerialGroup::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_current = 0;
+    StartCurrent( inputs );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Runs the current action and moves on to the next one when it is
+//              done or times out
+// Returns:     bool    true  = every action is done
+//----------------------------------------------------------------------------------
+bool AutonSerialGroup::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( m_current >= m_count )
+    {
+        return true;
+    }
+
+    IAutonAction* action = m_actions[m_current];
+    bool done     = action->Run( inputs );
+    bool timedOut = !done && m_timeouts[m_current] > 0.0 &&
+                    ( inputs.timestamp - m_currentStart ) >= m_timeouts[m_current];
+    if ( done || timedOut )
+    {
+        if ( timedOut )
+        {
+            printf( "Auton: %s timed out\n", action->GetName() );
+        }
+        action->End( timedOut );
+
+        ++m_current;
+        StartCurrent( inputs );
+    }
+    return m_current >= m_count;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Cuts off the current action if the group didn't finish
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonSerialGroup::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    if ( m_current < m_count )
+    {
+        m_actions[m_current]->End( true );
+        m_current = m_count;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the group
+// Returns:     const char*     name of the group
+//----------------------------------------------------------------------------------
+const char* AutonSerialGroup::GetName() const
+{
+    return m_name;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      StartCurrent
+// Description: Starts the current action (if there is one left)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonSerialGroup::StartCurrent
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( m_current < m_count )
+    {
+        m_currentStart = inputs.timestamp;
+        m_actions[m_current]->Start( inputs );
+    }
+}
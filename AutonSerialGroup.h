@@ -0,0 +1,121 @@
+/*=============================================================================================
+ * AutonSerialGroup.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs autonomous actions one after the other.  Each action can have a timeout; an action
+ * that runs longer is cut off and the group moves on to the next one, so one stuck action (e.g.
+ * a sensor that never trips) can't use up the whole autonomous period.  When an action finishes
+ * the next one is started in the same cycle and first run in the next one.
+ *
+ * The group is done when its last action is done (an empty group is done right away).  The
+ * actions are added when the routines are built and belong to whoever created them.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONSERIALGROUP_H_
+#define SRC_AUTONSERIALGROUP_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+
+class AutonSerialGroup : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonSerialGroup <<constructor>>
+        // Description: This will create an empty group
+        //----------------------------------------------------------------------------------
+        AutonSerialGroup
+        (
+            const char*     name            // <I> - name of the group (string literal)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      AddAction
+        // Description: Adds an action to the end of the group.  Only call this while the
+        //              routines are built.
+        // Returns:     bool    true  = added
+        //                      false = the group is full (MAX_ACTIONS)
+        //----------------------------------------------------------------------------------
+        bool AddAction
+        (
+            IAutonAction*   action,         // <I> - action to run
+            double          timeout         // <I> - seconds before it is cut off (0.0 = never)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts the first action
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Runs the current action and moves on to the next one when it is
+        //              done or times out
+        // Returns:     bool    true  = every action is done
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Cuts off the current action if the group didn't finish
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the group
+        // Returns:     const char*     name of the group
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonSerialGroup <<destructor>>
+        // Description: This will clean up the object (the actions aren't deleted)
+        //----------------------------------------------------------------------------------
+        virtual ~AutonSerialGroup() = default;
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      StartCurrent
+        // Description: Starts the current action (if there is one left)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void StartCurrent
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static const int    MAX_ACTIONS = 8;
+
+        const char*         m_name;
+        IAutonAction*       m_actions[MAX_ACTIONS];
+        double              m_timeouts[MAX_ACTIONS];    // seconds (0.0 = never)
+        int                 m_count;
+
+        int                 m_current;          // action running (m_count = done)
+        double              m_currentStart;     // inputs timestamp the current action started
+
+        // Default methods we don't want the compiler to implement for us
+        AutonSerialGroup() = delete;
+        AutonSerialGroup( const AutonSerialGroup& ) = delete;
+        AutonSerialGroup& operator= ( const AutonSerialGroup& ) = delete;
+};
+
+#endif /* SRC_AUTONSERIALGROUP_H_ */
@@ -0,0 +1,103 @@
+/*=============================================================================================
+ * AutonShoot.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action shoots one ball by cycling the loader once the wheel is at speed.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonShoot.h>             // This class
+#include <IShooterFactory.h>        // Creates the shooter for this robot
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonShoot <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonShoot::AutonShoot
+(
+    float           wheelVelocity   // <I> - shooter wheel velocity (RPM)
+) : IAutonAction(),
+    m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+    m_wheelVelocity( wheelVelocity ),
+    m_speedMonitor(),
+    m_loaderStarted( false ),
+    m_loaderLeft( false )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts the shooter wheel
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonShoot::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_speedMonitor.Reset();
+    m_loaderStarted = false;
+    m_loaderLeft    = false;
+    m_shooter->SetShooterVelocity( m_wheelVelocity );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Runs the loader once the wheel is at speed, until the loader
+//              has cycled once
+// Returns:     bool    true  = ball shot
+//----------------------------------------------------------------------------------
+bool AutonShoot::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_shooter->SetShooterVelocity( m_wheelVelocity );
+    if ( !m_loaderStarted )
+    {
+        m_loaderStarted = m_speedMonitor.Update( m_wheelVelocity, inputs.shooterVelocity, inputs.shooterTimestamp );
+        if ( !m_loaderStarted )
+        {
+            return false;                   // hold the ball until the wheel is at speed
+        }
+    }
+
+    if ( !inputs.loaderInPosition )
+    {
+        m_loaderLeft = true;
+    }
+    else if ( m_loaderLeft )
+    {
+        return true;                        // back in the load position; the ball is gone
+    }
+
+    m_shooter->SetBallLoadMotor( m_loaderSpeedRun );
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops the loader and the shooter wheel
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonShoot::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    m_shooter->SetBallLoadMotor( m_speedStopped );
+    m_shooter->SetShooterSpeed( m_speedStopped );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the action
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonShoot::GetName() const
+{
+    return "shoot";
+}
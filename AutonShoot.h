@@ -0,0 +1,95 @@
+/*=============================================================================================
+ * AutonShoot.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action shoots one ball: it holds the shooter wheel velocity, waits for the
+ * wheel to be at speed (ShooterSpeedMonitor) and then cycles the loader until the loader has
+ * left its load position and come back to it.  Once the loader has started, the cycle is
+ * finished even if the shot slows the wheel down.  The wheel and the loader are stopped when
+ * the action ends.  Spin the wheel up (AutonSpinUpShooter) first so the shot isn't held up.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONSHOOT_H_
+#define SRC_AUTONSHOOT_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <IShooter.h>               // Controls the shooter motors
+#include <ShooterSpeedMonitor.h>    // Decides when the wheel is at speed
+
+class AutonShoot : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonShoot <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonShoot
+        (
+            float           wheelVelocity   // <I> - shooter wheel velocity (RPM)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts the shooter wheel
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Runs the loader once the wheel is at speed, until the loader
+        //              has cycled once
+        // Returns:     bool    true  = ball shot
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops the loader and the shooter wheel
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonShoot <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~AutonShoot() = default;
+
+    private:
+        // Attributes
+        IShooter*           m_shooter;
+        float               m_wheelVelocity;
+        ShooterSpeedMonitor m_speedMonitor;
+        bool                m_loaderStarted;    // wheel was at speed and the loader is running
+        bool                m_loaderLeft;       // loader has left its load position
+
+        const float         m_loaderSpeedRun = 1.0;
+        const float         m_speedStopped   = 0.0;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonShoot() = delete;
+        AutonShoot( const AutonShoot& ) = delete;
+        AutonShoot& operator= ( const AutonShoot& ) = delete;
+};
+
+#endif /* SRC_AUTONSHOOT_H_ */
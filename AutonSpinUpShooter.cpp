@@ -0,0 +1,81 @@
+/*=============================================================================================
+ * AutonSpinUpShooter.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action holds the shooter wheel at a velocity and waits for it to get there.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonSpinUpShooter.h>     // This class
+#include <IShooterFactory.h>        // Creates the shooter for this robot
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonSpinUpShooter <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonSpinUpShooter::AutonSpinUpShooter
+(
+    float           velocity        // <I> - shooter wheel velocity (RPM)
+) : IAutonAction(),
+    m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+    m_velocity( velocity ),
+    m_speedMonitor()
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts the shooter wheel
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonSpinUpShooter::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_speedMonitor.Reset();
+    m_shooter->SetShooterVelocity( m_velocity );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Waits for the wheel to get up to speed
+// Returns:     bool    true  = wheel is up to speed
+//----------------------------------------------------------------------------------
+bool AutonSpinUpShooter::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_shooter->SetShooterVelocity( m_velocity );
+    return m_speedMonitor.Update( m_velocity, inputs.shooterVelocity, inputs.shooterTimestamp );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Stops the wheel if the action was cut off; otherwise leaves it running
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonSpinUpShooter::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    if ( interrupted )
+    {
+        m_shooter->SetShooterSpeed( 0.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the action
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonSpinUpShooter::GetName() const
+{
+    return "spin up shooter";
+}
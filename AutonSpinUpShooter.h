@@ -0,0 +1,88 @@
+/*=============================================================================================
+ * AutonSpinUpShooter.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action holds the shooter wheel at a velocity and is done once the wheel is
+ * at speed (ShooterSpeedMonitor).  The wheel is left running when the action finishes so a
+ * later shot can use it; run it in a parallel group with a drive action to spin up while
+ * driving.  Give it a timeout in the group in case the wheel never gets there.
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONSPINUPSHOOTER_H_
+#define SRC_AUTONSPINUPSHOOTER_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+#include <IShooter.h>               // Controls the shooter motors
+#include <ShooterSpeedMonitor.h>    // Decides when the wheel is at speed
+
+class AutonSpinUpShooter : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonSpinUpShooter <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonSpinUpShooter
+        (
+            float           velocity        // <I> - shooter wheel velocity (RPM)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts the shooter wheel
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Waits for the wheel to get up to speed
+        // Returns:     bool    true  = wheel is up to speed
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Stops the wheel if the action was cut off; otherwise leaves it running
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonSpinUpShooter <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~AutonSpinUpShooter() = default;
+
+    private:
+        // Attributes
+        IShooter*           m_shooter;
+        float               m_velocity;
+        ShooterSpeedMonitor m_speedMonitor;
+
+        // Default methods we don't want the compiler to implement for us
+        AutonSpinUpShooter() = delete;
+        AutonSpinUpShooter( const AutonSpinUpShooter& ) = delete;
+        AutonSpinUpShooter& operator= ( const AutonSpinUpShooter& ) = delete;
+};
+
+#endif /* SRC_AUTONSPINUPSHOOTER_H_ */
@@ -0,0 +1,73 @@
+/*=============================================================================================
+ * AutonWait.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action does nothing for a set time.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <AutonWait.h>              // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      AutonWait <<constructor>>
+// Description: This will create the action
+//----------------------------------------------------------------------------------
+AutonWait::AutonWait
+(
+    double          seconds         // <I> - how long to wait
+) : IAutonAction(),
+    m_seconds( seconds ),
+    m_start( 0.0 )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Notes when the wait started
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonWait::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    m_start = inputs.timestamp;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Checks whether the time is up
+// Returns:     bool    true  = waited long enough
+//----------------------------------------------------------------------------------
+bool AutonWait::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    return ( inputs.timestamp - m_start ) >= m_seconds;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Nothing to clean up
+// Returns:     void
+//----------------------------------------------------------------------------------
+void AutonWait::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the action
+// Returns:     const char*     name of the action
+//----------------------------------------------------------------------------------
+const char* AutonWait::GetName() const
+{
+    return "wait";
+}
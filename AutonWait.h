@@ -0,0 +1,82 @@
+/*=============================================================================================
+ * AutonWait.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This autonomous action does nothing for a set time (e.g. to let a partner robot go first).
+ *=============================================================================================*/
+
+#ifndef SRC_AUTONWAIT_H_
+#define SRC_AUTONWAIT_H_
+
+// Team 302 includes
+#include <IAutonAction.h>           // Interface being implemented
+
+class AutonWait : public IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      AutonWait <<constructor>>
+        // Description: This will create the action
+        //----------------------------------------------------------------------------------
+        AutonWait
+        (
+            double          seconds         // <I> - how long to wait
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Notes when the wait started
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Checks whether the time is up
+        // Returns:     bool    true  = waited long enough
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Nothing to clean up
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~AutonWait <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~AutonWait() = default;
+
+    private:
+        // Attributes
+        double              m_seconds;
+        double              m_start;        // inputs timestamp the wait started
+
+        // Default methods we don't want the compiler to implement for us
+        AutonWait() = delete;
+        AutonWait( const AutonWait& ) = delete;
+        AutonWait& operator= ( const AutonWait& ) = delete;
+};
+
+#endif /* SRC_AUTONWAIT_H_ */
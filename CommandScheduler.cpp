@@ -0,0 +1,221 @@
+/*=============================================================================================
+ * CommandScheduler.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs the active commands, letting only one command use a subsystem at a time.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+
+// Team 302 includes
+#include <CommandScheduler.h>       // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      CommandScheduler <<constructor>>
+// Description: This will create a scheduler with no commands
+//----------------------------------------------------------------------------------
+CommandScheduler::CommandScheduler() : m_active(),
+                                       m_activeCount( 0 ),
+                                       m_defaults(),
+                                       m_defaultCount( 0 )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetDefaultCommand
+// Description: Sets the command that runs when no other command has its
+//              subsystems.  Only call this while the robot is starting up.
+// Returns:     bool    true  = default command set
+//                      false = too many default commands (MAX_COMMANDS)
+//----------------------------------------------------------------------------------
+bool CommandScheduler::SetDefaultCommand
+(
+    ICommand*                   command     // <I> - default command (still owned by the caller)
+)
+{
+    if ( m_defaultCount >= MAX_COMMANDS )
+    {
+        printf( "CommandScheduler: no room for default command %s\n", command->GetName() );
+        return false;
+    }
+    m_defaults[m_defaultCount++] = command;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Schedule
+// Description: Starts a command, cutting off the active commands that need any of
+//              its subsystems.  Nothing happens if it is already active.
+// Returns:     bool    true  = command is active
+//                      false = too many active commands (MAX_COMMANDS)
+//----------------------------------------------------------------------------------
+bool CommandScheduler::Schedule
+(
+    ICommand*                   command,    // <I> - command to start
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( IsScheduled( command ) )
+    {
+        return true;
+    }
+
+    // cut off the commands that have any of its subsystems
+    unsigned int requirements = command->GetRequirements();
+    int inx = 0;
+    while ( inx < m_activeCount )
+    {
+        if ( ( m_active[inx]->GetRequirements() & requirements ) != 0 )
+        {
+            Remove( inx, true );
+        }
+        else
+        {
+            inx++;
+        }
+    }
+
+    if ( m_activeCount >= MAX_COMMANDS )
+    {
+        printf( "CommandScheduler: no room for command %s\n", command->GetName() );
+        return false;
+    }
+    m_active[m_activeCount++] = command;
+    command->Start( inputs );
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Cancel
+// Description: Cuts off a command if it is active
+// Returns:     void
+//----------------------------------------------------------------------------------
+void CommandScheduler::Cancel
+(
+    ICommand*                   command     // <I> - command to cut off
+)
+{
+    for ( int inx = 0; inx < m_activeCount; inx++ )
+    {
+        if ( m_active[inx] == command )
+        {
+            Remove( inx, true );
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      CancelAll
+// Description: Cuts off every active command
+// Returns:     void
+//----------------------------------------------------------------------------------
+void CommandScheduler::CancelAll()
+{
+    while ( m_activeCount > 0 )
+    {
+        Remove( m_activeCount - 1, true );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsScheduled
+// Description: Checks whether a command is active
+// Returns:     bool    true  = command is active
+//----------------------------------------------------------------------------------
+bool CommandScheduler::IsScheduled
+(
+    const ICommand*             command     // <I> - command to look for
+) const
+{
+    for ( int inx = 0; inx < m_activeCount; inx++ )
+    {
+        if ( m_active[inx] == command )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Schedules the default commands for the idle subsystems, then runs
+//              the active commands that need any of the given subsystems and
+//              ends the ones that are done
+// Returns:     void
+//----------------------------------------------------------------------------------
+void CommandScheduler::Run
+(
+    const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+    unsigned int                subsystems  // <I> - COMMAND_SUBSYSTEM values to run
+)
+{
+    // a default command only starts when none of its subsystems are in use
+    unsigned int required = GetRequiredSubsystems();
+    for ( int inx = 0; inx < m_defaultCount; inx++ )
+    {
+        unsigned int requirements = m_defaults[inx]->GetRequirements();
+        if ( ( requirements & subsystems ) != 0 && ( requirements & required ) == 0 )
+        {
+            Schedule( m_defaults[inx], inputs );
+            required |= requirements;
+        }
+    }
+
+    int inx = 0;
+    while ( inx < m_activeCount )
+    {
+        ICommand* command = m_active[inx];
+        if ( ( command->GetRequirements() & subsystems ) != 0 && command->Run( inputs ) )
+        {
+            Remove( inx, false );
+        }
+        else
+        {
+            inx++;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Remove
+// Description: Ends an active command and takes it out of the active list
+// Returns:     void
+//----------------------------------------------------------------------------------
+void CommandScheduler::Remove
+(
+    int                         index,      // <I> - slot in the active list
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    ICommand* command = m_active[index];
+
+    // keep the list in the order the commands were scheduled
+    for ( int inx = index + 1; inx < m_activeCount; inx++ )
+    {
+        m_active[inx - 1] = m_active[inx];
+    }
+    m_activeCount--;
+
+    command->End( interrupted );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRequiredSubsystems
+// Description: This gets the subsystems the active commands have
+// Returns:     unsigned int    COMMAND_SUBSYSTEM values or'ed together
+//----------------------------------------------------------------------------------
+unsigned int CommandScheduler::GetRequiredSubsystems() const
+{
+    unsigned int required = 0;
+    for ( int inx = 0; inx < m_activeCount; inx++ )
+    {
+        required |= m_active[inx]->GetRequirements();
+    }
+    return required;
+}
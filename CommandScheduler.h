@@ -0,0 +1,144 @@
+/*=============================================================================================
+ * CommandScheduler.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs the active commands.  Each command requires a set of subsystems and only one
+ * command can have a subsystem at a time: scheduling a command cuts off the active commands
+ * that need any of the same subsystems.  A default command can be set for a subsystem; it is
+ * scheduled whenever nothing else has that subsystem (e.g. joystick driving when the robot
+ * isn't following the line).
+ *
+ * Run() is given the subsystems to run, so commands for different subsystems can be run at
+ * different rates (the ControlLoop runs the chassis commands in its drive task and the shooter
+ * commands in its shooter task).  A command that needs subsystems from both groups runs with
+ * each of them.
+ *
+ * The command lists are fixed size arrays; scheduling and running never allocate.  All of the
+ * methods must be called from the same thread, and commands must not schedule or cancel other
+ * commands from inside Start(), Run() or End().
+ *=============================================================================================*/
+
+#ifndef SRC_COMMANDSCHEDULER_H_
+#define SRC_COMMANDSCHEDULER_H_
+
+// Team 302 includes
+#include <ICommand.h>               // Commands being run
+#include <InputSnapshot.h>          // Inputs sampled this cycle
+
+class CommandScheduler
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      CommandScheduler <<constructor>>
+        // Description: This will create a scheduler with no commands
+        //----------------------------------------------------------------------------------
+        CommandScheduler();
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetDefaultCommand
+        // Description: Sets the command that runs when no other command has its
+        //              subsystems.  Only call this while the robot is starting up.
+        // Returns:     bool    true  = default command set
+        //                      false = too many default commands (MAX_COMMANDS)
+        //----------------------------------------------------------------------------------
+        bool SetDefaultCommand
+        (
+            ICommand*                   command     // <I> - default command (still owned by the caller)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Schedule
+        // Description: Starts a command, cutting off the active commands that need any of
+        //              its subsystems.  Nothing happens if it is already active.
+        // Returns:     bool    true  = command is active
+        //                      false = too many active commands (MAX_COMMANDS)
+        //----------------------------------------------------------------------------------
+        bool Schedule
+        (
+            ICommand*                   command,    // <I> - command to start
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Cancel
+        // Description: Cuts off a command if it is active
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Cancel
+        (
+            ICommand*                   command     // <I> - command to cut off
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      CancelAll
+        // Description: Cuts off every active command
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void CancelAll();
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsScheduled
+        // Description: Checks whether a command is active
+        // Returns:     bool    true  = command is active
+        //----------------------------------------------------------------------------------
+        bool IsScheduled
+        (
+            const ICommand*             command     // <I> - command to look for
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Schedules the default commands for the idle subsystems, then runs
+        //              the active commands that need any of the given subsystems and
+        //              ends the ones that are done
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Run
+        (
+            const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+            unsigned int                subsystems  // <I> - COMMAND_SUBSYSTEM values to run
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~CommandScheduler <<destructor>>
+        // Description: This will clean up the object.  The commands aren't ended or
+        //              deleted; call CancelAll() first while they still exist.
+        //----------------------------------------------------------------------------------
+        virtual ~CommandScheduler() = default;
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      Remove
+        // Description: Ends an active command and takes it out of the active list
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Remove
+        (
+            int                         index,      // <I> - slot in the active list
+            bool                        interrupted // <I> - true = cut off before it was done
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetRequiredSubsystems
+        // Description: This gets the subsystems the active commands have
+        // Returns:     unsigned int    COMMAND_SUBSYSTEM values or'ed together
+        //----------------------------------------------------------------------------------
+        unsigned int GetRequiredSubsystems() const;
+
+        static const int    MAX_COMMANDS = 8;
+
+        // Attributes
+        ICommand*           m_active[MAX_COMMANDS];
+        int                 m_activeCount;
+        ICommand*           m_defaults[MAX_COMMANDS];
+        int                 m_defaultCount;
+
+        // Default methods we don't want the compiler to implement for us
+        CommandScheduler( const CommandScheduler& ) = delete;
+        CommandScheduler& operator= ( const CommandScheduler& ) = delete;
+        explicit CommandScheduler( CommandScheduler* other ) = delete;
+};
+
+#endif /* SRC_COMMANDSCHEDULER_H_ */
@@ -0,0 +1,327 @@
+/*=============================================================================================
+ * ControlLoop.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs the drive, the shooter and the line tracker lights on a TaskExecutor, each at its
+ * own rate.  TeleopPeriodic and AutonomousPeriodic hand the tasks the latest command through a
+ * double buffer.  The mechanisms and the autonomous routine are run as commands by a
+ * CommandScheduler.
+ *=============================================================================================*/
+
+// WPILib includes
+#include <Timer.h>                  // FPGA timestamp
+
+// Team 302 includes
+#include <ControlLoop.h>            // This class
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+#include <IShooterFactory.h>        // Class constructs the correct shooter
+
+
+//----------------------------------------------------------------------------------
+// Method:      ControlLoop <<constructor>>
+// Description: This will construct and initialize the object.  The tasks don't
+//              run until Start() is called.
+//----------------------------------------------------------------------------------
+ControlLoop::ControlLoop
+(
+    FollowLine*         followLine,         // <I> - line follower to run
+    LoadBall*           loader,             // <I> - loader to run
+    LineUpShooter*      shooterAlignment,   // <I> - shooter alignment to run
+    SpinShooterWheel*   shooterWheel        // <I> - shooter wheel to run
+) : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+    m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+    m_snapshot( InputSnapshot::GetInstance() ),
+    m_odometry( Odometry::GetInstance() ),
+    m_followLine( followLine ),
+    m_loader( loader ),
+    m_shooterAlignment( shooterAlignment ),
+    m_shooterWheel( shooterWheel ),
+    m_executor(),
+    m_commands(),
+    m_command(),
+    m_commandValid( false ),
+    m_scheduler(),
+    m_joystickDriveCommand( "joystick drive", SUBSYSTEM_CHASSIS, PROFILE_DRIVE,
+                            [this] ( const InputSnapshotData& inputs )
+                            {
+                                if ( m_command.drive != nullptr )
+                                {
+                                    m_command.drive->DriveWithJoysticks( inputs );
+                                }
+                            } ),
+    m_followLineCommand( "follow line", SUBSYSTEM_CHASSIS, PROFILE_FOLLOW_LINE,
+                         [this] ( const InputSnapshotData& inputs ) { m_followLine->Drive( inputs ); },
+                         [this] { m_followLine->Stop(); } ),
+    m_loaderCommand( "load ball", SUBSYSTEM_LOADER, PROFILE_LOADER,
+                     [this] ( const InputSnapshotData& inputs ) { m_loader->CycleLoader( inputs ); } ),
+    m_alignShooterCommand( "align shooter", SUBSYSTEM_ALIGNER, PROFILE_SHOOTER_ALIGN,
+                           [this] ( const InputSnapshotData& inputs ) { m_shooterAlignment->AdjustShooterPosition( inputs ); } ),
+    m_shooterWheelCommand( "spin shooter wheel", SUBSYSTEM_SHOOTER_WHEEL, PROFILE_SHOOTER_WHEEL,
+                           [this] ( const InputSnapshotData& inputs ) { m_shooterWheel->SpinWheels( inputs ); } ),
+    m_autonCommand(),
+    m_autonRoutine( nullptr )
+{
+    // the commands run in this order; the wheel goes before the loader so the loader sees
+    // this cycle's at speed flag
+    m_scheduler.SetDefaultCommand( &m_joystickDriveCommand );
+    m_scheduler.SetDefaultCommand( &m_shooterWheelCommand );
+    m_scheduler.SetDefaultCommand( &m_loaderCommand );
+    m_scheduler.SetDefaultCommand( &m_alignShooterCommand );
+
+    m_executor.AddTask( "drive",     [this] { RunDrive(); },               DRIVE_RATE,     3 );
+    m_executor.AddTask( "shooter",   [this] { RunShooter(); },             SHOOTER_RATE,   2 );
+    m_executor.AddTask( "lights",    [this] { RunLights(); },              LIGHTS_RATE,    1 );
+    m_executor.AddTask( "dashboard", [this] { RunDashboard(); },          DASHBOARD_RATE, 0 );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts running the tasks
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::Start()
+{
+    m_executor.Start();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stop
+// Description: Stops running the tasks, cuts off the commands (which ends a motion
+//              profile move) and then stops the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::Stop()
+{
+    bool wasRunning = m_executor.IsRunning();
+    if ( wasRunning )
+    {
+        m_executor.Stop();
+    }
+
+    // RunCommands() may have left commands active even if the tasks weren't running; this
+    // also ends an autonomous routine that hasn't finished, which stops its motion profile
+    // before the motors are set below
+    m_scheduler.CancelAll();
+    m_autonRoutine = nullptr;
+
+    if ( wasRunning )
+    {
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetCommand
+// Description: Hands the latest operator command to the tasks.  Only call this
+//              from the main robot thread.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::SetCommand
+(
+    const DriveCommand& command     // <I> - latest command
+)
+{
+    m_commands.Write( command );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunCommands
+// Description: Runs the commands once on the calling thread, for when the tasks
+//              aren't used (the caller samples all of the inputs).  Only call this
+//              while the loop is stopped.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunCommands
+(
+    const DriveCommand& command     // <I> - latest command
+)
+{
+    m_command      = command;
+    m_commandValid = true;
+    ScheduleCommands();
+    RunScheduler( m_command.inputs, SUBSYSTEM_CHASSIS | SUBSYSTEM_SHOOTER );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Dump
+// Description: Prints the task statistics to the console.  Only call this while
+//              the loop is stopped.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::Dump()
+{
+    m_executor.Dump();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      UpdateCommand
+// Description: Gets the latest command from the main robot thread
+// Returns:     bool    true  = the command is recent enough to use
+//----------------------------------------------------------------------------------
+bool ControlLoop::UpdateCommand()
+{
+    // Stop if the operator path hasn't sent anything recently (e.g. right after Start())
+    bool   received = m_commands.Read( m_command );
+    double age      = Timer::GetFPGATimestamp() - m_command.inputs.timestamp;
+    m_commandValid  = received && ( age <= COMMAND_TIMEOUT );
+    return m_commandValid;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ScheduleCommands
+// Description: Starts or cancels the autonomous routine and line following to
+//              match the latest command
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::ScheduleCommands()
+{
+    // a new routine (or going back to operator control) cuts off the routine that was
+    // running; a routine that has finished isn't started again
+    if ( m_command.autonRoutine != m_autonRoutine )
+    {
+        m_scheduler.Cancel( &m_autonCommand );
+        m_autonRoutine = m_command.autonRoutine;
+        if ( m_autonRoutine != nullptr )
+        {
+            m_autonCommand.SetRoutine( m_autonRoutine );
+            m_scheduler.Schedule( &m_autonCommand, m_command.inputs );
+        }
+    }
+    if ( m_autonRoutine != nullptr )
+    {
+        return;
+    }
+
+    // following the line takes the chassis from joystick driving (the default command),
+    // which gets it back on the next run after the line following is cancelled
+    if ( m_command.followLine )
+    {
+        m_scheduler.Schedule( &m_followLineCommand, m_command.inputs );
+    }
+    else
+    {
+        m_scheduler.Cancel( &m_followLineCommand );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunScheduler
+// Description: Runs the commands for the subsystems.  In autonomous only the
+//              routine runs (with all of its subsystems), and nothing once it is
+//              done.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunScheduler
+(
+    const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+    unsigned int                subsystems  // <I> - COMMAND_SUBSYSTEM values to run
+)
+{
+    if ( m_autonRoutine == nullptr )
+    {
+        m_scheduler.Run( inputs, subsystems );
+    }
+    else if ( m_scheduler.IsScheduled( &m_autonCommand ) )
+    {
+        m_scheduler.Run( inputs, m_autonCommand.GetRequirements() );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunDrive
+// Description: Drive task; reads the chassis and runs the chassis commands (and
+//              the autonomous routine)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunDrive()
+{
+    // The operator inputs come from the command; the chassis is read at this rate,
+    // even when stopped, so the odometry keeps up
+    bool valid = UpdateCommand();
+    InputSnapshotData& inputs = m_command.inputs;
+    m_snapshot->SampleChassis( inputs );
+    m_odometry->Update( inputs );
+
+    if ( !valid )
+    {
+        // A motion profile keeps the motors on the points already loaded in them (and stops
+        // on the last one); commanding a speed here would throw the profile away under the
+        // routine that owns it.
+        if ( !m_chassis->IsInProfile() )
+        {
+            m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+        }
+    }
+    else
+    {
+        // the autonomous routine also uses the shooter, so it gets a fresh shooter
+        // reading at this rate too (the shooter task leaves it alone)
+        if ( m_command.autonRoutine != nullptr )
+        {
+            m_snapshot->SampleShooter( inputs );
+        }
+        ScheduleCommands();
+        RunScheduler( inputs, SUBSYSTEM_CHASSIS );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunShooter
+// Description: Shooter task; reads the shooter sensors and runs the shooter commands,
+//              or stops the shooter motors when the command is stale
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunShooter()
+{
+    // The drive task runs first and has already picked up the latest command; in
+    // autonomous it runs the routine, shooter and all
+    if ( m_commandValid && m_autonRoutine == nullptr )
+    {
+        InputSnapshotData& inputs = m_command.inputs;
+        m_snapshot->SampleShooter( inputs );
+        m_scheduler.Run( inputs, SUBSYSTEM_SHOOTER );
+    }
+    else if ( !m_commandValid )
+    {
+        // Like the drive motors: the wheel would keep its closed loop speed and the loader
+        // and aligner their last outputs.  The commands set their motors again every cycle,
+        // so they pick up where they left off when the commands come back.
+        m_shooter->SetShooterSpeed( 0.0 );
+        m_shooter->SetBallLoadMotor( 0.0 );
+        m_shooter->AlignShooter( 0.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunLights
+// Description: Lights task; updates the line tracker lights
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunLights()
+{
+    m_chassis->UpdateLineTrackerLights();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RunDashboard
+// Description: Dashboard task; sends the task statistics, the robot pose and the
+//              sensor values from the drive task's latest sample
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ControlLoop::RunDashboard()
+{
+    m_executor.PublishStats();
+    m_odometry->Publish();
+    m_snapshot->Publish( m_command.inputs );    // the tasks share one thread, so this isn't being written
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~ControlLoop <<destructor>>
+// Description: This will stop the tasks and clean up the object
+//----------------------------------------------------------------------------------
+ControlLoop::~ControlLoop()
+{
+    Stop();
+}
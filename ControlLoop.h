@@ -0,0 +1,232 @@
+/*=============================================================================================
+ * ControlLoop.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs the drive (joystick drive or line following), the shooter and the line tracker
+ * lights on a TaskExecutor, each at its own rate, so they don't depend on when driver station
+ * packets arrive.  The operator input processing stays in TeleopPeriodic and
+ * AutonomousPeriodic, which hand the latest DriveCommand to these tasks through a lock-free
+ * double buffer.  The tasks sample the chassis and shooter sensors themselves at their own
+ * rates.
+ *
+ * The mechanisms are run as commands by a CommandScheduler.  Joystick driving, the loader,
+ * the shooter alignment and the shooter wheel are the default commands for their subsystems;
+ * following the line takes the chassis from joystick driving while the DriveCommand asks for
+ * it, and the shooter keeps running alongside it.
+ *
+ * In autonomous the DriveCommand names the routine to run instead.  It runs as a command in
+ * the drive task, which samples the shooter along with the chassis, so the routine sees the
+ * chassis and the odometry at the drive rate.  The routine has the chassis and the shooter to
+ * itself, and nothing runs once it is done.  A motion profile move in the routine is streamed
+ * to the drive motors by its action on every drive cycle (see MotionProfileExecutor); while the
+ * profile owns the motors a stale command doesn't stop them, they finish the points already
+ * loaded in them.  Stop() ends the routine first, so its move is stopped before the motors are.
+ *
+ *      Task        Rate        Priority
+ *      drive       500 Hz      highest     line trackers, encoders, odometry and the chassis commands
+ *                                          (the autonomous routine in autonomous)
+ *      shooter     100 Hz                  shooter commands (loader, alignment and shooter wheel)
+ *      lights       10 Hz                  line tracker indicator lights
+ *      dashboard    10 Hz      lowest      task statistics, the robot pose and the sensor values
+ *
+ * While the loop is running it owns the drive chassis and the shooter; nothing else should
+ * command their motors or sample their sensors.
+ *=============================================================================================*/
+
+#ifndef SRC_CONTROLLOOP_H_
+#define SRC_CONTROLLOOP_H_
+
+// Team 302 includes
+#include <CommandScheduler.h>       // Runs the mechanism commands
+#include <DoubleBuffer.h>           // Passes the commands between the threads
+#include <FollowLine.h>
+#include <IChassis.h>
+#include <IJoystickDrive.h>
+#include <InputSnapshot.h>
+#include <IShooter.h>
+#include <LineUpShooter.h>
+#include <LoadBall.h>
+#include <AutonCommand.h>           // Runs the autonomous routine as a command
+#include <IAutonAction.h>
+#include <Odometry.h>               // Tracks the robot pose from the drive encoders
+#include <PeriodicCommand.h>        // Runs each mechanism as a command
+#include <SpinShooterWheel.h>
+#include <TaskExecutor.h>           // Runs the tasks at their rates
+
+struct DriveCommand
+{
+    bool                followLine;     // true = follow the line, false = drive with the joysticks
+    IJoystickDrive*     drive;          // joystick drive to use when not following the line
+    IAutonAction*       autonRoutine;   // autonomous routine to run (nullptr = operator control)
+    InputSnapshotData   inputs;         // operator inputs (the timestamp is when they were sampled)
+};
+
+class ControlLoop
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      ControlLoop <<constructor>>
+        // Description: This will construct and initialize the object.  The tasks don't
+        //              run until Start() is called.
+        //----------------------------------------------------------------------------------
+        ControlLoop
+        (
+            FollowLine*         followLine,         // <I> - line follower to run
+            LoadBall*           loader,             // <I> - loader to run
+            LineUpShooter*      shooterAlignment,   // <I> - shooter alignment to run
+            SpinShooterWheel*   shooterWheel        // <I> - shooter wheel to run
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts running the tasks
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stop
+        // Description: Stops running the tasks, cuts off the commands (which ends a motion
+        //              profile move) and then stops the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stop();
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetCommand
+        // Description: Hands the latest operator command to the tasks.  Only call this
+        //              from the main robot thread.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetCommand
+        (
+            const DriveCommand& command     // <I> - latest command
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunCommands
+        // Description: Runs the commands once on the calling thread, for when the tasks
+        //              aren't used (the caller samples all of the inputs).  Only call this
+        //              while the loop is stopped.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunCommands
+        (
+            const DriveCommand& command     // <I> - latest command
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Dump
+        // Description: Prints the task statistics to the console.  Only call this while
+        //              the loop is stopped.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Dump();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~ControlLoop <<destructor>>
+        // Description: This will stop the tasks and clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~ControlLoop();
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      UpdateCommand
+        // Description: Gets the latest command from the main robot thread
+        // Returns:     bool    true  = the command is recent enough to use
+        //----------------------------------------------------------------------------------
+        bool UpdateCommand();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ScheduleCommands
+        // Description: Starts or cancels the autonomous routine and line following to
+        //              match the latest command
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void ScheduleCommands();
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunScheduler
+        // Description: Runs the commands for the subsystems.  In autonomous only the
+        //              routine runs (with all of its subsystems), and nothing once it is
+        //              done.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunScheduler
+        (
+            const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+            unsigned int                subsystems  // <I> - COMMAND_SUBSYSTEM values to run
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunDrive
+        // Description: Drive task; reads the chassis and runs the chassis commands (and
+        //              the autonomous routine)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunDrive();
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunShooter
+        // Description: Shooter task; reads the shooter sensors and runs the shooter commands,
+        //              or stops the shooter motors when the command is stale
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunShooter();
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunLights
+        // Description: Lights task; updates the line tracker lights
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunLights();
+
+        //----------------------------------------------------------------------------------
+        // Method:      RunDashboard
+        // Description: Dashboard task; sends the task statistics, the robot pose and the
+        //              sensor values from the drive task's latest sample
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void RunDashboard();
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        const double                DRIVE_RATE = 500.0;         // Hz
+        const double                SHOOTER_RATE = 100.0;       // Hz
+        const double                LIGHTS_RATE = 10.0;         // Hz
+        const double                DASHBOARD_RATE = 10.0;      // Hz
+        const double                COMMAND_TIMEOUT = 0.1;      // seconds without a new command before stopping
+
+        IChassis*                   m_chassis;
+        IShooter*                   m_shooter;
+        InputSnapshot*              m_snapshot;
+        Odometry*                   m_odometry;
+        FollowLine*                 m_followLine;
+        LoadBall*                   m_loader;
+        LineUpShooter*              m_shooterAlignment;
+        SpinShooterWheel*           m_shooterWheel;
+
+        TaskExecutor                m_executor;
+        DoubleBuffer<DriveCommand>  m_commands;         // main robot thread -> task thread
+        DriveCommand                m_command;          // latest command (task thread only)
+        bool                        m_commandValid;     // true = m_command is recent enough to use
+
+        CommandScheduler            m_scheduler;
+        PeriodicCommand             m_joystickDriveCommand;
+        PeriodicCommand             m_followLineCommand;
+        PeriodicCommand             m_loaderCommand;
+        PeriodicCommand             m_alignShooterCommand;
+        PeriodicCommand             m_shooterWheelCommand;
+        AutonCommand                m_autonCommand;
+        IAutonAction*               m_autonRoutine;     // routine scheduled (nullptr = none)
+
+        // Default methods we don't want the compiler to implement for us
+        ControlLoop( const ControlLoop& ) = delete;
+        ControlLoop& operator= ( const ControlLoop& ) = delete;
+        explicit ControlLoop( ControlLoop* other ) = delete;
+};
+
+#endif /* SRC_CONTROLLOOP_H_ */
@@ -0,0 +1,323 @@
+/*=============================================================================================
+ * DashboardPublisher.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This moves SmartDashboard output off of the control thread.  The control code queues
+ * (handle, value, timestamp) records into a lock-free ring buffer (one per producer thread)
+ * and a low priority thread drains the buffers into the channel table, sending the channels
+ * that changed to NetworkTables at a configurable rate.
+ *=============================================================================================*/
+
+// Standard includes
+#include <chrono>                           // std::chrono::steady_clock
+#include <sys/resource.h>                   // setpriority
+
+// WPILib includes
+#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
+#include <Timer.h>                          // FPGA timestamp
+
+// Team 302 includes
+#include <DashboardPublisher.h>             // This class
+
+
+DashboardPublisher* DashboardPublisher::m_instance = nullptr; // initialize the instance variable to nullptr
+
+// Every thread uses ring 0 until it attaches; only the main robot thread should rely on that
+thread_local int DashboardPublisher::m_producer = 0;
+thread_local bool DashboardPublisher::m_attached = false;
+
+//----------------------------------------------------------------------------------
+// Method:      GetInstance
+// Description: If there isn't an instance of this class, it will create one.  The
+//              single class instance will be returned.
+// Returns:     DashboardPublisher*  instance of this class
+//----------------------------------------------------------------------------------
+DashboardPublisher* DashboardPublisher::GetInstance()
+{
+    if ( DashboardPublisher::m_instance == nullptr )
+    {
+        DashboardPublisher::m_instance = new DashboardPublisher();
+    }
+    return DashboardPublisher::m_instance;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      DashboardPublisher <<constructor>>
+// Description: This will construct and initialize the object
+//----------------------------------------------------------------------------------
+DashboardPublisher::DashboardPublisher() : m_rings(),
+                                           m_producerCount( 1 ),
+                                           m_keys(),
+                                           m_values(),
+                                           m_changed(),
+                                           m_channelCount( 0 ),
+                                           m_thread(),
+                                           m_running( false ),
+                                           m_periodMs( 100 ),
+                                           m_dropped( 0 )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AttachProducerThread
+// Description: Gives the calling thread its own ring buffer.  Call this from any
+//              thread (other than the main robot thread) before it puts values.  A
+//              thread that is already attached keeps its ring, so everything that
+//              runs on a shared thread (e.g. the HAL notifier thread) can call it.
+// Returns:     bool    true  = the thread can put values
+//                      false = no buffers left; values from this thread are dropped
+//----------------------------------------------------------------------------------
+bool DashboardPublisher::AttachProducerThread()
+{
+    if ( !m_attached )
+    {
+        int producer = m_producerCount.fetch_add( 1 );
+        m_producer = ( producer < MAX_PRODUCERS ) ? producer : -1;
+        m_attached = true;
+    }
+    return ( m_producer >= 0 );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      RegisterChannel
+// Description: Declares a dashboard key.  Call this once (e.g. in a constructor) and
+//              keep the handle for the Put methods.  Registering a key that is
+//              already registered returns the existing handle.
+// Returns:     DASHBOARD_CHANNEL   handle for the key
+//                                  (INVALID_DASHBOARD_CHANNEL if the table is full)
+//----------------------------------------------------------------------------------
+DASHBOARD_CHANNEL DashboardPublisher::RegisterChannel
+(
+    const char*         key     // <I> - dashboard key
+)
+{
+    DASHBOARD_CHANNEL channel = INVALID_DASHBOARD_CHANNEL;
+    for ( int inx=0; inx<m_channelCount && channel == INVALID_DASHBOARD_CHANNEL; ++inx )
+    {
+        if ( m_keys[inx] == key )
+        {
+            channel = inx;
+        }
+    }
+
+    if ( channel == INVALID_DASHBOARD_CHANNEL && m_channelCount < MAX_CHANNELS )
+    {
+        channel = m_channelCount;
+        m_keys[channel] = key;
+        m_channelCount++;
+    }
+    return channel;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts the publisher thread.  Values queued before this is called
+//              are held (up to the buffer size) until the thread starts.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::Start
+(
+    double      rate            // <I> - how often (Hz) to send values to the dashboard
+)
+{
+    SetRate( rate );
+    if ( !m_running.exchange( true ) )
+    {
+        m_thread = std::thread( &DashboardPublisher::Run, this );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetRate
+// Description: Changes how often the publisher thread sends values.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::SetRate
+(
+    double      rate            // <I> - how often (Hz) to send values to the dashboard
+)
+{
+    if ( rate > 0.0 )
+    {
+        m_periodMs = static_cast<int>( 1000.0 / rate );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PutNumber
+// Description: Queues a number for the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::PutNumber
+(
+    DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+    double              value       // <I> - value to display
+)
+{
+    DashboardRecord record;
+    record.channel = channel;
+    record.type    = DASHBOARD_NUMBER;
+    record.number  = value;
+    Queue( record );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PutBoolean
+// Description: Queues a boolean for the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::PutBoolean
+(
+    DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+    bool                value       // <I> - value to display
+)
+{
+    DashboardRecord record;
+    record.channel = channel;
+    record.type    = DASHBOARD_BOOLEAN;
+    record.boolean = value;
+    Queue( record );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PutString
+// Description: Queues a string for the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::PutString
+(
+    DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+    const char*         value       // <I> - value to display (string literal)
+)
+{
+    DashboardRecord record;
+    record.channel = channel;
+    record.type    = DASHBOARD_STRING;
+    record.text    = value;
+    Queue( record );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Queue
+// Description: Time stamps the record and adds it to the ring buffer
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::Queue
+(
+    DashboardRecord&    record  // <I> - record to queue
+)
+{
+    if ( record.channel >= 0 && record.channel < m_channelCount )
+    {
+        record.timestamp = Timer::GetFPGATimestamp();
+        if ( m_producer < 0 || !m_rings[m_producer].Push( record ) )
+        {
+            m_dropped++;        // never wait on the publisher thread
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Publisher thread; drains the buffer at the requested rate
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::Run()
+{
+    // On Linux the nice value is per thread, so this only lowers the publisher thread
+    setpriority( PRIO_PROCESS, 0, PUBLISHER_NICE_VALUE );
+
+    auto nextDrain = std::chrono::steady_clock::now();
+    while ( m_running )
+    {
+        Drain();
+
+        nextDrain += std::chrono::milliseconds( m_periodMs.load() );
+        std::this_thread::sleep_until( nextDrain );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Drain
+// Description: Moves everything in the buffers into the channel table and sends the
+//              channels that changed to the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::Drain()
+{
+    // Only the latest value for each channel matters, so collapse the queued records
+    DashboardRecord record;
+    double          newest = 0.0;
+    int             highest = -1;
+    for ( int producer=0; producer<MAX_PRODUCERS; ++producer )
+    {
+        while ( m_rings[producer].Pop( record ) )
+        {
+            m_values[record.channel]  = record;
+            m_changed[record.channel] = true;
+            highest = ( record.channel > highest ) ? record.channel : highest;
+            newest  = ( record.timestamp > newest ) ? record.timestamp : newest;
+        }
+    }
+
+    for ( int inx=0; inx<=highest; ++inx )
+    {
+        if ( m_changed[inx] )
+        {
+            Send( m_keys[inx], m_values[inx] );
+            m_changed[inx] = false;
+        }
+    }
+
+    if ( newest > 0.0 )
+    {
+        SmartDashboard::PutNumber( " dashboard latency", Timer::GetFPGATimestamp() - newest );
+    }
+    SmartDashboard::PutNumber( " dashboard dropped", m_dropped.load() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Send
+// Description: Sends a record to the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DashboardPublisher::Send
+(
+    const std::string&      key,    // <I> - dashboard key
+    const DashboardRecord&  record  // <I> - value to send
+)
+{
+    switch ( record.type )
+    {
+        case DASHBOARD_NUMBER:
+            SmartDashboard::PutNumber( key, record.number );
+            break;
+
+        case DASHBOARD_BOOLEAN:
+            SmartDashboard::PutBoolean( key, record.boolean );
+            break;
+
+        case DASHBOARD_STRING:
+            SmartDashboard::PutString( key, record.text );
+            break;
+
+        default:
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~DashboardPublisher <<destructor>>
+// Description: This will stop the publisher thread and clean up the object
+//----------------------------------------------------------------------------------
+DashboardPublisher::~DashboardPublisher()
+{
+    m_running = false;
+    if ( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+    DashboardPublisher::m_instance = nullptr;
+}
@@ -0,0 +1,226 @@
+/*=============================================================================================
+ * DashboardPublisher.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This moves SmartDashboard output off of the control thread.  Each subsystem registers its
+ * dashboard keys (channels) once when it is constructed and gets back an integer handle.  The
+ * control code then queues (handle, value, timestamp) records into a lock-free ring buffer and
+ * a low priority thread drains the buffer into a preallocated table indexed by the handle,
+ * sending each channel that changed to NetworkTables at a configurable rate.  Queuing a value
+ * never blocks, never allocates and never looks at the key; if the buffer is full the value is
+ * dropped and counted.
+ *
+ * String values must be string literals (or otherwise live for the life of the robot program)
+ * since only the pointer is queued.  RegisterChannel may only be called from the main robot
+ * thread.  Each thread that puts values gets its own ring buffer, so any thread other than the
+ * main robot thread must call AttachProducerThread before its first Put.  It is a Singleton.
+ *=============================================================================================*/
+
+#ifndef SRC_DASHBOARDPUBLISHER_H_
+#define SRC_DASHBOARDPUBLISHER_H_
+
+// Standard includes
+#include <atomic>               // std::atomic
+#include <string>               // std::string
+#include <thread>               // std::thread
+
+// Team 302 includes
+#include <SpscRingBuffer.h>     // Queue between the control thread and the publisher thread
+
+enum DASHBOARD_VALUE_TYPE
+{
+    DASHBOARD_NUMBER,
+    DASHBOARD_BOOLEAN,
+    DASHBOARD_STRING
+};
+
+typedef int DASHBOARD_CHANNEL;          // handle returned by RegisterChannel
+
+const DASHBOARD_CHANNEL INVALID_DASHBOARD_CHANNEL = -1;
+
+struct DashboardRecord
+{
+    DASHBOARD_CHANNEL       channel;    // registered channel
+    DASHBOARD_VALUE_TYPE    type;       // which value field is used
+    double                  number;     // DASHBOARD_NUMBER value
+    bool                    boolean;    // DASHBOARD_BOOLEAN value
+    const char*             text;       // DASHBOARD_STRING value
+    double                  timestamp;  // FPGA time (seconds) the value was queued
+};
+
+class DashboardPublisher
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetInstance
+        // Description: If there isn't an instance of this class, it will create one.  The
+        //              single class instance will be returned.
+        // Returns:     DashboardPublisher*  instance of this class
+        //----------------------------------------------------------------------------------
+        static DashboardPublisher* GetInstance();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts the publisher thread.  Values queued before this is called
+        //              are held (up to the buffer size) until the thread starts.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            double      rate            // <I> - how often (Hz) to send values to the dashboard
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetRate
+        // Description: Changes how often the publisher thread sends values.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetRate
+        (
+            double      rate            // <I> - how often (Hz) to send values to the dashboard
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      AttachProducerThread
+        // Description: Gives the calling thread its own ring buffer.  Call this from any
+        //              thread (other than the main robot thread) before it puts values.  A
+        //              thread that is already attached keeps its ring, so everything that
+        //              runs on a shared thread (e.g. the HAL notifier thread) can call it.
+        // Returns:     bool    true  = the thread can put values
+        //                      false = no buffers left; values from this thread are dropped
+        //----------------------------------------------------------------------------------
+        bool AttachProducerThread();
+
+        //----------------------------------------------------------------------------------
+        // Method:      RegisterChannel
+        // Description: Declares a dashboard key.  Call this once (e.g. in a constructor) and
+        //              keep the handle for the Put methods.  Registering a key that is
+        //              already registered returns the existing handle.
+        // Returns:     DASHBOARD_CHANNEL   handle for the key
+        //                                  (INVALID_DASHBOARD_CHANNEL if the table is full)
+        //----------------------------------------------------------------------------------
+        DASHBOARD_CHANNEL RegisterChannel
+        (
+            const char*         key     // <I> - dashboard key
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      PutNumber
+        // Description: Queues a number for the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void PutNumber
+        (
+            DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+            double              value       // <I> - value to display
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      PutBoolean
+        // Description: Queues a boolean for the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void PutBoolean
+        (
+            DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+            bool                value       // <I> - value to display
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      PutString
+        // Description: Queues a string for the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void PutString
+        (
+            DASHBOARD_CHANNEL   channel,    // <I> - handle from RegisterChannel
+            const char*         value       // <I> - value to display (string literal)
+        );
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      Queue
+        // Description: Time stamps the record and adds it to the ring buffer
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Queue
+        (
+            DashboardRecord&    record  // <I> - record to queue
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Publisher thread; drains the buffer at the requested rate
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Run();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Drain
+        // Description: Moves everything in the buffers into the channel table and sends the
+        //              channels that changed to the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Drain();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Send
+        // Description: Sends a record to the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Send
+        (
+            const std::string&      key,    // <I> - dashboard key
+            const DashboardRecord&  record  // <I> - value to send
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      DashboardPublisher <<constructor>>
+        // Description: This will construct and initialize the object
+        //----------------------------------------------------------------------------------
+        DashboardPublisher();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~DashboardPublisher <<destructor>>
+        // Description: This will stop the publisher thread and clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~DashboardPublisher();
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static DashboardPublisher*  m_instance;     // Singleton instance of this class
+
+        static const size_t         RING_SIZE = 2048;           // records held between drains
+        static const int            MAX_CHANNELS = 128;         // keys that can be registered
+        static const int            MAX_PRODUCERS = 2;          // threads that can put values
+        const int                   PUBLISHER_NICE_VALUE = 10;  // run below the control thread
+
+        // One ring per producer thread (index 0 is the main robot thread) -> publisher thread
+        SpscRingBuffer<DashboardRecord, RING_SIZE>  m_rings[MAX_PRODUCERS];
+        std::atomic<int>            m_producerCount;            // rings handed out so far
+        static thread_local int     m_producer;                 // ring used by this thread (-1 = none)
+        static thread_local bool    m_attached;                 // true = this thread has been given a ring
+
+        // Channel table (index is the DASHBOARD_CHANNEL).  The keys are written by
+        // RegisterChannel before the handle is ever queued; the values and the changed
+        // flags are only touched by the publisher thread.
+        std::string                 m_keys[MAX_CHANNELS];       // dashboard key for each channel
+        DashboardRecord             m_values[MAX_CHANNELS];     // latest value for each channel
+        bool                        m_changed[MAX_CHANNELS];    // true = not sent since last update
+        int                         m_channelCount;             // channels registered so far
+
+        std::thread                 m_thread;       // publisher thread
+        std::atomic<bool>           m_running;      // false tells the thread to exit
+        std::atomic<int>            m_periodMs;     // time between drains
+        std::atomic<unsigned int>   m_dropped;      // records dropped because the ring was full
+
+        // Default methods we don't want the compiler to implement for us
+        DashboardPublisher( const DashboardPublisher& ) = delete;
+        DashboardPublisher& operator= ( const DashboardPublisher& ) = delete;
+        explicit DashboardPublisher( DashboardPublisher* other ) = delete;
+};
+
+#endif /* SRC_DASHBOARDPUBLISHER_H_ */
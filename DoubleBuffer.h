@@ -0,0 +1,92 @@
+/*=============================================================================================
+ * DoubleBuffer.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a lock-free double buffer for handing the latest value of something from exactly one
+ * writer thread to reader threads.  Reading doesn't change the buffer, so any number of threads
+ * can read at the same time.  The writer fills the slot the reader isn't using
+ * and then publishes it by bumping a sequence number.  The reader copies the published slot and
+ * checks the sequence number afterwards; if the writer published again while it was copying, it
+ * copies again.  Neither side ever blocks or allocates and the writer never waits.
+ *
+ * Only the latest value is kept, so this is for state (e.g. commands), not for events.
+ *=============================================================================================*/
+
+#ifndef SRC_DOUBLEBUFFER_H_
+#define SRC_DOUBLEBUFFER_H_
+
+// Standard includes
+#include <atomic>       // std::atomic
+
+template <typename T>
+class DoubleBuffer
+{
+    public:
+        //------------------------------------------------------------------
+        // Method:      DoubleBuffer     <<constructor>>
+        // Description: Create a buffer that hasn't been written yet.
+        //------------------------------------------------------------------
+        DoubleBuffer() : m_slots(),
+                         m_sequence( 0 )
+        {
+        }
+
+        //------------------------------------------------------------------
+        // Method:      Write
+        // Description: Publishes a new value.  Only call this from the
+        //              writer thread.
+        // Returns:     void
+        //------------------------------------------------------------------
+        void Write
+        (
+            const T&    value           // <I> - value to publish
+        )
+        {
+            unsigned int next = m_sequence.load( std::memory_order_relaxed ) + 1;
+            m_slots[next & 1] = value;
+            m_sequence.store( next, std::memory_order_release );
+        }
+
+        //------------------------------------------------------------------
+        // Method:      Read
+        // Description: Copies the latest value.  This can be called from
+        //              any thread except the writer.
+        // Returns:     bool    true  = value was copied
+        //                      false = nothing has been written yet
+        //------------------------------------------------------------------
+        bool Read
+        (
+            T&          value           // <O> - latest value
+        ) const
+        {
+            unsigned int before = m_sequence.load( std::memory_order_acquire );
+            unsigned int after  = before;
+            if ( before != 0 )
+            {
+                do
+                {
+                    // The writer only touches this slot again two writes from now, so
+                    // the copy is good as long as nothing was published during it
+                    before = after;
+                    value  = m_slots[before & 1];
+                    std::atomic_thread_fence( std::memory_order_acquire );
+                    after  = m_sequence.load( std::memory_order_acquire );
+                } while ( before != after );
+            }
+            return ( before != 0 );
+        }
+
+        virtual ~DoubleBuffer() = default;
+
+    private:
+        T                           m_slots[2];     // storage
+        std::atomic<unsigned int>   m_sequence;     // number of writes (slot is sequence & 1)
+
+        // Default methods we don't want the compiler to implement for us
+        DoubleBuffer( const DoubleBuffer& ) = delete;
+        DoubleBuffer& operator= ( const DoubleBuffer& ) = delete;
+};
+
+#endif /* SRC_DOUBLEBUFFER_H_ */
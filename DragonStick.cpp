@@ -18,12 +18,17 @@
 
 // WPILIB includes
 #include <Joystick.h>
-#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
 
 // Team 302 includes
 #include <DragonStick.h>
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
 #include <LimitValue.h>
 
+// Dashboard keys for each axis (index is AXIS_IDENTIFIER); the triggers aren't published
+static const char* const RAW_VALUE_KEYS[MAX_AXIS] = { " raw value - left x ",  " raw value - left y ",  nullptr, nullptr, " raw value - right x ", " raw value - right y " };
+static const char* const PROFILE_KEYS[MAX_AXIS]   = { " profile - left x",     " profile - left y",     nullptr, nullptr, " profile - right x",    " profile - right y" };
+static const char* const SCALE_KEYS[MAX_AXIS]     = { " scale - left x",       " scale - left y",       nullptr, nullptr, " scale - right x",      " scale - right y" };
+
 //------------------------------------------------------------------
 // Method:      DragonStick     <<constructor>>
 // Description: Create and initialize the joystick.
@@ -35,7 +40,12 @@ DragonStick::DragonStick
     m_axisScale(),
     m_axisInvertScale(),
     m_axisProfile(),
-    m_buttonPressedPreviously()
+    m_buttonPressedPreviously(),
+    m_dashboard( DashboardPublisher::GetInstance() ),
+    m_deadbandChannel( m_dashboard->RegisterChannel(" deadband") ),
+    m_rawValueChannels(),
+    m_profileChannels(),
+    m_scaleChannels()
 {
     // initialize axis scale factor
     m_axisScale.resize( MAX_AXIS );
@@ -54,6 +64,27 @@ DragonStick::DragonStick
     // initialize all buttons not pressed
     m_buttonPressedPreviously.resize( MAX_BUTTONS );
     std::fill( m_buttonPressedPreviously.begin(), m_buttonPressedPreviously.end(), false );
+
+    // declare the dashboard channels for each axis
+    for ( uint32_t axis=0; axis<MAX_AXIS; ++axis )
+    {
+        m_rawValueChannels[axis] = INVALID_DASHBOARD_CHANNEL;
+        m_profileChannels[axis]  = INVALID_DASHBOARD_CHANNEL;
+        m_scaleChannels[axis]    = INVALID_DASHBOARD_CHANNEL;
+        if ( RAW_VALUE_KEYS[axis] != nullptr )
+        {
+            m_rawValueChannels[axis] = m_dashboard->RegisterChannel( RAW_VALUE_KEYS[axis] );
+            m_profileChannels[axis]  = m_dashboard->RegisterChannel( PROFILE_KEYS[axis] );
+            m_scaleChannels[axis]    = m_dashboard->RegisterChannel( SCALE_KEYS[axis] );
+        }
+    }
+
+    // The settings only change when they are set, so publish them here rather than on every read
+    m_dashboard->PutNumber( m_deadbandChannel, DragonStick::m_DEAD_BAND_THRESHOLD );
+    for ( uint32_t axis=0; axis<MAX_AXIS; ++axis )
+    {
+        PublishAxisSettings( axis );
+    }
 }
 
 //------------------------------------------------------------------
@@ -77,6 +108,7 @@ void DragonStick::SetScaleFactor
         // verify the value is within range and then set the attribute
         float scale = LimitValue::ForceInRange( scaleFactor, 0.0, 1.0 );
         m_axisScale[axis] = scale;
+        PublishAxisSettings( axis );
     }
 }
 
@@ -94,6 +126,7 @@ void DragonStick::SetAxisProfile
     if ( axis < m_axisProfile.size() )  // only if it is a valid axis
     {
         m_axisProfile[axis] = profile;
+        PublishAxisSettings( axis );
     }
 }
 
@@ -107,23 +140,10 @@ float DragonStick::GetRawAxis(uint32_t axis) const
 {
     float output = Joystick::GetRawAxis(axis);                  //Get original value from joystick
 
-    SmartDashboard::PutNumber(" deadband", DragonStick::m_DEAD_BAND_THRESHOLD );
-
-    SmartDashboard::PutNumber(" raw value - left x ", Joystick::GetRawAxis( X_AXIS_LEFT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" profile - left x", GetAxisProfile( X_AXIS_LEFT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" scale - left x", GetAxisScaleFactor( X_AXIS_LEFT_JOYSTICK ) );
-
-    SmartDashboard::PutNumber(" raw value - left y ", Joystick::GetRawAxis( Y_AXIS_LEFT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" profile - left y", GetAxisProfile( Y_AXIS_LEFT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" scale - left y", GetAxisScaleFactor( Y_AXIS_LEFT_JOYSTICK ) );
-
-    SmartDashboard::PutNumber(" raw value - right x ", Joystick::GetRawAxis( X_AXIS_RIGHT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" profile - right x", GetAxisProfile( X_AXIS_RIGHT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" scale - right x", GetAxisScaleFactor( X_AXIS_RIGHT_JOYSTICK ) );
-
-    SmartDashboard::PutNumber(" raw value - right y ", Joystick::GetRawAxis( Y_AXIS_RIGHT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" profile - right y", GetAxisProfile( Y_AXIS_RIGHT_JOYSTICK ) );
-    SmartDashboard::PutNumber(" scale - right y", GetAxisScaleFactor( Y_AXIS_RIGHT_JOYSTICK ) );
+    if ( axis < MAX_AXIS )
+    {
+        m_dashboard->PutNumber( m_rawValueChannels[axis], output );
+    }
 
     if( std::abs(output) < DragonStick::m_DEAD_BAND_THRESHOLD ) //Check if the joystick value is within the dead band threshold
     {
@@ -280,6 +300,24 @@ float DragonStick::GetAxisScaleFactor
     return scale;
 }
 
+//------------------------------------------------------------------
+// Method:      PublishAxisSettings
+// Description: sends the profile and scale factor for the axis to the
+//              dashboard
+// Returns:     void
+//------------------------------------------------------------------
+void DragonStick::PublishAxisSettings
+(
+       uint32_t axis           // <I> - axis number to publish
+) const
+{
+    if ( axis < MAX_AXIS )
+    {
+        m_dashboard->PutNumber( m_profileChannels[axis], GetAxisProfile( axis ) );
+        m_dashboard->PutNumber( m_scaleChannels[axis], GetAxisScaleFactor( axis ) );
+    }
+}
+
 //------------------------------------------------------------------
 // Method:      GetAxisProfile
 // Description: returns the axis profile for the specifed axis
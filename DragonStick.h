@@ -15,6 +15,10 @@
 #define SRC_DRAGONSTICK_H_
 
 #include <Joystick.h>
+
+// Team 302 includes
+#include <DashboardPublisher.h>
+
 enum BUTTON_IDENTIFIER
 {
     A_BUTTON,
@@ -166,6 +170,17 @@ class DragonStick : public Joystick
                uint32_t axis           // <I> - axis number to query
         ) const;
 
+        //------------------------------------------------------------------
+        // Method:      PublishAxisSettings
+        // Description: sends the profile and scale factor for the axis to the
+        //              dashboard
+        // Returns:     void
+        //------------------------------------------------------------------
+        void PublishAxisSettings
+        (
+               uint32_t axis           // <I> - axis number to publish
+        ) const;
+
         //------------------------------------------------------------------
         // Method:      GetButtonPressedPrev
         // Description: returns whether the button was previously press or not
@@ -208,6 +223,12 @@ class DragonStick : public Joystick
         std::vector<bool>           m_buttonPressedPreviously;  // indicates whether the button was press on its last query
                                                                 // or notBUTTON_IDENTIFIER is the index into the vector.
 
+        DashboardPublisher*         m_dashboard;                // sends the axis values to the dashboard
+        const DASHBOARD_CHANNEL     m_deadbandChannel;          // dashboard handle for the deadband
+        DASHBOARD_CHANNEL           m_rawValueChannels[MAX_AXIS];   // dashboard handles (index is AXIS_IDENTIFIER)
+        DASHBOARD_CHANNEL           m_profileChannels[MAX_AXIS];    // dashboard handles (index is AXIS_IDENTIFIER)
+        DASHBOARD_CHANNEL           m_scaleChannels[MAX_AXIS];      // dashboard handles (index is AXIS_IDENTIFIER)
+
         // Default methods we don't want the compiler to implement for us
         DragonStick() = delete;
         DragonStick( const DragonStick& ) = delete;
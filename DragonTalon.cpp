@@ -0,0 +1,402 @@
+/*=============================================================================================
+ * DragonTalon.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a CANTalon that only passes an output on to the CANTalon when the output changes (or
+ * the keep-alive interval passes) and only sends config that differs from its shadow copy, and
+ * counts the Set() calls and config frames it passed on and skipped.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // fabs
+#include <cstdio>                   // printf
+
+// WPILib includes
+#include <CANTalon.h>               // parent class
+#include <Timer.h>                  // FPGA timestamp
+
+// Team 302 includes
+#include <DragonTalon.h>            // This class
+
+
+DragonTalon* DragonTalon::m_talons[MAX_TALONS] = { nullptr };
+
+//----------------------------------------------------------------------------------
+// Method:      DragonTalon <<constructor>>
+// Description: This will create the Talon and add it to the frame count report
+//----------------------------------------------------------------------------------
+DragonTalon::DragonTalon
+(
+    int             deviceNumber,   // <I> - CAN ID
+    const char*     name            // <I> - name in the report (string literal)
+) : CANTalon( deviceNumber ),       // initialize the parent class
+    m_name( name ),
+    m_keepAlive( DEFAULT_KEEP_ALIVE ),
+    m_sent( false ),
+    m_lastValue( 0.0 ),
+    m_lastMode( kPercentVbus ),
+    m_lastSendTime( 0.0 ),
+    m_inverted( false ),
+    m_neutralModeKnown( false ),
+    m_neutralMode( kNeutralMode_Jumper ),
+    m_sensorDirectionKnown( false ),
+    m_sensorReversed( false ),
+    m_outputDirectionKnown( false ),
+    m_outputReversed( false ),
+    m_statusFramePeriods(),
+    m_setsPassedOn( 0 ),
+    m_setsSkipped( 0 ),
+    m_configFramesSent( 0 ),
+    m_configFramesSkipped( 0 )
+{
+    for ( int inx=0; inx<MAX_TALONS; ++inx )
+    {
+        if ( m_talons[inx] == nullptr )
+        {
+            m_talons[inx] = this;
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Set
+// Description: Passes the output on to the CANTalon if it changed (or the keep-alive
+//              interval passed); the CANTalon sends it in its periodic control frame
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::Set
+(
+    float           value,          // <I> - output in the units of the control mode
+    uint8_t         syncGroup       // <I> - CAN sync group
+)
+{
+    ControlMode mode = GetControlMode();    // cached by the CANTalon, so no CAN traffic
+    double      now  = Timer::GetFPGATimestamp();
+
+    // Open loop outputs are reversed here; the Talon reverses the closed loop output and the
+    // other modes' values (follower ID, motion profile enable) must not be negated
+    if ( m_inverted && ( mode == kPercentVbus || mode == kVoltage || mode == kCurrent ) )
+    {
+        value = -value;
+    }
+
+    bool changed = !m_sent ||
+                   mode != m_lastMode ||
+                   fabs( value - m_lastValue ) > OUTPUT_EPSILON ||
+                   ( now - m_lastSendTime ) >= m_keepAlive;
+    if ( changed )
+    {
+        CANTalon::Set( value, syncGroup );
+        m_sent         = true;
+        m_lastValue    = value;
+        m_lastMode     = mode;
+        m_lastSendTime = now;
+        m_setsPassedOn.fetch_add( 1, std::memory_order_relaxed );
+    }
+    else
+    {
+        m_setsSkipped.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetInverted
+// Description: Reverses the motor: open loop outputs are negated on the roboRIO and
+//              the closed loop output is reversed on the Talon (sent only if the
+//              Talon doesn't already have this direction)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::SetInverted
+(
+    bool            isInverted      // <I> - true = reverse the motor
+)
+{
+    m_inverted = isInverted;
+    if ( CountConfig( !m_outputDirectionKnown || isInverted != m_outputReversed ) )
+    {
+        CANTalon::SetClosedLoopOutputDirection( isInverted );
+        m_outputDirectionKnown = true;
+        m_outputReversed       = isInverted;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetInverted
+// Description: Returns whether the motor is reversed
+// Returns:     bool    true = reversed
+//----------------------------------------------------------------------------------
+bool DragonTalon::GetInverted() const
+{
+    return m_inverted;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Configure
+// Description: Sets the inversion, sensor direction and neutral mode together (only
+//              the ones that differ from the shadow are sent)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::Configure
+(
+    const DragonTalonConfig&    config  // <I> - configuration to set
+)
+{
+    SetInverted( config.inverted );
+    SetSensorDirection( config.sensorReversed );
+    ConfigNeutralMode( config.neutralMode );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ConfigNeutralMode
+// Description: Sets brake or coast mode if the Talon isn't already in it
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::ConfigNeutralMode
+(
+    NeutralMode     mode            // <I> - brake or coast at zero output
+)
+{
+    if ( CountConfig( !m_neutralModeKnown || mode != m_neutralMode ) )
+    {
+        CANTalon::ConfigNeutralMode( mode );
+        m_neutralModeKnown = true;
+        m_neutralMode      = mode;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetSensorDirection
+// Description: Reverses the encoder if the Talon doesn't already have this direction
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::SetSensorDirection
+(
+    bool            reverseSensor   // <I> - true = reverse the encoder
+)
+{
+    if ( CountConfig( !m_sensorDirectionKnown || reverseSensor != m_sensorReversed ) )
+    {
+        CANTalon::SetSensorDirection( reverseSensor );
+        m_sensorDirectionKnown = true;
+        m_sensorReversed       = reverseSensor;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetStatusFrameRateMs
+// Description: Changes how often the Talon sends a status frame if it isn't
+//              already sending it at this period
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::SetStatusFrameRateMs
+(
+    StatusFrameRate frame,          // <I> - status frame to change
+    int             periodMs        // <I> - time between frames
+)
+{
+    int  inx      = static_cast<int>( frame );
+    bool shadowed = ( inx >= 0 && inx < MAX_STATUS_FRAMES );
+    if ( CountConfig( !shadowed || periodMs != m_statusFramePeriods[inx] ) )
+    {
+        CANTalon::SetStatusFrameRateMs( frame, periodMs );
+        if ( shadowed )
+        {
+            m_statusFramePeriods[inx] = periodMs;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetStatusFrameProfile
+// Description: Sets the status frame periods of a profile (frames the profile
+//              leaves at 0 aren't changed)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::SetStatusFrameProfile
+(
+    const TalonStatusFrameProfile&  profile     // <I> - status frame periods
+)
+{
+    if ( profile.feedbackMs > 0 )
+    {
+        SetStatusFrameRateMs( StatusFrameRateFeedback, profile.feedbackMs );
+    }
+    if ( profile.quadEncoderMs > 0 )
+    {
+        SetStatusFrameRateMs( StatusFrameRateQuadEncoder, profile.quadEncoderMs );
+    }
+    if ( profile.analogTempVbatMs > 0 )
+    {
+        SetStatusFrameRateMs( StatusFrameRateAnalogTempVbat, profile.analogTempVbatMs );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetSensorPosition
+// Description: Reads the position of the closed loop sensor (after the sensor
+//              direction), the value the Talon's closed loop uses
+// Returns:     int     encoder counts
+//----------------------------------------------------------------------------------
+int DragonTalon::GetSensorPosition() const
+{
+    // No encoder codes per rev are set, so this is in native units (counts)
+    return static_cast<int>( CANTalon::GetPosition() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetSensorVelocity
+// Description: Reads the velocity of the closed loop sensor (after the sensor
+//              direction), the value the Talon's closed loop uses
+// Returns:     int     encoder counts per 0.1 sec
+//----------------------------------------------------------------------------------
+int DragonTalon::GetSensorVelocity() const
+{
+    // No encoder codes per rev are set, so this is in native units (counts per 0.1 sec)
+    return static_cast<int>( CANTalon::GetSpeed() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetOutputVoltage
+// Description: Reads the voltage applied to the motor, positive when the mechanism
+//              moves forward (the Talon reports it before the motor is reversed)
+// Returns:     double  volts
+//----------------------------------------------------------------------------------
+double DragonTalon::GetOutputVoltage() const
+{
+    double voltage = CANTalon::GetOutputVoltage();
+    return m_inverted ? -voltage : voltage;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetEncoderSampleAge
+// Description: Returns the expected age of a sensor reading: half the feedback
+//              status frame period.  A reading is never older than the full period
+//              (twice this) plus the CAN transmit time.
+// Returns:     double  seconds
+//----------------------------------------------------------------------------------
+double DragonTalon::GetEncoderSampleAge() const
+{
+    // The period only changes while the robot is being set up, on the main thread
+    int periodMs = m_statusFramePeriods[StatusFrameRateFeedback];
+    if ( periodMs <= 0 )
+    {
+        periodMs = DEFAULT_FEEDBACK_FRAME_MS;
+    }
+    return 0.5 * periodMs / 1000.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetKeepAlive
+// Description: Changes how long an unchanged output can go without being resent
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::SetKeepAlive
+(
+    double          seconds         // <I> - longest time between frames
+)
+{
+    m_keepAlive = seconds;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetSetsPassedOn
+// Description: Returns how many Set() calls were passed on to the CANTalon since
+//              the last dump
+// Returns:     unsigned int    Set() calls passed on
+//----------------------------------------------------------------------------------
+unsigned int DragonTalon::GetSetsPassedOn() const
+{
+    return m_setsPassedOn.load( std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetSetsSkipped
+// Description: Returns how many Set() calls were skipped since the last dump
+// Returns:     unsigned int    Set() calls skipped
+//----------------------------------------------------------------------------------
+unsigned int DragonTalon::GetSetsSkipped() const
+{
+    return m_setsSkipped.load( std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetConfigFramesSent
+// Description: Returns how many config frames were sent since the last dump
+// Returns:     unsigned int    config frames sent
+//----------------------------------------------------------------------------------
+unsigned int DragonTalon::GetConfigFramesSent() const
+{
+    return m_configFramesSent.load( std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      CountConfig
+// Description: Counts a config call as sent or skipped
+// Returns:     bool    the value of changed (true = send the config)
+//----------------------------------------------------------------------------------
+bool DragonTalon::CountConfig
+(
+    bool            changed         // <I> - true = the shadow doesn't match
+)
+{
+    if ( changed )
+    {
+        m_configFramesSent.fetch_add( 1, std::memory_order_relaxed );
+    }
+    else
+    {
+        m_configFramesSkipped.fetch_add( 1, std::memory_order_relaxed );
+    }
+    return changed;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      DumpFrameCounts
+// Description: Prints the Set() and config frame counts of every Talon to the
+//              console and clears them
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DragonTalon::DumpFrameCounts()
+{
+    // The outputs go out in each Talon's periodic control frame whether Set() is called or
+    // not, so these are roboRIO calls saved, not bus frames
+    printf( "Talon Set() calls\n" );
+    for ( int inx=0; inx<MAX_TALONS; ++inx )
+    {
+        DragonTalon* talon = m_talons[inx];
+        if ( talon != nullptr )
+        {
+            unsigned int passedOn = talon->m_setsPassedOn.exchange( 0, std::memory_order_relaxed );
+            unsigned int skipped  = talon->m_setsSkipped.exchange( 0, std::memory_order_relaxed );
+            unsigned int total    = passedOn + skipped;
+            unsigned int configSent    = talon->m_configFramesSent.exchange( 0, std::memory_order_relaxed );
+            unsigned int configSkipped = talon->m_configFramesSkipped.exchange( 0, std::memory_order_relaxed );
+            printf( "  %-14s id %2d  Set() passed on %8u  skipped %8u  (%5.1f%% passed on)  config frames sent %4u  skipped %4u\n",
+                    talon->m_name,
+                    talon->GetDeviceID(),
+                    passedOn,
+                    skipped,
+                    ( total > 0 ) ? 100.0 * passedOn / total : 0.0,
+                    configSent,
+                    configSkipped );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~DragonTalon <<destructor>>
+// Description: This will remove the Talon from the frame count report
+//----------------------------------------------------------------------------------
+DragonTalon::~DragonTalon()
+{
+    for ( int inx=0; inx<MAX_TALONS; ++inx )
+    {
+        if ( m_talons[inx] == this )
+        {
+            m_talons[inx] = nullptr;
+        }
+    }
+}
@@ -0,0 +1,302 @@
+/*=============================================================================================
+ * DragonTalon.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a CANTalon that only passes an output on to the CANTalon when the output changes.
+ * Set() remembers the last value (and control mode) that was passed on; a value within
+ * OUTPUT_EPSILON of it in the same mode is skipped unless the keep-alive interval has passed,
+ * so a motor that is commanded the same value every cycle (e.g. 0.0 while idle) only refreshes
+ * it at the keep-alive rate.  Everything else is passed straight through to the CANTalon.
+ *
+ * The 2016 CANTalon sends its control frame on its own period (10 ms) with whatever output it
+ * was last given, so a skipped Set() saves a call into the CAN driver, not a bus frame; the bus
+ * use of the outputs is set by the control frame period.
+ *
+ * The configuration that lives on the Talon (neutral mode, sensor direction, closed loop output
+ * direction and status frame periods) is kept in a shadow copy of what was last sent.  The
+ * methods below hide the CANTalon ones, so a call that asks for what the Talon already has
+ * doesn't send anything; Configure() sets everything a subsystem needs in one go when it is
+ * constructed.
+ *
+ * Directions: callers always work in the mechanism's units, positive forward.
+ *  - SetInverted() reverses the motor.  The open loop outputs (percent vbus, voltage and
+ *    current) are negated here on the roboRIO; the closed loop modes (speed, position and motion
+ *    profile) keep their setpoints as they are and the Talon reverses its closed loop output
+ *    instead.  The CANTalon's own inversion isn't used, since it negates some closed loop
+ *    setpoints but not others and the Talon never sees it.  A follower copies its master's
+ *    output after the master has reversed it, so it is only inverted if it is mounted the other
+ *    way from its master.
+ *  - SetSensorDirection() reverses the sensor the closed loop uses, so it counts up when the
+ *    mechanism moves forward.  GetSensorPosition() and GetSensorVelocity() read that sensor, the
+ *    same values the Talon's closed loop works on.  The CANTalon's GetEncPosition() and
+ *    GetEncVel() are the raw quadrature counts and ignore the sensor direction, so they aren't
+ *    used with a closed loop.  GetOutputVoltage() is positive when the mechanism moves forward.
+ *
+ * SetStatusFrameProfile() sets the status frame periods from one of the per-robot profiles in
+ * RobotDefn.h.  The sensor readings come from the newest feedback status frame, which the
+ * roboRIO caches as it arrives, so a reading is between 0 and one frame period old (plus the
+ * CAN transmit time, well under a millisecond).  The CANTalon doesn't say when the frame
+ * arrived, so GetEncoderSampleAge() is the middle of that range, worked out from the period the
+ * frame was set to.
+ *
+ * Each Talon counts the Set() calls it passed on and skipped, and the config frames it sent and
+ * skipped.  DumpFrameCounts() prints the counts of every Talon to the console (call it when the
+ * robot is disabled) and clears them.
+ *
+ * The Talons must be created on the main robot thread.  Each Talon should only be Set() or
+ * configured from one thread at a time.
+ *=============================================================================================*/
+
+#ifndef SRC_DRAGONTALON_H_
+#define SRC_DRAGONTALON_H_
+
+// Standard includes
+#include <atomic>                   // std::atomic
+
+// WPILib includes
+#include <CANTalon.h>               // parent class
+
+// Team 302 includes
+#include <RobotDefn.h>              // TalonStatusFrameProfile
+
+// Configuration a subsystem sets up when it creates a Talon
+struct DragonTalonConfig
+{
+    bool                            inverted;           // true = reverse the motor
+    bool                            sensorReversed;     // true = reverse the encoder (it counts down going forward)
+    CANSpeedController::NeutralMode neutralMode;        // brake or coast at zero output
+};
+
+class DragonTalon : public CANTalon
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      DragonTalon <<constructor>>
+        // Description: This will create the Talon and add it to the frame count report
+        //----------------------------------------------------------------------------------
+        DragonTalon
+        (
+            int             deviceNumber,   // <I> - CAN ID
+            const char*     name            // <I> - name in the report (string literal)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Set
+        // Description: Sends the output if it changed (or the keep-alive interval passed)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Set
+        (
+            float           value,          // <I> - output in the units of the control mode
+            uint8_t         syncGroup = 0   // <I> - CAN sync group
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetInverted
+        // Description: Reverses the motor: open loop outputs are negated on the roboRIO and
+        //              the closed loop output is reversed on the Talon (sent only if the
+        //              Talon doesn't already have this direction)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetInverted
+        (
+            bool            isInverted      // <I> - true = reverse the motor
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetInverted
+        // Description: Returns whether the motor is reversed
+        // Returns:     bool    true = reversed
+        //----------------------------------------------------------------------------------
+        bool GetInverted() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Configure
+        // Description: Sets the inversion, sensor direction and neutral mode together (only
+        //              the ones that differ from the shadow are sent)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Configure
+        (
+            const DragonTalonConfig&    config  // <I> - configuration to set
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      ConfigNeutralMode
+        // Description: Sets brake or coast mode if the Talon isn't already in it
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void ConfigNeutralMode
+        (
+            NeutralMode     mode            // <I> - brake or coast at zero output
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetSensorDirection
+        // Description: Reverses the encoder if the Talon doesn't already have this direction
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetSensorDirection
+        (
+            bool            reverseSensor   // <I> - true = reverse the encoder
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetStatusFrameRateMs
+        // Description: Changes how often the Talon sends a status frame if it isn't
+        //              already sending it at this period
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetStatusFrameRateMs
+        (
+            StatusFrameRate frame,          // <I> - status frame to change
+            int             periodMs        // <I> - time between frames
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetStatusFrameProfile
+        // Description: Sets the status frame periods of a profile (frames the profile
+        //              leaves at 0 aren't changed)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetStatusFrameProfile
+        (
+            const TalonStatusFrameProfile&  profile     // <I> - status frame periods
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetSensorPosition
+        // Description: Reads the position of the closed loop sensor (after the sensor
+        //              direction), the value the Talon's closed loop uses
+        // Returns:     int     encoder counts
+        //----------------------------------------------------------------------------------
+        int GetSensorPosition() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetSensorVelocity
+        // Description: Reads the velocity of the closed loop sensor (after the sensor
+        //              direction), the value the Talon's closed loop uses
+        // Returns:     int     encoder counts per 0.1 sec
+        //----------------------------------------------------------------------------------
+        int GetSensorVelocity() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetOutputVoltage
+        // Description: Reads the voltage applied to the motor, positive when the mechanism
+        //              moves forward (the Talon reports it before the motor is reversed)
+        // Returns:     double  volts
+        //----------------------------------------------------------------------------------
+        double GetOutputVoltage() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetEncoderSampleAge
+        // Description: Returns the expected age of a sensor reading: half the feedback
+        //              status frame period.  A reading is never older than the full period
+        //              (twice this) plus the CAN transmit time.
+        // Returns:     double  seconds
+        //----------------------------------------------------------------------------------
+        double GetEncoderSampleAge() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetKeepAlive
+        // Description: Changes how long an unchanged output can go without being resent
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetKeepAlive
+        (
+            double          seconds         // <I> - longest time between frames
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetSetsPassedOn
+        // Description: Returns how many Set() calls were passed on to the CANTalon since
+        //              the last dump
+        // Returns:     unsigned int    Set() calls passed on
+        //----------------------------------------------------------------------------------
+        unsigned int GetSetsPassedOn() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetSetsSkipped
+        // Description: Returns how many Set() calls were skipped since the last dump
+        // Returns:     unsigned int    Set() calls skipped
+        //----------------------------------------------------------------------------------
+        unsigned int GetSetsSkipped() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetConfigFramesSent
+        // Description: Returns how many config frames were sent since the last dump
+        // Returns:     unsigned int    config frames sent
+        //----------------------------------------------------------------------------------
+        unsigned int GetConfigFramesSent() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      DumpFrameCounts
+        // Description: Prints the Set() and config frame counts of every Talon to the
+        //              console and clears them
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        static void DumpFrameCounts();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~DragonTalon <<destructor>>
+        // Description: This will remove the Talon from the frame count report
+        //----------------------------------------------------------------------------------
+        virtual ~DragonTalon();
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      CountConfig
+        // Description: Counts a config call as sent or skipped
+        // Returns:     bool    the value of changed (true = send the config)
+        //----------------------------------------------------------------------------------
+        bool CountConfig
+        (
+            bool            changed         // <I> - true = the shadow doesn't match
+        );
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static const int            MAX_TALONS = 16;            // Talons in the report
+        static DragonTalon*         m_talons[MAX_TALONS];       // every Talon (nullptr = free slot)
+        static const int            MAX_STATUS_FRAMES = 5;      // StatusFrameRate values
+        static const int            DEFAULT_FEEDBACK_FRAME_MS = 20;     // Talon default period
+
+        const float                 OUTPUT_EPSILON = 0.001;     // smaller changes aren't passed on
+        const double                DEFAULT_KEEP_ALIVE = 0.1;   // seconds
+
+        const char*                 m_name;
+        double                      m_keepAlive;        // seconds between passing on the same value
+
+        // Last output passed on (only touched by Set())
+        bool                        m_sent;             // false = nothing passed on yet
+        float                       m_lastValue;
+        ControlMode                 m_lastMode;
+        double                      m_lastSendTime;     // FPGA time (seconds)
+
+        // Motor direction (only changed while the robot is being set up)
+        bool                        m_inverted;
+
+        // Shadow of the config last sent to the Talon (only touched by the config methods)
+        bool                        m_neutralModeKnown;         // false = never sent
+        NeutralMode                 m_neutralMode;
+        bool                        m_sensorDirectionKnown;     // false = never sent
+        bool                        m_sensorReversed;
+        bool                        m_outputDirectionKnown;     // false = never sent
+        bool                        m_outputReversed;
+        int                         m_statusFramePeriods[MAX_STATUS_FRAMES];   // ms (0 = never sent)
+
+        std::atomic<unsigned int>   m_setsPassedOn;
+        std::atomic<unsigned int>   m_setsSkipped;
+        std::atomic<unsigned int>   m_configFramesSent;
+        std::atomic<unsigned int>   m_configFramesSkipped;
+
+        // Default methods we don't want the compiler to implement for us
+        DragonTalon( const DragonTalon& ) = delete;
+        DragonTalon& operator= ( const DragonTalon& ) = delete;
+        explicit DragonTalon( DragonTalon* other ) = delete;
+};
+
+#endif /* SRC_DRAGONTALON_H_ */
@@ -0,0 +1,345 @@
+/*=============================================================================================
+ * DriveCharacterization.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This measures the drive feedforward constants (kS, kV and kA) by driving quasistatic and
+ * dynamic tests, logging the voltage and distance of each side and fitting the constants by
+ * least squares.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // fabs
+#include <cstdio>                   // printf
+#include <utility>                  // std::swap
+
+// WPILib includes
+#include <Preferences.h>            // Saves the constants
+#include <Timer.h>                  // FPGA timestamp
+
+// Team 302 includes
+#include <DriveCharacterization.h>  // This class
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+
+
+// Preferences keys
+static const char* const KS_KEY = "DriveKs";
+static const char* const KV_KEY = "DriveKv";
+static const char* const KA_KEY = "DriveKa";
+
+// Dashboard names of the tests (index is the CHARACTERIZATION_PHASE)
+static const char* const PHASE_NAMES[CHARACTERIZE_DONE + 1] = { "quasistatic forward", "quasistatic backward",
+                                                                "dynamic forward", "dynamic backward", "done" };
+
+//----------------------------------------------------------------------------------
+// Method:      DriveCharacterization <<constructor>>
+// Description: This will construct the object and allocate the sample buffer.
+//              Nothing moves until Start() is called.
+//----------------------------------------------------------------------------------
+DriveCharacterization::DriveCharacterization() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                                                 m_dashboard( DashboardPublisher::GetInstance() ),
+                                                 m_phaseChannel( m_dashboard->RegisterChannel( " characterize phase" ) ),
+                                                 m_samplesChannel( m_dashboard->RegisterChannel( " characterize samples" ) ),
+                                                 m_executor(),
+                                                 m_samples( new CharacterizationSample[MAX_SAMPLES] ),
+                                                 m_sampleCount( 0 ),
+                                                 m_phase( CHARACTERIZE_DONE ),
+                                                 m_phaseStart( 0.0 ),
+                                                 m_leftStart( 0.0 ),
+                                                 m_rightStart( 0.0 )
+{
+    m_executor.AddTask( "characterize", [this] { Run(); }, SAMPLE_RATE, 0 );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Throws away the samples and starts the tests from the beginning.
+//              The ControlLoop must not be running.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveCharacterization::Start()
+{
+    Stop();
+
+    m_sampleCount = 0;
+    m_chassis->SetBrakeMode();      // stop quickly during the rests
+    StartPhase( CHARACTERIZE_QUASISTATIC_FORWARD, Timer::GetFPGATimestamp() );
+    m_executor.Start();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stop
+// Description: Stops the tests (if they are running) and stops the drive motors.
+//              The samples are kept for Fit().
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveCharacterization::Stop()
+{
+    if ( m_executor.IsRunning() )
+    {
+        m_executor.Stop();
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsDone
+// Description: Checks whether all of the tests have finished
+// Returns:     bool    true  = done (or the sample buffer filled up)
+//----------------------------------------------------------------------------------
+bool DriveCharacterization::IsDone() const
+{
+    return ( m_phase == CHARACTERIZE_DONE );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Fit
+// Description: Fits the feedforward constants to the samples, saves them in the
+//              Preferences and prints them.  Only call this after Stop().
+// Returns:     bool    true  = constants found and saved
+//                      false = not enough moving samples (nothing is saved)
+//----------------------------------------------------------------------------------
+bool DriveCharacterization::Fit
+(
+    DriveFeedforward&   feedforward     // <O> - fitted constants
+)
+{
+    // Normal equations for voltage = kS * sign( v ) + kV * v + kA * a, with both sides
+    // of the drive as samples
+    double sums[3][4] = {};
+    int used = AddSide( true, sums ) + AddSide( false, sums );
+    if ( used < MIN_FIT_SAMPLES )
+    {
+        printf( "Drive characterization: only %d moving samples, nothing saved\n", used );
+        return false;
+    }
+
+    // Solve with Gaussian elimination (partial pivoting)
+    for ( int col=0; col<3; ++col )
+    {
+        int pivot = col;
+        for ( int row=col+1; row<3; ++row )
+        {
+            if ( fabs( sums[row][col] ) > fabs( sums[pivot][col] ) )
+            {
+                pivot = row;
+            }
+        }
+        if ( fabs( sums[pivot][col] ) < 1.0e-9 )
+        {
+            printf( "Drive characterization: the tests didn't separate the constants, nothing saved\n" );
+            return false;
+        }
+        for ( int inx=0; inx<4; ++inx )
+        {
+            std::swap( sums[col][inx], sums[pivot][inx] );
+        }
+        for ( int row=0; row<3; ++row )
+        {
+            if ( row != col )
+            {
+                double scale = sums[row][col] / sums[col][col];
+                for ( int inx=col; inx<4; ++inx )
+                {
+                    sums[row][inx] -= scale * sums[col][inx];
+                }
+            }
+        }
+    }
+    feedforward.kS = static_cast<float>( sums[0][3] / sums[0][0] );
+    feedforward.kV = static_cast<float>( sums[1][3] / sums[1][1] );
+    feedforward.kA = static_cast<float>( sums[2][3] / sums[2][2] );
+
+    Preferences* prefs = Preferences::GetInstance();
+    prefs->PutFloat( KS_KEY, feedforward.kS );
+    prefs->PutFloat( KV_KEY, feedforward.kV );
+    prefs->PutFloat( KA_KEY, feedforward.kA );
+    prefs->Save();
+
+    printf( "Drive characterization: kS %.3f V  kV %.3f V/(ft/s)  kA %.3f V/(ft/s^2)  (%d samples)\n",
+            feedforward.kS, feedforward.kV, feedforward.kA, used );
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Publish
+// Description: Sends the current test and the number of samples to the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveCharacterization::Publish()
+{
+    m_dashboard->PutString( m_phaseChannel, PHASE_NAMES[m_phase] );
+    m_dashboard->PutNumber( m_samplesChannel, m_sampleCount );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      LoadFeedforward
+// Description: Reads the constants saved by Fit()
+// Returns:     bool    true  = constants read
+//                      false = nothing usable saved (feedforward isn't changed)
+//----------------------------------------------------------------------------------
+bool DriveCharacterization::LoadFeedforward
+(
+    DriveFeedforward&   feedforward     // <O> - saved constants
+)
+{
+    Preferences* prefs = Preferences::GetInstance();
+    if ( !prefs->ContainsKey( KS_KEY ) || !prefs->ContainsKey( KV_KEY ) || !prefs->ContainsKey( KA_KEY ) )
+    {
+        return false;
+    }
+
+    // A bad fit (the robot was blocked or on blocks) can't be used by the drive models
+    DriveFeedforward saved;
+    saved.kS = prefs->GetFloat( KS_KEY, feedforward.kS );
+    saved.kV = prefs->GetFloat( KV_KEY, feedforward.kV );
+    saved.kA = prefs->GetFloat( KA_KEY, feedforward.kA );
+    bool valid = ( saved.kV > 0.0 && saved.kA > 0.0 );
+    if ( valid )
+    {
+        feedforward = saved;
+    }
+    return valid;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Test task; commands the output for the current test, logs a sample
+//              and moves on to the next test when this one is over
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveCharacterization::Run()
+{
+    CHARACTERIZATION_PHASE phase = static_cast<CHARACTERIZATION_PHASE>( m_phase.load() );
+    if ( phase == CHARACTERIZE_DONE )
+    {
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+        return;
+    }
+
+    double now          = Timer::GetFPGATimestamp();
+    float  leftDistance  = m_chassis->GetLeftSideDistance();
+    float  rightDistance = m_chassis->GetRightSideDistance();
+
+    // Rest until the robot has stopped, then note where the test starts
+    double testTime = now - m_phaseStart - REST_TIME;
+    if ( testTime < 0.0 )
+    {
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+        m_leftStart  = leftDistance;
+        m_rightStart = rightDistance;
+        return;
+    }
+
+    // Next test once this one has gone far enough (or long enough)
+    float driven = ( fabs( leftDistance - m_leftStart ) + fabs( rightDistance - m_rightStart ) ) / 2.0;
+    int   count  = m_sampleCount;
+    if ( driven >= MAX_DISTANCE || testTime >= PHASE_TIMEOUT || count >= MAX_SAMPLES )
+    {
+        CHARACTERIZATION_PHASE next = ( count >= MAX_SAMPLES ) ? CHARACTERIZE_DONE :
+                                      static_cast<CHARACTERIZATION_PHASE>( phase + 1 );
+        m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+        StartPhase( next, now );
+        return;
+    }
+
+    bool  quasistatic = ( phase == CHARACTERIZE_QUASISTATIC_FORWARD || phase == CHARACTERIZE_QUASISTATIC_BACKWARD );
+    bool  forward     = ( phase == CHARACTERIZE_QUASISTATIC_FORWARD || phase == CHARACTERIZE_DYNAMIC_FORWARD );
+    float output      = quasistatic ? QUASISTATIC_RAMP * static_cast<float>( testTime ) : DYNAMIC_OUTPUT;
+    output = forward ? output : -output;
+    m_chassis->SetMotorSpeeds( output, output );
+
+    // The voltage read now is the one applied since the last sample
+    CharacterizationSample& sample = m_samples[count];
+    sample.timestamp     = now;
+    sample.phase         = phase;
+    sample.leftVoltage   = m_chassis->GetLeftSideVoltage();
+    sample.rightVoltage  = m_chassis->GetRightSideVoltage();
+    sample.leftDistance  = leftDistance;
+    sample.rightDistance = rightDistance;
+    m_sampleCount = count + 1;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      StartPhase
+// Description: Moves on to a test; it starts after the rest
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveCharacterization::StartPhase
+(
+    CHARACTERIZATION_PHASE  phase,      // <I> - next test
+    double                  now         // <I> - FPGA time (seconds)
+)
+{
+    m_phaseStart = now;
+    m_phase      = phase;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddSide
+// Description: Adds one side's samples to the least squares sums
+// Returns:     int     samples used
+//----------------------------------------------------------------------------------
+int DriveCharacterization::AddSide
+(
+    bool                    left,           // <I> - true = left side, false = right side
+    double                  sums[3][4]      // <IO> - normal equations [X'X | X'y]
+) const
+{
+    int count = m_sampleCount;
+    int used  = 0;
+    int w     = DIFFERENCE_WINDOW;
+
+    // The velocity at a sample needs w samples on each side, and the acceleration needs
+    // the velocity w samples on each side, all from the same test
+    for ( int inx=2*w; inx<count-2*w; ++inx )
+    {
+        const CharacterizationSample& sample = m_samples[inx];
+        if ( m_samples[inx-2*w].phase != sample.phase || m_samples[inx+2*w].phase != sample.phase )
+        {
+            continue;
+        }
+
+        double velocity[3];         // at inx - w, inx and inx + w
+        for ( int step=0; step<3; ++step )
+        {
+            const CharacterizationSample& before = m_samples[inx+(step-2)*w];
+            const CharacterizationSample& after  = m_samples[inx+step*w];
+            double distance = left ? after.leftDistance - before.leftDistance :
+                                     after.rightDistance - before.rightDistance;
+            velocity[step] = distance / ( after.timestamp - before.timestamp );
+        }
+        double acceleration = ( velocity[2] - velocity[0] ) /
+                              ( m_samples[inx+w].timestamp - m_samples[inx-w].timestamp );
+        if ( fabs( velocity[1] ) < MIN_VELOCITY )
+        {
+            continue;
+        }
+
+        double x[3] = { ( velocity[1] > 0.0 ) ? 1.0 : -1.0, velocity[1], acceleration };
+        double y    = left ? sample.leftVoltage : sample.rightVoltage;
+        for ( int row=0; row<3; ++row )
+        {
+            for ( int col=0; col<3; ++col )
+            {
+                sums[row][col] += x[row] * x[col];
+            }
+            sums[row][3] += x[row] * y;
+        }
+        used++;
+    }
+    return used;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~DriveCharacterization <<destructor>>
+// Description: This will stop the tests and free the sample buffer
+//----------------------------------------------------------------------------------
+DriveCharacterization::~DriveCharacterization()
+{
+    Stop();
+
+    delete[] m_samples;
+    m_samples = nullptr;
+}
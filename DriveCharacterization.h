@@ -0,0 +1,197 @@
+/*=============================================================================================
+ * DriveCharacterization.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This measures the drive feedforward constants, so the drives don't have to guess what output
+ * gives what speed.  Each side of the drive follows
+ *
+ *      voltage = kS * sign( velocity ) + kV * velocity + kA * acceleration
+ *
+ * Start() drives the robot through four tests on its own fixed rate task:
+ *
+ *  - quasistatic forward and backward: the output ramps up slowly, so the acceleration is
+ *    about zero and the voltage is mostly kS + kV * velocity
+ *  - dynamic forward and backward: a step to a large output, so the acceleration is large
+ *    and kA shows up
+ *
+ * with a rest between tests to let the robot stop.  Each test ends when the robot has driven
+ * MAX_DISTANCE or after PHASE_TIMEOUT, so the robot needs about 10 feet of clear space in front
+ * of it.  The applied voltage and the encoder distance of each side are logged at SAMPLE_RATE
+ * into a buffer that is allocated up front.
+ *
+ * When IsDone(), Stop() and then Fit() finds kS, kV and kA by least squares (velocity and
+ * acceleration come from central differences of the distances) and saves them in the
+ * Preferences.  The chassis loads the saved constants with LoadFeedforward() when it is
+ * created; the robot hands freshly fitted ones to IChassis::SetFeedforward() so they are used
+ * without a reboot.
+ *=============================================================================================*/
+
+#ifndef SRC_DRIVECHARACTERIZATION_H_
+#define SRC_DRIVECHARACTERIZATION_H_
+
+// Standard includes
+#include <atomic>                   // std::atomic
+
+// Team 302 includes
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
+#include <IChassis.h>
+#include <TaskExecutor.h>           // Runs the tests at a fixed rate
+
+enum CHARACTERIZATION_PHASE
+{
+    CHARACTERIZE_QUASISTATIC_FORWARD,
+    CHARACTERIZE_QUASISTATIC_BACKWARD,
+    CHARACTERIZE_DYNAMIC_FORWARD,
+    CHARACTERIZE_DYNAMIC_BACKWARD,
+    CHARACTERIZE_DONE
+};
+
+class DriveCharacterization
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      DriveCharacterization <<constructor>>
+        // Description: This will construct the object and allocate the sample buffer.
+        //              Nothing moves until Start() is called.
+        //----------------------------------------------------------------------------------
+        DriveCharacterization();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Throws away the samples and starts the tests from the beginning.
+        //              The ControlLoop must not be running.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stop
+        // Description: Stops the tests (if they are running) and stops the drive motors.
+        //              The samples are kept for Fit().
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stop();
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsDone
+        // Description: Checks whether all of the tests have finished
+        // Returns:     bool    true  = done (or the sample buffer filled up)
+        //----------------------------------------------------------------------------------
+        bool IsDone() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Fit
+        // Description: Fits the feedforward constants to the samples, saves them in the
+        //              Preferences and prints them.  Only call this after Stop().
+        // Returns:     bool    true  = constants found and saved
+        //                      false = not enough moving samples (nothing is saved)
+        //----------------------------------------------------------------------------------
+        bool Fit
+        (
+            DriveFeedforward&   feedforward     // <O> - fitted constants
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Publish
+        // Description: Sends the current test and the number of samples to the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Publish();
+
+        //----------------------------------------------------------------------------------
+        // Method:      LoadFeedforward
+        // Description: Reads the constants saved by Fit()
+        // Returns:     bool    true  = constants read
+        //                      false = nothing usable saved (feedforward isn't changed)
+        //----------------------------------------------------------------------------------
+        static bool LoadFeedforward
+        (
+            DriveFeedforward&   feedforward     // <O> - saved constants
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~DriveCharacterization <<destructor>>
+        // Description: This will stop the tests and free the sample buffer
+        //----------------------------------------------------------------------------------
+        virtual ~DriveCharacterization();
+
+    private:
+        // One sample of both sides of the drive
+        struct CharacterizationSample
+        {
+            double                  timestamp;      // FPGA time (seconds)
+            CHARACTERIZATION_PHASE  phase;          // test the sample belongs to
+            float                   leftVoltage;    // volts applied (positive is forward)
+            float                   rightVoltage;
+            float                   leftDistance;   // feet
+            float                   rightDistance;
+        };
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Test task; commands the output for the current test, logs a sample
+        //              and moves on to the next test when this one is over
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Run();
+
+        //----------------------------------------------------------------------------------
+        // Method:      StartPhase
+        // Description: Moves on to a test; it starts after the rest
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void StartPhase
+        (
+            CHARACTERIZATION_PHASE  phase,      // <I> - next test
+            double                  now         // <I> - FPGA time (seconds)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      AddSide
+        // Description: Adds one side's samples to the least squares sums
+        // Returns:     int     samples used
+        //----------------------------------------------------------------------------------
+        int AddSide
+        (
+            bool                    left,           // <I> - true = left side, false = right side
+            double                  sums[3][4]      // <IO> - normal equations [X'X | X'y]
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        const double                SAMPLE_RATE = 200.0;        // Hz
+        static const int            MAX_SAMPLES = 10000;        // 50 seconds at SAMPLE_RATE
+        const double                REST_TIME = 2.0;            // seconds stopped before each test
+        const double                PHASE_TIMEOUT = 10.0;       // seconds
+        const float                 MAX_DISTANCE = 8.0;         // feet per test
+        const float                 QUASISTATIC_RAMP = 0.04;    // output per second (about 0.5 V/s)
+        const float                 DYNAMIC_OUTPUT = 0.5;       // output step
+        const int                   DIFFERENCE_WINDOW = 4;      // samples each side for the central differences
+        const float                 MIN_VELOCITY = 0.1;         // feet per second; slower samples aren't fit
+        const int                   MIN_FIT_SAMPLES = 100;
+
+        IChassis*                   m_chassis;
+        DashboardPublisher*         m_dashboard;
+        const DASHBOARD_CHANNEL     m_phaseChannel;
+        const DASHBOARD_CHANNEL     m_samplesChannel;
+
+        TaskExecutor                m_executor;
+
+        // Test task only (read by Fit() once the task is stopped)
+        CharacterizationSample*     m_samples;
+        std::atomic<int>            m_sampleCount;
+        std::atomic<int>            m_phase;            // CHARACTERIZATION_PHASE
+        double                      m_phaseStart;       // FPGA time the rest before the test started
+        float                       m_leftStart;        // distances when the test started (feet)
+        float                       m_rightStart;
+
+        // Default methods we don't want the compiler to implement for us
+        DriveCharacterization( const DriveCharacterization& ) = delete;
+        DriveCharacterization& operator= ( const DriveCharacterization& ) = delete;
+        explicit DriveCharacterization( DriveCharacterization* other ) = delete;
+};
+
+#endif /* SRC_DRIVECHARACTERIZATION_H_ */
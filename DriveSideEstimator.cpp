@@ -0,0 +1,247 @@
+/*=============================================================================================
+ * DriveSideEstimator.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This estimates the position, velocity and acceleration of one side of the drive with a
+ * Kalman filter fed by the time-stamped encoder position and the applied motor voltage.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // fabs
+
+// Team 302 includes
+#include <DriveSideEstimator.h>     // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      DriveSideEstimator <<constructor>>
+// Description: This will construct the filter.  It starts from the first
+//              Update().
+//----------------------------------------------------------------------------------
+DriveSideEstimator::DriveSideEstimator
+(
+    float       velocityPerVolt,    // <I> - steady feet per second for each volt applied
+    float       timeConstant        // <I> - seconds to reach 63% of the steady velocity
+) : m_velocityPerVolt( velocityPerVolt ),
+    m_timeConstant( timeConstant ),
+    m_started( false ),
+    m_time( 0.0 ),
+    m_lastPosition( 0.0 ),
+    m_lastReadingTime( 0.0 ),
+    m_x(),
+    m_p()
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetModel
+// Description: Changes the motor model (e.g. after a new characterization).  The
+//              estimate carries on from where it is.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveSideEstimator::SetModel
+(
+    float       velocityPerVolt,    // <I> - steady feet per second for each volt applied
+    float       timeConstant        // <I> - seconds to reach 63% of the steady velocity
+)
+{
+    m_velocityPerVolt = velocityPerVolt;
+    m_timeConstant    = timeConstant;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Update
+// Description: Moves the estimate up to the time of the sample and folds in the
+//              applied voltage and (when it changed) the encoder reading
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveSideEstimator::Update
+(
+    double      timestamp,          // <I> - FPGA time (seconds) of the sample
+    float       position,           // <I> - encoder distance (feet)
+    float       sampleAge,          // <I> - expected age (seconds) of the reading
+    float       voltage             // <I> - volts applied to the motors (positive is forward)
+)
+{
+    if ( !m_started )
+    {
+        // Start at the reading, not moving
+        m_started = true;
+        m_time    = timestamp;
+        m_x[0]    = position;
+        m_x[1]    = 0.0;
+        m_x[2]    = 0.0;
+        for ( int row=0; row<STATES; ++row )
+        {
+            for ( int col=0; col<STATES; ++col )
+            {
+                m_p[row][col] = 0.0;
+            }
+        }
+        m_p[0][0] = POSITION_NOISE * POSITION_NOISE;
+        m_p[1][1] = INITIAL_VELOCITY_NOISE * INITIAL_VELOCITY_NOISE;
+        m_p[2][2] = INITIAL_ACCEL_NOISE * INITIAL_ACCEL_NOISE;
+        m_lastPosition    = position;
+        m_lastReadingTime = timestamp;
+        return;
+    }
+
+    Predict( timestamp - m_time );
+    m_time = timestamp;
+
+    // The voltage says where the acceleration is heading:  velocity / tau + acceleration
+    // should equal voltage * velocityPerVolt / tau
+    const double voltageH[STATES] = { 0.0, 1.0 / m_timeConstant, 1.0 };
+    Correct( voltageH, voltage * m_velocityPerVolt / m_timeConstant, VOLTAGE_NOISE * VOLTAGE_NOISE );
+
+    // A reading that changed is new.  The age is half the frame period, so once twice
+    // the age has passed a new frame has come in even if the wheel didn't move.
+    bool newReading = ( position != m_lastPosition ) ||
+                      ( timestamp - m_lastReadingTime ) >= 2.0 * sampleAge;
+    if ( newReading )
+    {
+        m_lastPosition    = position;
+        m_lastReadingTime = timestamp;
+
+        // The reading is where the wheel was sampleAge seconds ago
+        double age = sampleAge;
+        const double positionH[STATES] = { 1.0, -age, 0.5 * age * age };
+        double expected = positionH[0] * m_x[0] + positionH[1] * m_x[1] + positionH[2] * m_x[2];
+        if ( fabs( position - expected ) > JUMP_LIMIT )
+        {
+            // The encoder was reset (or skipped); take its position and keep the motion
+            m_x[0] += position - expected;
+            for ( int inx=0; inx<STATES; ++inx )
+            {
+                m_p[0][inx] = 0.0;
+                m_p[inx][0] = 0.0;
+            }
+            m_p[0][0] = POSITION_NOISE * POSITION_NOISE;
+        }
+        else
+        {
+            Correct( positionH, position, POSITION_NOISE * POSITION_NOISE );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetState
+// Description: Returns the estimate as of the last Update()
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveSideEstimator::GetState
+(
+    DriveSideState&     state       // <O> - position, velocity and acceleration
+) const
+{
+    state.position     = static_cast<float>( m_x[0] );
+    state.velocity     = static_cast<float>( m_x[1] );
+    state.acceleration = static_cast<float>( m_x[2] );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Predict
+// Description: Moves the state forward with constant acceleration and grows the
+//              uncertainty by the random jerk
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveSideEstimator::Predict
+(
+    double      dt                  // <I> - seconds to move forward
+)
+{
+    if ( dt <= 0.0 )
+    {
+        return;
+    }
+
+    const double f[STATES][STATES] =
+    {
+        { 1.0, dt,  0.5 * dt * dt },
+        { 0.0, 1.0, dt            },
+        { 0.0, 0.0, 1.0           }
+    };
+
+    // x = F x
+    m_x[0] += m_x[1] * dt + 0.5 * m_x[2] * dt * dt;
+    m_x[1] += m_x[2] * dt;
+
+    // P = F P F' + Q
+    double fp[STATES][STATES];
+    for ( int row=0; row<STATES; ++row )
+    {
+        for ( int col=0; col<STATES; ++col )
+        {
+            fp[row][col] = 0.0;
+            for ( int inx=0; inx<STATES; ++inx )
+            {
+                fp[row][col] += f[row][inx] * m_p[inx][col];
+            }
+        }
+    }
+
+    double dt2 = dt * dt;
+    double dt3 = dt2 * dt;
+    const double q[STATES][STATES] =
+    {
+        { dt3 * dt2 / 20.0, dt2 * dt2 / 8.0, dt3 / 6.0 },
+        { dt2 * dt2 / 8.0,  dt3 / 3.0,       dt2 / 2.0 },
+        { dt3 / 6.0,        dt2 / 2.0,       dt        }
+    };
+    for ( int row=0; row<STATES; ++row )
+    {
+        for ( int col=0; col<STATES; ++col )
+        {
+            double sum = 0.0;
+            for ( int inx=0; inx<STATES; ++inx )
+            {
+                sum += fp[row][inx] * f[col][inx];
+            }
+            m_p[row][col] = sum + JERK_NOISE * q[row][col];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Correct
+// Description: Folds in a measurement that is a linear combination of the state
+//              (measurement = h[0] * position + h[1] * velocity + h[2] * acceleration)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void DriveSideEstimator::Correct
+(
+    const double    h[STATES],      // <I> - how the measurement depends on the state
+    double          measurement,    // <I> - measured value
+    double          variance        // <I> - measurement noise variance
+)
+{
+    // P h' and the innovation variance h P h' + R
+    double ph[STATES];
+    double innovationVariance = variance;
+    double expected           = 0.0;
+    for ( int row=0; row<STATES; ++row )
+    {
+        ph[row] = 0.0;
+        for ( int col=0; col<STATES; ++col )
+        {
+            ph[row] += m_p[row][col] * h[col];
+        }
+        innovationVariance += h[row] * ph[row];
+        expected           += h[row] * m_x[row];
+    }
+
+    // x += K ( z - h x ) and P -= K h P, with K = P h' / ( h P h' + R )
+    double innovation = measurement - expected;
+    for ( int row=0; row<STATES; ++row )
+    {
+        double gain = ph[row] / innovationVariance;
+        m_x[row] += gain * innovation;
+        for ( int col=0; col<STATES; ++col )
+        {
+            m_p[row][col] -= gain * ph[col];
+        }
+    }
+}
@@ -0,0 +1,149 @@
+/*=============================================================================================
+ * DriveSideEstimator.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This estimates the position, velocity and acceleration of one side of the drive with a
+ * Kalman filter.  The encoder velocity from the Talon is averaged over 100 ms and quantized, so
+ * instead the filter is fed the things that are fresh each sample:
+ *
+ *  - the encoder position, time-stamped with its expected age (half the status frame period).
+ *    The reading is from age seconds ago, so it is compared against the estimate moved back by
+ *    age (position - velocity * age + acceleration * age^2 / 2).  A reading is used when it
+ *    changes, or when a whole frame period has passed since the last one was used (a new frame
+ *    has come in even though the wheel hasn't moved).
+ *  - the voltage the motor controllers are applying.  A drive motor speeds up toward the
+ *    velocity for that voltage with a time constant tau:
+ *
+ *          acceleration = ( voltage * velocityPerVolt - velocity ) / tau
+ *
+ *    so each sample the voltage is used as a (loose) measurement of velocity / tau +
+ *    acceleration.  This is what lets the filter see a change in speed before the encoder
+ *    does.
+ *
+ * Between samples the state moves with constant acceleration plus a random jerk.  A position
+ * reading that is far from the estimate (e.g. right after ResetDistance()) moves the position
+ * straight to the reading instead of filtering it in.
+ *
+ * Update() should be called by the thread that samples the chassis, once per sample; GetState()
+ * returns the estimate from the last Update() without reading any hardware.
+ *=============================================================================================*/
+
+#ifndef SRC_DRIVESIDEESTIMATOR_H_
+#define SRC_DRIVESIDEESTIMATOR_H_
+
+// Team 302 includes
+#include <IChassis.h>               // DriveSideState
+
+class DriveSideEstimator
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      DriveSideEstimator <<constructor>>
+        // Description: This will construct the filter.  It starts from the first
+        //              Update().
+        //----------------------------------------------------------------------------------
+        DriveSideEstimator
+        (
+            float       velocityPerVolt,    // <I> - steady feet per second for each volt applied
+            float       timeConstant        // <I> - seconds to reach 63% of the steady velocity
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetModel
+        // Description: Changes the motor model (e.g. after a new characterization).  The
+        //              estimate carries on from where it is.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetModel
+        (
+            float       velocityPerVolt,    // <I> - steady feet per second for each volt applied
+            float       timeConstant        // <I> - seconds to reach 63% of the steady velocity
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Update
+        // Description: Moves the estimate up to the time of the sample and folds in the
+        //              applied voltage and (when it changed) the encoder reading
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Update
+        (
+            double      timestamp,          // <I> - FPGA time (seconds) of the sample
+            float       position,           // <I> - encoder distance (feet)
+            float       sampleAge,          // <I> - expected age (seconds) of the reading
+            float       voltage             // <I> - volts applied to the motors (positive is forward)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetState
+        // Description: Returns the estimate as of the last Update()
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void GetState
+        (
+            DriveSideState&     state       // <O> - position, velocity and acceleration
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~DriveSideEstimator <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~DriveSideEstimator() = default;
+
+    private:
+        static const int    STATES = 3;                     // position, velocity, acceleration
+
+        //----------------------------------------------------------------------------------
+        // Method:      Predict
+        // Description: Moves the state forward with constant acceleration and grows the
+        //              uncertainty by the random jerk
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Predict
+        (
+            double      dt                  // <I> - seconds to move forward
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Correct
+        // Description: Folds in a measurement that is a linear combination of the state
+        //              (measurement = h[0] * position + h[1] * velocity + h[2] * acceleration)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Correct
+        (
+            const double    h[STATES],      // <I> - how the measurement depends on the state
+            double          measurement,    // <I> - measured value
+            double          variance        // <I> - measurement noise variance
+        );
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        const double        JERK_NOISE = 2000.0;            // random jerk spectral density (ft^2/s^5)
+        const double        POSITION_NOISE = 0.002;         // feet (about two encoder counts)
+        const double        VOLTAGE_NOISE = 10.0;           // feet per second per second (the motor model is rough)
+        const double        JUMP_LIMIT = 1.0;               // feet; farther readings replace the position
+        const double        INITIAL_VELOCITY_NOISE = 1.0;   // feet per second
+        const double        INITIAL_ACCEL_NOISE = 10.0;     // feet per second per second
+
+        double              m_velocityPerVolt;
+        double              m_timeConstant;
+
+        bool                m_started;          // false = no Update() yet
+        double              m_time;             // FPGA time (seconds) of the estimate
+        float               m_lastPosition;     // last encoder reading
+        double              m_lastReadingTime;  // FPGA time (seconds) it was last used
+
+        double              m_x[STATES];            // position, velocity, acceleration
+        double              m_p[STATES][STATES];    // covariance
+
+        // Default methods we don't want the compiler to implement for us
+        DriveSideEstimator() = delete;
+        DriveSideEstimator( const DriveSideEstimator& ) = delete;
+        DriveSideEstimator& operator= ( const DriveSideEstimator& ) = delete;
+};
+
+#endif /* SRC_DRIVESIDEESTIMATOR_H_ */
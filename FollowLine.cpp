@@ -8,12 +8,13 @@
  *=============================================================================================*/
 
 #include <DigitalOutput.h>
-#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
-
 // Team 302 includes
 #include <FollowLine.h>            // This class
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
 #include <IChassis.h>               // Class the control the drive motors
 #include <IChassisFactory.h>        // Class constructs the correct chassis
+#include <InputSnapshot.h>          // Inputs sampled this cycle
+#include <LimitValue.h>              // Contains utility to force values within the valid range
 #include <LineTracker.h>
 #include <RobotMap.h>
 #include <Y1BotMap.h>
@@ -23,92 +24,122 @@
 // Description: This method creates and initializes the objects
 //--------------------------------------------------------------------
 FollowLine::FollowLine() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
-                           m_previousState( STOPPED )
+                           m_dashboard( DashboardPublisher::GetInstance() ),
+                           m_lineModeChannel( m_dashboard->RegisterChannel("Line Mode State ") ),
+                           m_linePositionChannel( m_dashboard->RegisterChannel("Line Position ") ),
+                           m_lineSteerChannel( m_dashboard->RegisterChannel("Line Steer ") ),
+                           m_previousState( STOPPED ),
+                           m_mode( DISCRETE_LINE_FOLLOW ),
+                           m_estimator(),
+                           m_lineIntegral( 0.0 ),
+                           m_previousPosition( 0.0 ),
+                           m_previousTime( 0.0 )
 
 {
-    m_chassis->SetBrakeMode();  // set to brake mode, so we don't continue moving
+    UpdateCalibration();
 }
 
+//--------------------------------------------------------------------
+// What to do for each line tracker state (index is the LINE_TRACK_STATE).
+// From left to right the sensors are:
+//      - W W W =  You are on the right path, drive straight
+//      - W B W =  Still on the path, drive straight
+//      - W W B =  There is a black on the right, turn left slightly
+//      - W B B =  There are 2 blacks on the right, turn left a lot
+//      - B W W =  There is a black on the left, turn right slightly
+//      - B B W =  There are 2 blacks on the left, turn right a lot
+//      - B W B =  Something messed up, back up
+//      - B B B =  Lost the line, stop
+//      - unknown (a sensor is between black and white) = stop
+//--------------------------------------------------------------------
+const FollowLine::LineAction FollowLine::LINE_ACTIONS[MAX_LINE_TRACK_STATES] =
+{
+    { "lost",           &FollowLine::Stop },                // LEFT_BLACK_CENTER_BLACK_RIGHT_BLACK
+    { "sharp right",    &FollowLine::DriveSharpRight },     // LEFT_BLACK_CENTER_BLACK_RIGHT_WHITE
+    { "back",           &FollowLine::BackUp },              // LEFT_BLACK_CENTER_WHITE_RIGHT_BLACK
+    { "slight right",   &FollowLine::DriveSlightRight },    // LEFT_BLACK_CENTER_WHITE_RIGHT_WHITE
+    { "sharp left",     &FollowLine::DriveSharpLeft },      // LEFT_WHITE_CENTER_BLACK_RIGHT_BLACK
+    { "straight2",      &FollowLine::DriveStraight },       // LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE
+    { "slight left",    &FollowLine::DriveSlightLeft },     // LEFT_WHITE_CENTER_WHITE_RIGHT_BLACK
+    { "straight",       &FollowLine::DriveStraight },       // LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE
+    { "lost",           &FollowLine::Stop }                 // UNKNOWN
+};
+
 //--------------------------------------------------------------------
 // Method:      Drive
 // Description: This method will follow a line.
 // Returns:     void
 //--------------------------------------------------------------------
-void FollowLine::Drive()
+void FollowLine::Drive
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
-    //      Check whether each line tracker is sensing black or white using
-    //        the IsBlack() and IsWhite() methods.
-    //
-    //        Set up the conditions such that if the sensors from left to right are:
-    //          - W W W =  You are on the right path, drive straight
-    //          - W W B =  There is a black on the right, turn left slightly
-    //          - W B B =  There are 2 blacks on the right, turn left a lot
-    //          - B W W =  There is a black on the left, turn right slightly
-    //          - B B W =  Tgere are 2 blacks on the left, turn right a lot
-    //          - B B B =  Something messed up, turn back. If it's still black then stop.
-    //          - N N N =  It's time to stop.
-
-
-
-    m_chassis->UpdateLineTrackerLights();
-    LINE_TRACK_STATE state = m_chassis->GetLineTrackerState();
+    m_chassis->SetBrakeMode();  // set to brake mode, so we don't continue moving (only sent when the mode changes)
 
-    if ( state == LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE )  //This is telling the robot to keep moving: Condition W W W
-    {
-        SmartDashboard::PutString("Line Mode State ", "straight" );
-        DriveStraight();
-
-    }
-    else if ( state ==  LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE )  //This is telling the robot to keep moving: Condition W W W
-    {
-        SmartDashboard::PutString("Line Mode State ", "straight2" );
-        DriveStraight();
-    }
-    else if ( state ==  LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE )  //This is telling the robot to keep moving: Condition W W W
-    {
-        SmartDashboard::PutString("Line Mode State ", "straight2" );
-        DriveStraight();
-    }
-    else if ( state == LEFT_BLACK_CENTER_WHITE_RIGHT_BLACK )  //This is telling the robot to redo what it did, otherwise known as going backward: Condition B B B
-    {
-        SmartDashboard::PutString("Line Mode State ", "back" );
-        m_previousState = DRIVE_STRAIGHT;
-        DriveStraightBack();
-    }
-    else if ( state == LEFT_WHITE_CENTER_WHITE_RIGHT_BLACK )  //This is telling the robot to move slightly to the left: Condition W W B
-    {
-        SmartDashboard::PutString("Line Mode State ", "slight left" );
-        DriveSlightLeft();
-    }
-    else if (state == LEFT_WHITE_CENTER_BLACK_RIGHT_BLACK )  //This is telling the robot to make a big turn to the left: Condition W B B
-    {
-        SmartDashboard::PutString("Line Mode State ", "sharp left" );
-        DriveSharpLeft();
-    }
-    else if (state == LEFT_BLACK_CENTER_WHITE_RIGHT_WHITE)  //This is telling the robot to move slightly to the right: Condition B W W
-    {
-        SmartDashboard::PutString("Line Mode State ", "slight right" );
-        DriveSlightRight();
-    }
-    else if (state == LEFT_BLACK_CENTER_BLACK_RIGHT_WHITE)  //This is telling the robot to make a big turn to the right: Condition B B W
+    if ( m_mode == CONTINUOUS_LINE_FOLLOW )
     {
-        SmartDashboard::PutString("Line Mode State ", "sharp right" );
-        DriveSharpRight();
+        DriveContinuous( inputs );
     }
-    else  // This is telling the robot to stop if none of the conditions above are met: Condition N N N
+    else
     {
-        SmartDashboard::PutString("Line Mode State ", "lost" );
-        Stop();
+        DriveDiscrete( inputs );
     }
-
-
-
 }
 
+//--------------------------------------------------------------------
+// Method:      SetMode
+// Description: This method picks how the line is followed.  Only
+//              call this while the line isn't being followed.
+// Returns:     void
+//--------------------------------------------------------------------
+void FollowLine::SetMode
+(
+    LINE_FOLLOW_MODE            mode        // <I> - how to follow the line
+)
+{
+    m_mode         = mode;
+    m_previousTime = 0.0;
+}
 
+//--------------------------------------------------------------------
+// Method:      UpdateCalibration
+// Description: This method picks up the line tracker levels from the
+//              chassis.  Only call this while the line isn't being
+//              followed.
+// Returns:     void
+//--------------------------------------------------------------------
+void FollowLine::UpdateCalibration()
+{
+    for ( int inx=0; inx<MAX_LINE_TRACKERS; ++inx )
+    {
+        LINE_TRACKER_IDENTIFIER tracker = static_cast<LINE_TRACKER_IDENTIFIER>( inx );
+        float white = 0.0;
+        float black = 0.0;
+        if ( m_chassis->GetLineTrackerLevels( tracker, white, black ) )
+        {
+            m_estimator.SetCalibration( tracker, white, black );
+        }
+    }
+}
 
+//--------------------------------------------------------------------
+// Method:      DriveDiscrete
+// Description: This method drives using the black/white state of
+//              each line tracker
+// Returns:     void
+//--------------------------------------------------------------------
+void FollowLine::DriveDiscrete
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    LINE_TRACK_STATE state = inputs.lineTrackState;
+    const LineAction& action = LINE_ACTIONS[ ( state < MAX_LINE_TRACK_STATES ) ? state : UNKNOWN ];
 
-
+    m_dashboard->PutString( m_lineModeChannel, action.mode );
+    ( this->*action.drive )();
+}
 
 //--------------------------------------------------------------------
 // Method:      DriveStraight
@@ -181,3 +212,64 @@ void FollowLine::DriveStraightBack()
 
 }
 
+//--------------------------------------------------------------------
+// Method:      BackUp
+// Description: This method will back up to find the line again
+// Returns:     void
+//--------------------------------------------------------------------
+void FollowLine::BackUp()
+{
+    m_previousState = DRIVE_STRAIGHT;
+    DriveStraightBack();
+}
+
+//--------------------------------------------------------------------
+// Method:      DriveContinuous
+// Description: This method steers with a PID on the estimated line
+//              position and sets the speed with a feedforward
+// Returns:     void
+//--------------------------------------------------------------------
+void FollowLine::DriveContinuous
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    float position = 0.0;
+    if ( !m_estimator.Estimate( inputs.lineTrackerVoltage, position ) )
+    {
+        m_dashboard->PutString( m_lineModeChannel, "lost" );
+        m_previousTime = 0.0;
+        Stop();
+    }
+    else
+    {
+        // Restart the PID on the first reading and after a gap (e.g. the line was lost)
+        double dt    = inputs.chassisTimestamp - m_previousTime;
+        bool restart = ( m_previousTime <= 0.0 || dt <= 0.0 || dt > MAX_LINE_DT );
+        if ( restart )
+        {
+            m_lineIntegral = 0.0;
+        }
+        else
+        {
+            m_lineIntegral = LimitValue::ForceInRange( m_lineIntegral + position * dt, -MAX_LINE_INTEGRAL, MAX_LINE_INTEGRAL );
+        }
+        float derivative = restart ? 0.0 : ( position - m_previousPosition ) / dt;
+        m_previousPosition = position;
+        m_previousTime     = inputs.chassisTimestamp;
+
+        // Positive position means the line is to the right, so speed up the left side
+        float steer = LINE_KP * position + LINE_KI * m_lineIntegral + LINE_KD * derivative;
+        steer = LimitValue::ForceInRange( steer, -MAX_STEER, MAX_STEER );
+
+        // Slow down in the corners
+        float error = ( position < 0.0 ) ? -position : position;
+        float speed = FOLLOW_SPEED * ( 1.0 - CORNER_SLOWDOWN * error );
+        float base  = SPEED_FEEDFORWARD * speed;
+
+        m_dashboard->PutString( m_lineModeChannel, "continuous" );
+        m_dashboard->PutNumber( m_linePositionChannel, position );
+        m_dashboard->PutNumber( m_lineSteerChannel, steer );
+        m_chassis->SetMotorSpeeds( base + steer, base - steer );
+    }
+}
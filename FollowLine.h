@@ -5,6 +5,13 @@
  * File Description:
  *
  * This class will follow a white line surrounded by black lines.
+ *
+ * There are two ways to follow the line:
+ *      DISCRETE_LINE_FOLLOW    each line tracker is black or white and each combination has
+ *                              a fixed set of motor speeds
+ *      CONTINUOUS_LINE_FOLLOW  the tracker voltages give a continuous line position (see
+ *                              LinePositionEstimator) and a PID on that position steers while
+ *                              a feedforward sets the forward speed
  *=============================================================================================*/
 
 #ifndef SRC_FOLLOWLINE_H_
@@ -15,6 +22,9 @@
 #include <IJoystickDrive.h>     // Interface being implemented
 #include <IChassis.h>           // Class that controls the motors on the drive chassis
 #include <DragonStick.h>        // Driver Game pad
+#include <InputSnapshot.h>      // Inputs sampled this cycle
+#include <DashboardPublisher.h> // Sends dashboard values from a background thread
+#include <LinePositionEstimator.h>  // Continuous line position from the tracker voltages
 
 enum LINE_TRACKER_STATES
 {
@@ -28,6 +38,12 @@ enum LINE_TRACKER_STATES
     STOPPED
 };
 
+enum LINE_FOLLOW_MODE
+{
+    DISCRETE_LINE_FOLLOW,
+    CONTINUOUS_LINE_FOLLOW
+};
+
 class FollowLine
 {
     public:
@@ -42,7 +58,30 @@ class FollowLine
         // Description: This method will follow a line.
         // Returns:     void
         //--------------------------------------------------------------------
-        void Drive();
+        void Drive
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      SetMode
+        // Description: This method picks how the line is followed.  Only
+        //              call this while the line isn't being followed.
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void SetMode
+        (
+            LINE_FOLLOW_MODE            mode        // <I> - how to follow the line
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      UpdateCalibration
+        // Description: This method picks up the line tracker levels from the
+        //              chassis.  Only call this while the line isn't being
+        //              followed.
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void UpdateCalibration();
 
         //--------------------------------------------------------------------
         // Method:      Stop
@@ -110,9 +149,49 @@ class FollowLine
 
 
     private:
+        //--------------------------------------------------------------------
+        // Method:      BackUp
+        // Description: This method will back up to find the line again
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void BackUp();
+
+        //--------------------------------------------------------------------
+        // Method:      DriveDiscrete
+        // Description: This method drives using the black/white state of
+        //              each line tracker
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void DriveDiscrete
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      DriveContinuous
+        // Description: This method steers with a PID on the estimated line
+        //              position and sets the speed with a feedforward
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void DriveContinuous
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        struct LineAction
+        {
+            const char*     mode;                   // shown on the dashboard
+            void            (FollowLine::*drive)(); // what to do
+        };
+        static const LineAction LINE_ACTIONS[MAX_LINE_TRACK_STATES];   // index is the LINE_TRACK_STATE
+
         // Attributes
 
         IChassis*               m_chassis;
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_lineModeChannel;
+        const DASHBOARD_CHANNEL m_linePositionChannel;
+        const DASHBOARD_CHANNEL m_lineSteerChannel;
 
 
                 const float STRAIGHT_DRIVE = 0.15;
@@ -133,9 +212,26 @@ class FollowLine
                 const float DRIVE_SHARP_RIGHT_RIGHT_MOTOR = -0.15;
                 const float DRIVE_SHARP_RIGHT_LEFT_MOTOR = 0.15;
 
+                // Continuous line following (position is in tracker spacings)
+                const float FOLLOW_SPEED = 2.0;             // feet per second on a straight line
+                const float SPEED_FEEDFORWARD = 0.075;      // motor output per foot per second
+                const float CORNER_SLOWDOWN = 0.5;          // fraction of the speed dropped with the line under an outside tracker
+                const float LINE_KP = 0.15;                 // motor output per tracker spacing
+                const float LINE_KI = 0.05;                 // motor output per tracker spacing second
+                const float LINE_KD = 0.01;                 // motor output per tracker spacing per second
+                const float MAX_LINE_INTEGRAL = 1.0;        // tracker spacing seconds
+                const float MAX_STEER = 0.25;               // motor output
+                const double MAX_LINE_DT = 0.05;            // seconds; longer gaps restart the PID
+
 
          LINE_TRACKER_STATES     m_previousState;
 
+        LINE_FOLLOW_MODE        m_mode;
+        LinePositionEstimator   m_estimator;
+        float                   m_lineIntegral;         // tracker spacing seconds
+        float                   m_previousPosition;     // tracker spacings
+        double                  m_previousTime;         // chassis timestamp of the last PID update (0.0 = restart)
+
         // Default methods we don't want the compiler to implement for us
         FollowLine( const FollowLine& ) = delete;
         FollowLine& operator= ( const FollowLine& ) = delete;
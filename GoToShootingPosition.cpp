@@ -22,10 +22,10 @@
 // Description: This method creates and initializes the objects
 //--------------------------------------------------------------------
 GoToShootingPosition::GoToShootingPosition() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                                               m_backUpProfile( new MotionProfileExecutor() ),
                                                m_state( DRIVE_TO_GOAL )
 
 {
-    m_chassis->SetBrakeMode();  // set to brake mode, so we don't continue moving
     ChangeState( READY_TO_START );
 }
 
@@ -37,10 +37,15 @@ GoToShootingPosition::GoToShootingPosition() : m_chassis( IChassisFactory::GetIn
 // Returns:     bool    -  true  = shooting position reached
 //                         false = still traversing to the shooting position
 //--------------------------------------------------------------------
-bool GoToShootingPosition::Drive()
+bool GoToShootingPosition::Drive
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
     bool isDone = false;
 
+    m_chassis->SetBrakeMode();  // set to brake mode, so we don't continue moving (only sent when the mode changes)
+
     // Check the current state (m_state) and call its method
     //        if it is DRIVE_TO_GOAL:
     //            call DriveToGoal
@@ -57,11 +62,11 @@ bool GoToShootingPosition::Drive()
     }
     else if (m_state == DRIVE_TO_GOAL)			// Approaching the Goal - Call DriveToGoal
 	{
-		DriveToGoal();
+		DriveToGoal( inputs );
 	}
 	else if (m_state == BACK_UP_TO_POSITION)	// Already reached the goal, so back up - Call BackToPosition
 	{
-		BackToPosition();
+		BackToPosition( inputs );
 	}
 	else										// Otherwise we are done, so stop
 	{
@@ -78,10 +83,13 @@ bool GoToShootingPosition::Drive()
 //              is tripped
 // Returns:     void
 //--------------------------------------------------------------------
-void GoToShootingPosition::DriveToGoal()
+void GoToShootingPosition::DriveToGoal
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
-	// Change states when the bumper is pressed
-	if ( m_chassis->IsBumperPressed() )
+	// Change states when the bumper is pressed (as sampled this cycle)
+	if ( inputs.bumperPressed )
 	{
 		ChangeState(BACK_UP_TO_POSITION);
 	}
@@ -92,21 +100,14 @@ void GoToShootingPosition::DriveToGoal()
 // Description: This method will drive backwards to the shooting position
 // Returns:     void
 //--------------------------------------------------------------------
-void GoToShootingPosition::BackToPosition()
+void GoToShootingPosition::BackToPosition
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
-    // TODO:
-    //       Get the average distance by averaging the outputs from
-    //       GetLeftSideDistance and GetRightSideDistance methods on m_chassis
-    //
-    //       compare the average distance travelled to the target distance (BACK_UP_DISTANCE)
-    //
-    //       when the distance travelled is the desired distance (allow for overshoot),
-    //       call ChangeState with STOP_AT_SHOOTING_POSITION
-
-	
-	float distance = ((m_chassis-> GetLeftSideDistance() + m_chassis-> GetRightSideDistance()) / 2.0);
-	
-	if (distance >= BACK_UP_DISTANCE )
+	// The motor controllers run the whole move; keep their buffers full until they reach the last point
+	m_backUpProfile->Stream( inputs.timestamp );
+	if ( m_backUpProfile->IsDone() )
 	{
 		ChangeState(STOP_AT_SHOOTING_POSITION);
 	}
@@ -132,10 +133,13 @@ void GoToShootingPosition::ChangeState
             break;
 
         case BACK_UP_TO_POSITION:
-            // set speed equal to BACKUP_SPEED
-            // call the ResetDistance method on m_chassis
-			speed = BACKUP_SPEED; 
-			m_chassis->ResetDistance(); // call for ResetDistance method in m_chassis
+            // back up with a motion profile (the motor controllers drive the move).  The
+            // profile starts from the current distances, so they aren't reset first: the
+            // reset reaches the motor controllers later and would move the profile's origin.
+			if ( !m_backUpProfile->Start( -BACK_UP_DISTANCE, BACKUP_MAX_VELOCITY, BACKUP_MAX_ACCELERATION ) )
+			{
+				newState = STOP_AT_SHOOTING_POSITION;	// couldn't plan the move, so don't move
+			}
             break;
 
         case STOP_AT_SHOOTING_POSITION:
@@ -155,7 +159,21 @@ void GoToShootingPosition::ChangeState
 
     }
     m_state = newState;
-    m_chassis->SetMotorSpeeds( speed, speed );
+    if ( m_state != BACK_UP_TO_POSITION )     // the profile drives the motors while backing up
+    {
+        m_backUpProfile->Stop();
+        m_chassis->SetMotorSpeeds( speed, speed );
+    }
+}
+
+//--------------------------------------------------------------------
+// Method:      ~GoToShootingPosition <<destructor>>
+// Description: This method is called to delete these objects
+//--------------------------------------------------------------------
+GoToShootingPosition::~GoToShootingPosition()
+{
+    delete m_backUpProfile;
+    m_backUpProfile = nullptr;
 }
 
 
@@ -17,6 +17,8 @@
 //  Team 302 includes
 #include <IJoystickDrive.h>     // Interface being implemented
 #include <IChassis.h>           // Class that controls the motors on the drive chassis
+#include <InputSnapshot.h>      // Inputs sampled this cycle
+#include <MotionProfileExecutor.h>  // Runs the back up move on the drive motor controllers
 
 enum POSITIONING_STATE
 {
@@ -43,13 +45,16 @@ class GoToShootingPosition
         // Returns:     bool    -  true  = shooting position reached
         //                         false = still traversing to the shooting position
         //--------------------------------------------------------------------
-        bool Drive();
+        bool Drive
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
 
         //--------------------------------------------------------------------
         // Method:      ~GoToShootingPosition <<destructor>>
         // Description: This method is called to delete these objects
         //--------------------------------------------------------------------
-        virtual ~GoToShootingPosition() = default; // destructor
+        virtual ~GoToShootingPosition(); // destructor
 
         //--------------------------------------------------------------------
         // Method:      ChangeState
@@ -69,26 +74,36 @@ class GoToShootingPosition
         //              is tripped
         // Returns:     void
         //--------------------------------------------------------------------
-        void DriveToGoal();
+        void DriveToGoal
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
 
         //--------------------------------------------------------------------
         // Method:      BackToPosition
         // Description: This method will drive backwards to the shooting position
         // Returns:     void
         //--------------------------------------------------------------------
-        void BackToPosition();
+        void BackToPosition
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
 
     private:
         // Attributes
         IChassis*           m_chassis;
 
+        MotionProfileExecutor*  m_backUpProfile;
+
         POSITIONING_STATE   m_state;
 
         const float         BACK_UP_DISTANCE = 2.0;     // distance in feet
 
         const float         APPROACH_SPEED = 0.5;       // speed when driving toward goal
 
-        const float         BACKUP_SPEED = -0.5;        // speed when robot backs up when goal is reached
+        const float         BACKUP_MAX_VELOCITY = 4.0;      // feet per second when backing up
+
+        const float         BACKUP_MAX_ACCELERATION = 8.0;  // feet per second per second when backing up
 
         const float         STOP_SPEED = 0.0;           // stop when desired distance from goal is reached
 
@@ -0,0 +1,78 @@
+/*=============================================================================================
+ * IAutonAction.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is the interface for the steps of an autonomous routine.  An action is started once,
+ * run once per cycle until it says it is done and then ended.  Actions can be put together in
+ * AutonSerialGroups (one after the other) and AutonParallelGroups (at the same time), which
+ * are actions themselves, so a whole routine is one action.
+ *
+ * Every method gets the inputs sampled this cycle; actions take the time from
+ * inputs.timestamp, so a routine does the same thing for the same inputs.
+ *=============================================================================================*/
+
+#ifndef SRC_IAUTONACTION_H_
+#define SRC_IAUTONACTION_H_
+
+// Team 302 includes
+#include <InputSnapshot.h>          // Inputs sampled this cycle
+
+class IAutonAction
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: This will get the action going.  It is called once, before the
+        //              first Run().
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        virtual void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: This will do the action's work for this cycle
+        // Returns:     bool    true  = the action is done (End() is called next)
+        //                      false = call Run() again next cycle
+        //----------------------------------------------------------------------------------
+        virtual bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: This will clean up after the action (e.g. stop its motors).  It is
+        //              called once, after Run() said it was done or when the action is cut
+        //              off (timed out, its group finished or the robot was disabled).
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        virtual void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the action (for the dashboard and console)
+        // Returns:     const char*     name of the action
+        //----------------------------------------------------------------------------------
+        virtual const char* GetName() const = 0;
+
+        virtual ~IAutonAction() = default;      // the routines are deleted through this interface
+
+    protected:
+        IAutonAction() = default;               // default constructor used by the implementors of this interface
+
+    private:
+        // Default methods we don't want the compiler to implement for us
+        IAutonAction( const IAutonAction& ) = delete;
+        IAutonAction& operator= ( const IAutonAction& ) = delete;
+        explicit IAutonAction( IAutonAction* other ) = delete;
+};
+
+#endif /* SRC_IAUTONACTION_H_ */
@@ -24,9 +24,128 @@ enum LINE_TRACK_STATE
     LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE,    // 101  x
     LEFT_WHITE_CENTER_WHITE_RIGHT_BLACK,    // 110  x
     LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE,    // 111  x
+    UNKNOWN,
+    MAX_LINE_TRACK_STATES
+};
+
+// The line trackers are packed into a mask with one bit per tracker that is set when the tracker
+// sees white (so the low three bits are the LINE_TRACK_STATE codes above) plus a bit that is set
+// when any tracker reads between the black and white ranges.
+const unsigned int LINE_MASK_RIGHT_WHITE    = 0x01;
+const unsigned int LINE_MASK_CENTER_WHITE   = 0x02;
+const unsigned int LINE_MASK_LEFT_WHITE     = 0x04;
+const unsigned int LINE_MASK_INDETERMINATE  = 0x08;
+const unsigned int LINE_MASK_SIZE           = 0x10;     // number of possible masks
+
+// State for each mask; any indeterminate reading is UNKNOWN
+constexpr LINE_TRACK_STATE LINE_TRACK_STATE_TABLE[LINE_MASK_SIZE] =
+{
+    LEFT_BLACK_CENTER_BLACK_RIGHT_BLACK,    // 0000
+    LEFT_BLACK_CENTER_BLACK_RIGHT_WHITE,    // 0001
+    LEFT_BLACK_CENTER_WHITE_RIGHT_BLACK,    // 0010
+    LEFT_BLACK_CENTER_WHITE_RIGHT_WHITE,    // 0011
+    LEFT_WHITE_CENTER_BLACK_RIGHT_BLACK,    // 0100
+    LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE,    // 0101
+    LEFT_WHITE_CENTER_WHITE_RIGHT_BLACK,    // 0110
+    LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE,    // 0111
+    UNKNOWN,                                // 1xxx
+    UNKNOWN,
+    UNKNOWN,
+    UNKNOWN,
+    UNKNOWN,
+    UNKNOWN,
+    UNKNOWN,
     UNKNOWN
 };
 
+//----------------------------------------------------------------------------------
+// Method:      DecodeLineTrackMask
+// Description: Looks up the state for a line tracker mask
+// Returns:     LINE_TRACK_STATE    state for the mask
+//----------------------------------------------------------------------------------
+inline constexpr LINE_TRACK_STATE DecodeLineTrackMask
+(
+    unsigned int    mask        // <I> - LINE_MASK_ bits
+)
+{
+    return LINE_TRACK_STATE_TABLE[ mask & ( LINE_MASK_SIZE - 1 ) ];
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsLineTrackTableValid
+// Description: Checks every mask from the one passed in to the end of the table.
+//              Used by the static_assert below, so every mask is checked whenever
+//              this compiles.
+// Returns:     bool    true  = the table matches the mask bits
+//----------------------------------------------------------------------------------
+inline constexpr bool IsLineTrackTableValid
+(
+    unsigned int    mask        // <I> - first mask to check
+)
+{
+    return ( mask >= LINE_MASK_SIZE ) ||
+           ( ( ( mask & LINE_MASK_INDETERMINATE ) != 0 ?
+               DecodeLineTrackMask( mask ) == UNKNOWN :
+               DecodeLineTrackMask( mask ) == static_cast<LINE_TRACK_STATE>( mask ) ) &&
+             IsLineTrackTableValid( mask + 1 ) );
+}
+
+static_assert( IsLineTrackTableValid( 0 ), "LINE_TRACK_STATE_TABLE doesn't match the LINE_MASK_ bits" );
+
+enum LINE_TRACKER_IDENTIFIER
+{
+    LEFT_TRACKER,
+    CENTER_TRACKER,
+    RIGHT_TRACKER,
+    MAX_LINE_TRACKERS
+};
+
+// One point of a drive motion profile.  The motor controllers servo each side to its position
+// (feeding forward its velocity) for durationMs and then move on to the next point, so a whole
+// move runs on the controllers without waiting on the robot program.
+struct DriveProfilePoint
+{
+    float       leftPosition;       // feet (same zero as GetLeftSideDistance())
+    float       leftVelocity;       // feet per second (positive is forward)
+    float       rightPosition;      // feet (same zero as GetRightSideDistance())
+    float       rightVelocity;      // feet per second (positive is forward)
+    int         durationMs;         // how long this point lasts
+    bool        isLastPoint;        // true = hold this point when the profile is done
+};
+
+// Motion profile buffers of the drive motor controllers (the worst of the motors)
+struct DriveProfileStatus
+{
+    int         topBufferRemaining; // points that can still be pushed
+    int         bottomBufferCount;  // points loaded into the motor controllers
+    bool        hasUnderrun;        // true = ran out of points while the output was enabled
+    bool        isLastPointActive;  // true = every motor has reached its last point
+};
+
+enum DRIVE_PROFILE_OUTPUT
+{
+    PROFILE_OUTPUT_DISABLE,         // motors are neutral (points can still be loaded)
+    PROFILE_OUTPUT_ENABLE,          // run the points
+    PROFILE_OUTPUT_HOLD             // servo to the current point
+};
+
+// Feedforward constants of one side of the drive (see DriveCharacterization):
+//      voltage = kS * sign( velocity ) + kV * velocity + kA * acceleration
+struct DriveFeedforward
+{
+    float       kS;                 // volts to get moving
+    float       kV;                 // volts per foot per second
+    float       kA;                 // volts per foot per second per second
+};
+
+// Filtered state of one side of the drive (see UpdateStateEstimates())
+struct DriveSideState
+{
+    float       position;           // feet (same zero as GetLeftSideDistance())
+    float       velocity;           // feet per second (positive is forward)
+    float       acceleration;       // feet per second per second
+};
+
 
 class IChassis
 {
@@ -45,6 +164,88 @@ public:
         const float rightSideSpeeds // <I> - Speed for the right side of the robot (range -1.0 to 1.0)
     ) const = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      SetVelocities
+    // Description: This will have the motor controllers hold the left and right side
+    //              velocities with their own closed loop (PIDF on the drive encoders).
+    //              Velocities outside of the range are limited to the range.  The next
+    //              call to SetMotorSpeeds() goes back to open loop.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void SetVelocities
+    (
+        const float leftSideVelocity,   // <I> - feet per second for the left side (positive is forward)
+        const float rightSideVelocity   // <I> - feet per second for the right side (positive is forward)
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetMaxVelocity
+    // Description: This will return the fastest a side can be told to go with
+    //              SetVelocities()
+    // Returns:     float   feet per second
+    //----------------------------------------------------------------------------------
+    virtual float GetMaxVelocity() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      StartProfile
+    // Description: This will throw away the points of any earlier motion profile and
+    //              put the drive motors in motion profile mode with the output disabled.
+    //              The next call to SetMotorSpeeds() or SetVelocities() leaves motion
+    //              profile mode.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void StartProfile() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      PushProfilePoint
+    // Description: This will add a point to the end of the motion profile (the top
+    //              buffer on the roboRIO).  Check topBufferRemaining first; a point is
+    //              only added when every drive motor has room for it.
+    // Returns:     bool        true  = point added
+    //                          false = buffer full
+    //----------------------------------------------------------------------------------
+    virtual bool PushProfilePoint
+    (
+        const DriveProfilePoint&    point   // <I> - next point of the profile
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      ProcessProfileBuffer
+    // Description: This will move points from the top buffer into the motor controllers.
+    //              Call this at least twice per point duration while a profile runs.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void ProcessProfileBuffer() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetProfileStatus
+    // Description: This will return the state of the motion profile buffers
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void GetProfileStatus
+    (
+        DriveProfileStatus&         status  // <O> - buffer state of the drive motors
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SetProfileOutput
+    // Description: This will start, hold or stop running the loaded motion profile
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void SetProfileOutput
+    (
+        DRIVE_PROFILE_OUTPUT        output  // <I> - what the motors should do
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      IsInProfile
+    // Description: This will check whether the drive motors are in motion profile mode
+    //              (StartProfile() was called and SetMotorSpeeds() or SetVelocities()
+    //              hasn't been called since), so a motion profile owns them
+    // Returns:     bool        true  = motion profile mode
+    //----------------------------------------------------------------------------------
+    virtual bool IsInProfile() const = 0;
+
     //----------------------------------------------------------------------------------
     // Method:      ResetDistance
     // Description: This will reset the distance, so calls to get the distance will
@@ -87,6 +288,104 @@ public:
     //----------------------------------------------------------------------------------
     virtual float GetRightSideVelocity() const = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideSampleAge
+    // Description: This will return the expected age of a left side encoder reading
+    //              (half the encoder status frame period; a reading is at most twice
+    //              this old)
+    // Returns:     float   seconds
+    //----------------------------------------------------------------------------------
+    virtual float GetLeftSideSampleAge() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideSampleAge
+    // Description: This will return the expected age of a right side encoder reading
+    //              (half the encoder status frame period; a reading is at most twice
+    //              this old)
+    // Returns:     float   seconds
+    //----------------------------------------------------------------------------------
+    virtual float GetRightSideSampleAge() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideVoltage
+    // Description: This will return the voltage applied to the left side motors
+    // Returns:     float   volts (positive is forward)
+    //----------------------------------------------------------------------------------
+    virtual float GetLeftSideVoltage() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideVoltage
+    // Description: This will return the voltage applied to the right side motors
+    // Returns:     float   volts (positive is forward)
+    //----------------------------------------------------------------------------------
+    virtual float GetRightSideVoltage() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetFeedforward
+    // Description: This will return the drive feedforward constants (the last saved
+    //              characterization, or the robot's nominal values)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void GetFeedforward
+    (
+        DriveFeedforward&   feedforward // <O> - drive constants
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SetFeedforward
+    // Description: This will start using new drive feedforward constants (e.g. a new
+    //              characterization): the Talon velocity gains, the state estimates'
+    //              motor model and what GetFeedforward() returns.  A path follower
+    //              picks them up the next time a path is set.  Only call this while
+    //              the control loop is stopped.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void SetFeedforward
+    (
+        const DriveFeedforward&     feedforward // <I> - drive constants
+    ) = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      UpdateStateEstimates
+    // Description: This will fold the latest encoder readings and applied motor voltages
+    //              into the left and right side state estimates.  Call it once per sample
+    //              of the chassis, from the thread that samples it.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void UpdateStateEstimates
+    (
+        double              timestamp   // <I> - FPGA time (seconds) of the sample
+    ) = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideState
+    // Description: This will return the left side estimate from the last
+    //              UpdateStateEstimates() (no hardware is read)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void GetLeftSideState
+    (
+        DriveSideState&     state       // <O> - position, velocity and acceleration
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideState
+    // Description: This will return the right side estimate from the last
+    //              UpdateStateEstimates() (no hardware is read)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void GetRightSideState
+    (
+        DriveSideState&     state       // <O> - position, velocity and acceleration
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetTrackWidth
+    // Description: This will return the distance between the left and right wheels
+    // Returns:     float   track width in feet
+    //----------------------------------------------------------------------------------
+    virtual float GetTrackWidth() const = 0;
+
 
     //----------------------------------------------------------------------------------
     // Method:      SetBrakeMode
@@ -112,6 +411,55 @@ public:
     //----------------------------------------------------------------------------------
     virtual bool IsBumperPressed() = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      CheckDriveEncoders
+    // Description: This will compare the drive encoders on the same side of the robot
+    //              (on chassis that have more than one).  Call it once per cycle; the
+    //              encoders are only compared every so often.  Once they disagree they
+    //              stay unhealthy until ResetDistance() is called.
+    // Returns:     bool        true  = encoders agree (or there is nothing to compare)
+    //                          false = encoders on a side disagree
+    //----------------------------------------------------------------------------------
+    virtual bool CheckDriveEncoders() = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SampleLineTrackers
+    // Description: This will read each of the line trackers once.  GetLineTrackerVoltage,
+    //              GetLineTrackerState and UpdateLineTrackerLights use these readings
+    //              until the next time this is called.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void SampleLineTrackers() = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerVoltage
+    // Description: This will return the voltage read by the last SampleLineTrackers()
+    // Returns:     float       voltage of the line tracker
+    //----------------------------------------------------------------------------------
+    virtual float GetLineTrackerVoltage
+    (
+        LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerRate
+    // Description: This will return how fast the line tracker voltage was changing at
+    //              the last SampleLineTrackers()
+    // Returns:     float       volts per second
+    //----------------------------------------------------------------------------------
+    virtual float GetLineTrackerRate
+    (
+        LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerMask
+    // Description: This will return the line trackers (from the last SampleLineTrackers())
+    //              packed into a mask of LINE_MASK_ bits
+    // Returns:     unsigned int    LINE_MASK_ bits
+    //----------------------------------------------------------------------------------
+    virtual unsigned int GetLineTrackerMask() = 0;
+
     //----------------------------------------------------------------------------------
     // Method:      GetLineTrackerState
     // Description: This will return the state of the line trackers
@@ -127,6 +475,37 @@ public:
     //----------------------------------------------------------------------------------
     virtual void UpdateLineTrackerLights() = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      StartLineTrackerCalibration
+    // Description: This will start learning the white and black levels of each line
+    //              tracker.  Sweep the robot over the line while sampling the trackers.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void StartLineTrackerCalibration() = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      FinishLineTrackerCalibration
+    // Description: This will stop learning the levels.  The levels of each tracker
+    //              that saw both white and black are changed and saved.
+    // Returns:     bool        true  = every tracker was calibrated
+    //                          false = at least one tracker kept its old levels
+    //----------------------------------------------------------------------------------
+    virtual bool FinishLineTrackerCalibration() = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerLevels
+    // Description: This will return the voltages a line tracker reads over white
+    //              and over black
+    // Returns:     bool        true  = levels returned
+    //                          false = no such line tracker
+    //----------------------------------------------------------------------------------
+    virtual bool GetLineTrackerLevels
+    (
+        LINE_TRACKER_IDENTIFIER tracker,        // <I> - line tracker to query
+        float&                  whiteLevel,     // <O> - voltage over the line
+        float&                  blackLevel      // <O> - voltage over black
+    ) const = 0;
+
 
     protected:
         IChassis() = default;           // default constructor used by the implementors of this interface
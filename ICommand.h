@@ -0,0 +1,96 @@
+/*=============================================================================================
+ * ICommand.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is the interface for the commands run by the CommandScheduler.  A command says which
+ * subsystems it drives; the scheduler only lets one command use a subsystem at a time and
+ * cuts off the command that has it when a new command needs it.  A command is started once,
+ * run each cycle until it says it is done (or is cut off) and then ended, like an
+ * IAutonAction.
+ *
+ * Commands are created once, when the robot starts, and scheduled over and over; nothing is
+ * allocated while they run.
+ *=============================================================================================*/
+
+#ifndef SRC_ICOMMAND_H_
+#define SRC_ICOMMAND_H_
+
+// Team 302 includes
+#include <InputSnapshot.h>          // Inputs sampled this cycle
+
+// Subsystems a command can require (or them together)
+enum COMMAND_SUBSYSTEM
+{
+    SUBSYSTEM_CHASSIS       = 0x01,     // drive motors
+    SUBSYSTEM_SHOOTER_WHEEL = 0x02,     // shooter wheel motor
+    SUBSYSTEM_LOADER        = 0x04,     // ball loader motor
+    SUBSYSTEM_ALIGNER       = 0x08,     // shooter alignment motor
+    SUBSYSTEM_SHOOTER       = SUBSYSTEM_SHOOTER_WHEEL | SUBSYSTEM_LOADER | SUBSYSTEM_ALIGNER
+};
+
+class ICommand
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetRequirements
+        // Description: This gets the subsystems the command drives
+        // Returns:     unsigned int    COMMAND_SUBSYSTEM values or'ed together
+        //----------------------------------------------------------------------------------
+        virtual unsigned int GetRequirements() const = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: This will get the command going.  It is called once when the
+        //              command is scheduled, before the first Run().
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        virtual void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: This will do the command's work for this cycle
+        // Returns:     bool    true  = the command is done (End() is called next)
+        //                      false = call Run() again next cycle
+        //----------------------------------------------------------------------------------
+        virtual bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: This will clean up after the command.  It is called once, after
+        //              Run() said it was done or when the command is cut off (cancelled
+        //              or another command needed one of its subsystems).
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        virtual void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) = 0;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the command (for the dashboard and console)
+        // Returns:     const char*     name of the command
+        //----------------------------------------------------------------------------------
+        virtual const char* GetName() const = 0;
+
+        virtual ~ICommand() = default;          // the commands are deleted through this interface
+
+    protected:
+        ICommand() = default;                   // default constructor used by the implementors of this interface
+
+    private:
+        // Default methods we don't want the compiler to implement for us
+        ICommand( const ICommand& ) = delete;
+        ICommand& operator= ( const ICommand& ) = delete;
+        explicit ICommand( ICommand* other ) = delete;
+};
+
+#endif /* SRC_ICOMMAND_H_ */
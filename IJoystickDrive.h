@@ -9,6 +9,9 @@
 #ifndef SRC_IJOYSTICKDRIVE_H_
 #define SRC_IJOYSTICKDRIVE_H_
 
+// Team 302 includes
+#include <InputSnapshot.h>      // Inputs the drive uses
+
 enum IJOYSTICK_DRIVE_IDENTIFIER
 {
     ARCADE_DRIVE,
@@ -26,7 +29,10 @@ class IJoystickDrive
         //              to drive the robot.
         // Returns:     void
         //--------------------------------------------------------------------
-        virtual void DriveWithJoysticks() const = 0;
+        virtual void DriveWithJoysticks
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const = 0;
 
         //--------------------------------------------------------------------
         // Method:      GetIdentifier
@@ -19,7 +19,7 @@ class IShooter
 public:
     //----------------------------------------------------------------------------------
     // Method:      SetShooterSpeed
-    // Description: This will set the motor speed for the shooter wheel.
+    // Description: This will set the motor speed for the shooter wheel (open loop).
     //              If a value is specified that is outside the range, the value
     //              used will be the closest bounding value (e.g. if 2.0 is passed in and
     //              the range is -1.0 to 1.0, 1.0 will be used.
@@ -30,6 +30,26 @@ public:
         const float speed   // <I> - Speed for the shooter wheel (range -1.0 to 1.0)
     ) const = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      SetShooterVelocity
+    // Description: This will have the motor controller hold the shooter wheel speed with
+    //              its own closed loop (PIDF on the wheel encoder).  Speeds outside of the
+    //              range are limited to the range.  The next call to SetShooterSpeed()
+    //              goes back to open loop.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    virtual void SetShooterVelocity
+    (
+        const float rpm     // <I> - Wheel speed (range -SHOOTER_WHEEL_MAX_RPM to SHOOTER_WHEEL_MAX_RPM)
+    ) const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetShooterVelocity
+    // Description: This will return the shooter wheel speed measured by its encoder
+    // Returns:     float       RPM (positive is shooting)
+    //----------------------------------------------------------------------------------
+    virtual float GetShooterVelocity() const = 0;
+
     //----------------------------------------------------------------------------------
     // Method:      SetBallLoadMotor
     // Description: This will run the loader motor.
@@ -48,6 +68,22 @@ public:
     //----------------------------------------------------------------------------------
     virtual bool IsLoaderInPosition() const = 0;
 
+    //----------------------------------------------------------------------------------
+    // Method:      GetLoaderReturns
+    // Description: This will return how many times the loader has come back to its load
+    //              position.  The sensor edge is caught by an interrupt, so a cycle is
+    //              counted even when the loader leaves and comes back between samples.
+    // Returns:     unsigned int    returns since the robot started (wraps around)
+    //----------------------------------------------------------------------------------
+    virtual unsigned int GetLoaderReturns() const = 0;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLoaderReturnTimestamp
+    // Description: This will return when the loader last came back to its load position.
+    // Returns:     double      FPGA time (seconds) of the sensor edge
+    //----------------------------------------------------------------------------------
+    virtual double GetLoaderReturnTimestamp() const = 0;
+
     //----------------------------------------------------------------------------------
     // Method:      AlignShooter
     // Description: This will set the motor speed for shooter alignment.
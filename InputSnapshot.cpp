@@ -0,0 +1,175 @@
+/*=============================================================================================
+ * InputSnapshot.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This samples all of the robot inputs (analog, digital, encoder and gamepad) once at the top
+ * of each cycle and holds them in a flat structure.  The subsystems read their inputs from the
+ * snapshot rather than going to the hardware, so each sensor is only read once per cycle and
+ * every subsystem sees the same values.
+ *=============================================================================================*/
+
+// WPILib includes
+#include <Timer.h>                  // FPGA timestamp
+
+// Team 302 includes
+#include <InputSnapshot.h>          // This class
+#include <IChassis.h>
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+#include <IShooter.h>
+#include <IShooterFactory.h>        // Class constructs the correct shooter
+#include <OperatorInterface.h>      // Controls creating singleton of the gamepads
+
+
+InputSnapshot* InputSnapshot::m_instance = nullptr; // initialize the instance variable to nullptr
+
+//----------------------------------------------------------------------------------
+// Method:      GetInstance
+// Description: If there isn't an instance of this class, it will create one.  The
+//              single class instance will be returned.
+// Returns:     InputSnapshot*  instance of this class
+//----------------------------------------------------------------------------------
+InputSnapshot* InputSnapshot::GetInstance()
+{
+    if ( InputSnapshot::m_instance == nullptr )
+    {
+        InputSnapshot::m_instance = new InputSnapshot();
+    }
+    return InputSnapshot::m_instance;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      InputSnapshot <<constructor>>
+// Description: This will construct and initialize the object
+//----------------------------------------------------------------------------------
+InputSnapshot::InputSnapshot() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                                 m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+                                 m_oi( OperatorInterface::GetInstance() ),
+                                 m_dashboard( DashboardPublisher::GetInstance() ),
+                                 m_encodersHealthyChannel( m_dashboard->RegisterChannel(" drive encoders healthy") ),
+                                 m_bumperChannel( m_dashboard->RegisterChannel(" bumper tripped ") ),
+                                 m_leftLineTrackerChannel( m_dashboard->RegisterChannel(" left line tracker") ),
+                                 m_centerLineTrackerChannel( m_dashboard->RegisterChannel(" center line tracker") ),
+                                 m_rightLineTrackerChannel( m_dashboard->RegisterChannel(" right line tracker") ),
+                                 m_inputs()
+{
+    m_inputs.lineTrackMask  = LINE_MASK_INDETERMINATE;
+    m_inputs.lineTrackState = UNKNOWN;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Sample
+// Description: Reads every input once and stores the values.  This should be the
+//              first thing done each cycle.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void InputSnapshot::Sample()
+{
+    SampleOperatorInputs();
+    SampleShooter( m_inputs );
+    SampleChassis( m_inputs );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SampleOperatorInputs
+// Description: Reads the gamepads once and stores the values.  The drive chassis
+//              and shooter values are left alone.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void InputSnapshot::SampleOperatorInputs()
+{
+    m_inputs.timestamp = Timer::GetFPGATimestamp();
+
+    // Gamepads
+    for ( int inx=0; inx<MAX_FUNCTIONS; ++inx )
+    {
+        FUNCTION_IDENTIFIER function = static_cast<FUNCTION_IDENTIFIER>( inx );
+        m_inputs.axis[inx]   = m_oi->GetRawAxis( function );
+        m_inputs.button[inx] = m_oi->GetRawButton( function );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SampleChassis
+// Description: Reads the drive chassis encoders and sensors once into the
+//              passed in structure.  Only one thread should sample the chassis.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void InputSnapshot::SampleChassis
+(
+    InputSnapshotData&  inputs      // <O> - chassis values are updated
+)
+{
+    // Drive chassis encoders and sensors
+    inputs.chassisTimestamp = Timer::GetFPGATimestamp();
+    inputs.leftDistance   = m_chassis->GetLeftSideDistance();
+    inputs.rightDistance  = m_chassis->GetRightSideDistance();
+    inputs.leftVelocity   = m_chassis->GetLeftSideVelocity();
+    inputs.rightVelocity  = m_chassis->GetRightSideVelocity();
+    inputs.leftSampleAge  = m_chassis->GetLeftSideSampleAge();
+    inputs.rightSampleAge = m_chassis->GetRightSideSampleAge();
+    m_chassis->UpdateStateEstimates( inputs.chassisTimestamp );
+    m_chassis->GetLeftSideState( inputs.leftState );
+    m_chassis->GetRightSideState( inputs.rightState );
+    inputs.bumperPressed  = m_chassis->IsBumperPressed();
+    inputs.driveEncodersHealthy = m_chassis->CheckDriveEncoders();
+
+    // Read each line tracker once; the state and the lights are derived from these readings
+    m_chassis->SampleLineTrackers();
+    for ( int inx=0; inx<MAX_LINE_TRACKERS; ++inx )
+    {
+        LINE_TRACKER_IDENTIFIER tracker = static_cast<LINE_TRACKER_IDENTIFIER>( inx );
+        inputs.lineTrackerVoltage[inx] = m_chassis->GetLineTrackerVoltage( tracker );
+        inputs.lineTrackerRate[inx]    = m_chassis->GetLineTrackerRate( tracker );
+    }
+    inputs.lineTrackMask  = m_chassis->GetLineTrackerMask();
+    inputs.lineTrackState = DecodeLineTrackMask( inputs.lineTrackMask );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SampleShooter
+// Description: Reads the shooter sensors once into the passed in structure.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void InputSnapshot::SampleShooter
+(
+    InputSnapshotData&  inputs      // <O> - shooter values are updated
+)
+{
+    inputs.shooterTimestamp      = Timer::GetFPGATimestamp();
+    inputs.shooterVelocity       = m_shooter->GetShooterVelocity();
+    inputs.loaderInPosition      = m_shooter->IsLoaderInPosition();
+    inputs.loaderReturns         = m_shooter->GetLoaderReturns();
+    inputs.loaderReturnTimestamp = m_shooter->GetLoaderReturnTimestamp();
+    inputs.shooterAtLeftBound    = m_shooter->IsShooterAtLeftBound();
+    inputs.shooterAtRightBound   = m_shooter->IsShooterAtRightBound();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Publish
+// Description: Sends the sensor values the drivers watch to the dashboard.  Call it
+//              at the dashboard rate, not every time the inputs are sampled.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void InputSnapshot::Publish
+(
+    const InputSnapshotData&    inputs  // <I> - values to send
+)
+{
+    // a slipping or unplugged drive encoder throws off the odometry and the autonomous moves
+    m_dashboard->PutBoolean( m_encodersHealthyChannel, inputs.driveEncodersHealthy );
+    m_dashboard->PutBoolean( m_bumperChannel, inputs.bumperPressed );
+    m_dashboard->PutNumber( m_leftLineTrackerChannel, inputs.lineTrackerVoltage[LEFT_TRACKER] );
+    m_dashboard->PutNumber( m_centerLineTrackerChannel, inputs.lineTrackerVoltage[CENTER_TRACKER] );
+    m_dashboard->PutNumber( m_rightLineTrackerChannel, inputs.lineTrackerVoltage[RIGHT_TRACKER] );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~InputSnapshot <<destructor>>
+// Description: This will clean up the object
+//----------------------------------------------------------------------------------
+InputSnapshot::~InputSnapshot()
+{
+    InputSnapshot::m_instance = nullptr;
+}
@@ -0,0 +1,163 @@
+/*=============================================================================================
+ * InputSnapshot.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This samples all of the robot inputs (analog, digital, encoder and gamepad) once at the top
+ * of each cycle and holds them in a flat structure.  The subsystems read their inputs from the
+ * snapshot rather than going to the hardware, so each sensor is only read once per cycle and
+ * every subsystem sees the same values.  It is a Singleton.
+ *
+ * When the drive and shooter run on the control loop thread (see ControlLoop), the main robot
+ * thread only samples the gamepads and the control loop samples the chassis and shooter sensors
+ * into its own copy.
+ *=============================================================================================*/
+
+#ifndef SRC_INPUTSNAPSHOT_H_
+#define SRC_INPUTSNAPSHOT_H_
+
+// Team 302 includes
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
+#include <IChassis.h>               // LINE_TRACK_STATE and LINE_TRACKER_IDENTIFIER
+#include <IShooter.h>
+#include <OperatorInterface.h>      // FUNCTION_IDENTIFIER
+
+struct InputSnapshotData
+{
+    double              timestamp;                              // FPGA time (seconds) when the inputs were sampled
+
+    // Drive chassis
+    double              chassisTimestamp;                       // FPGA time (seconds) when the chassis was sampled
+    float               leftDistance;                           // feet since the last ResetDistance()
+    float               rightDistance;                          // feet since the last ResetDistance()
+    float               leftVelocity;                           // feet per second
+    float               rightVelocity;                          // feet per second
+    float               leftSampleAge;                          // expected age (seconds) of the left encoder reading
+    float               rightSampleAge;                         // expected age (seconds) of the right encoder reading
+    DriveSideState      leftState;                              // filtered left side position, velocity and acceleration
+    DriveSideState      rightState;                             // filtered right side position, velocity and acceleration
+    bool                bumperPressed;                          // true = goal detection bumper is tripped
+    bool                driveEncodersHealthy;                   // false = drive encoders on a side disagree
+    float               lineTrackerVoltage[MAX_LINE_TRACKERS];  // filtered line tracker readings (volts)
+    float               lineTrackerRate[MAX_LINE_TRACKERS];     // line tracker rate of change (volts per second)
+    unsigned int        lineTrackMask;                          // line trackers as LINE_MASK_ bits
+    LINE_TRACK_STATE    lineTrackState;                         // decoded line tracker state
+
+    // Shooter
+    double              shooterTimestamp;                       // FPGA time (seconds) when the shooter was sampled
+    float               shooterVelocity;                        // shooter wheel RPM
+    bool                loaderInPosition;                       // true = loader is in load position
+    unsigned int        loaderReturns;                          // times the loader has come back to its load position
+    double              loaderReturnTimestamp;                  // FPGA time (seconds) the loader last came back
+    bool                shooterAtLeftBound;                     // true = shooter can't move farther left
+    bool                shooterAtRightBound;                    // true = shooter can't move farther right
+
+    // Operator Interface (index is the FUNCTION_IDENTIFIER)
+    float               axis[MAX_FUNCTIONS];                    // scaled axis values
+    bool                button[MAX_FUNCTIONS];                  // true = button is pressed
+};
+
+class InputSnapshot
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetInstance
+        // Description: If there isn't an instance of this class, it will create one.  The
+        //              single class instance will be returned.
+        // Returns:     InputSnapshot*  instance of this class
+        //----------------------------------------------------------------------------------
+        static InputSnapshot* GetInstance();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Sample
+        // Description: Reads every input once and stores the values.  This should be the
+        //              first thing done each cycle.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Sample();
+
+        //----------------------------------------------------------------------------------
+        // Method:      SampleOperatorInputs
+        // Description: Reads the gamepads once and stores the values.  The drive chassis
+        //              and shooter values are left alone.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SampleOperatorInputs();
+
+        //----------------------------------------------------------------------------------
+        // Method:      SampleChassis
+        // Description: Reads the drive chassis encoders and sensors once into the
+        //              passed in structure.  Only one thread should sample the chassis.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SampleChassis
+        (
+            InputSnapshotData&  inputs      // <O> - chassis values are updated
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SampleShooter
+        // Description: Reads the shooter sensors once into the passed in structure.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SampleShooter
+        (
+            InputSnapshotData&  inputs      // <O> - shooter values are updated
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Publish
+        // Description: Sends the sensor values the drivers watch to the dashboard.  Call it
+        //              at the dashboard rate, not every time the inputs are sampled.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Publish
+        (
+            const InputSnapshotData&    inputs  // <I> - values to send
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetInputs
+        // Description: Returns the inputs read by the last call to Sample().
+        // Returns:     const InputSnapshotData&    sampled inputs
+        //----------------------------------------------------------------------------------
+        inline const InputSnapshotData& GetInputs() const { return m_inputs; }
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      InputSnapshot <<constructor>>
+        // Description: This will construct and initialize the object
+        //----------------------------------------------------------------------------------
+        InputSnapshot();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~InputSnapshot <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~InputSnapshot();
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static InputSnapshot*   m_instance;     // Singleton instance of this class
+
+        IChassis*               m_chassis;
+        IShooter*               m_shooter;
+        OperatorInterface*      m_oi;
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_encodersHealthyChannel;
+        const DASHBOARD_CHANNEL m_bumperChannel;
+        const DASHBOARD_CHANNEL m_leftLineTrackerChannel;
+        const DASHBOARD_CHANNEL m_centerLineTrackerChannel;
+        const DASHBOARD_CHANNEL m_rightLineTrackerChannel;
+
+        InputSnapshotData       m_inputs;       // inputs from the last Sample()
+
+        // Default methods we don't want the compiler to implement for us
+        InputSnapshot( const InputSnapshot& ) = delete;
+        InputSnapshot& operator= ( const InputSnapshot& ) = delete;
+        explicit InputSnapshot( InputSnapshot* other ) = delete;
+};
+
+#endif /* SRC_INPUTSNAPSHOT_H_ */
@@ -0,0 +1,91 @@
+/*=============================================================================================
+ * LinePositionEstimator.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This turns the three line tracker voltages into a continuous estimate of where the white
+ * line is under the robot (weighted centroid of the calibrated readings).
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <LinePositionEstimator.h>  // This class
+#include <LimitValue.h>             // Contains utility to force values within the valid range
+
+
+const float LinePositionEstimator::TRACKER_POSITIONS[MAX_LINE_TRACKERS] =
+{
+    -1.0,       // LEFT_TRACKER
+     0.0,       // CENTER_TRACKER
+     1.0        // RIGHT_TRACKER
+};
+
+//--------------------------------------------------------------------
+// Method:      LinePositionEstimator <<constructor>>
+// Description: This method creates and initializes the object with
+//              the default calibration
+//--------------------------------------------------------------------
+LinePositionEstimator::LinePositionEstimator() : m_whiteVoltage(),
+                                                 m_blackVoltage()
+{
+    for ( int inx=0; inx<MAX_LINE_TRACKERS; ++inx )
+    {
+        m_whiteVoltage[inx] = DEFAULT_WHITE_VOLTAGE;
+        m_blackVoltage[inx] = DEFAULT_BLACK_VOLTAGE;
+    }
+}
+
+//--------------------------------------------------------------------
+// Method:      SetCalibration
+// Description: This method sets the voltages a tracker reads over
+//              black and over white
+// Returns:     void
+//--------------------------------------------------------------------
+void LinePositionEstimator::SetCalibration
+(
+    LINE_TRACKER_IDENTIFIER tracker,        // <I> - tracker being calibrated
+    float                   whiteVoltage,   // <I> - reading over the white line
+    float                   blackVoltage    // <I> - reading over black
+)
+{
+    // Ignore calibrations that can't tell black from white
+    if ( tracker >= LEFT_TRACKER && tracker < MAX_LINE_TRACKERS &&
+         ( blackVoltage - whiteVoltage ) >= MIN_CALIBRATION_SPAN )
+    {
+        m_whiteVoltage[tracker] = whiteVoltage;
+        m_blackVoltage[tracker] = blackVoltage;
+    }
+}
+
+//--------------------------------------------------------------------
+// Method:      Estimate
+// Description: This method finds the line position from the tracker
+//              voltages
+// Returns:     bool    true  = line found
+//                      false = line lost (position is not changed)
+//--------------------------------------------------------------------
+bool LinePositionEstimator::Estimate
+(
+    const float             voltages[MAX_LINE_TRACKERS],    // <I> - tracker readings (index is the LINE_TRACKER_IDENTIFIER)
+    float&                  position                        // <O> - line position (tracker spacings, positive = right)
+) const
+{
+    float total    = 0.0;
+    float weighted = 0.0;
+    for ( int inx=0; inx<MAX_LINE_TRACKERS; ++inx )
+    {
+        // 0.0 = black, 1.0 = white
+        float whiteness = ( m_blackVoltage[inx] - voltages[inx] ) / ( m_blackVoltage[inx] - m_whiteVoltage[inx] );
+        whiteness = LimitValue::ForceInRange( whiteness, 0.0, 1.0 );
+
+        total    += whiteness;
+        weighted += whiteness * TRACKER_POSITIONS[inx];
+    }
+
+    bool found = ( total >= MIN_TOTAL_WHITENESS );
+    if ( found )
+    {
+        position = weighted / total;
+    }
+    return found;
+}
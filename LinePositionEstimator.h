@@ -0,0 +1,84 @@
+/*=============================================================================================
+ * LinePositionEstimator.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This turns the three line tracker voltages into a continuous estimate of where the white
+ * line is under the robot.  Each voltage is scaled to how white the tracker sees (0.0 = black,
+ * 1.0 = white) using that tracker's calibrated black and white voltages, and the position is
+ * the weighted centroid of the tracker positions:
+ *
+ *      position = sum( whiteness[i] * x[i] ) / sum( whiteness[i] )
+ *
+ * where x is -1.0 for the left tracker, 0.0 for the center and 1.0 for the right.  So the
+ * position is in tracker spacings: 0.0 is centered and positive values mean the line is to the
+ * right of center.  If the trackers don't see enough white the line is lost.
+ *=============================================================================================*/
+
+#ifndef SRC_LINEPOSITIONESTIMATOR_H_
+#define SRC_LINEPOSITIONESTIMATOR_H_
+
+// Team 302 includes
+#include <IChassis.h>           // LINE_TRACKER_IDENTIFIER
+
+class LinePositionEstimator
+{
+    public:
+        //--------------------------------------------------------------------
+        // Method:      LinePositionEstimator <<constructor>>
+        // Description: This method creates and initializes the object with
+        //              the default calibration
+        //--------------------------------------------------------------------
+        LinePositionEstimator();
+
+        //--------------------------------------------------------------------
+        // Method:      SetCalibration
+        // Description: This method sets the voltages a tracker reads over
+        //              black and over white
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void SetCalibration
+        (
+            LINE_TRACKER_IDENTIFIER tracker,        // <I> - tracker being calibrated
+            float                   whiteVoltage,   // <I> - reading over the white line
+            float                   blackVoltage    // <I> - reading over black
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      Estimate
+        // Description: This method finds the line position from the tracker
+        //              voltages
+        // Returns:     bool    true  = line found
+        //                      false = line lost (position is not changed)
+        //--------------------------------------------------------------------
+        bool Estimate
+        (
+            const float             voltages[MAX_LINE_TRACKERS],    // <I> - tracker readings (index is the LINE_TRACKER_IDENTIFIER)
+            float&                  position                        // <O> - line position (tracker spacings, positive = right)
+        ) const;
+
+        //--------------------------------------------------------------------
+        // Method:      ~LinePositionEstimator <<destructor>>
+        // Description: This method is called to delete these objects
+        //--------------------------------------------------------------------
+        virtual ~LinePositionEstimator() = default;
+
+    private:
+        const float     DEFAULT_WHITE_VOLTAGE = 1.4;
+        const float     DEFAULT_BLACK_VOLTAGE = 3.6;
+        const float     MIN_CALIBRATION_SPAN  = 0.2;    // volts between black and white
+        const float     MIN_TOTAL_WHITENESS   = 0.3;    // less than this and the line is lost
+
+        static const float  TRACKER_POSITIONS[MAX_LINE_TRACKERS];
+
+        float           m_whiteVoltage[MAX_LINE_TRACKERS];
+        float           m_blackVoltage[MAX_LINE_TRACKERS];
+
+        // Default methods we don't want the compiler to implement for us
+        LinePositionEstimator( const LinePositionEstimator& ) = delete;
+        LinePositionEstimator& operator= ( const LinePositionEstimator& ) = delete;
+        explicit LinePositionEstimator( LinePositionEstimator* other ) = delete;
+};
+
+#endif /* SRC_LINEPOSITIONESTIMATOR_H_ */
@@ -5,65 +5,231 @@
  * File Description:
  *
  * This class wraps an analog input line tracker simpifying the input to have methods to
- * return whether the line tracker sees white or black.
+ * return whether the line tracker sees white or black.  The color is a Schmitt trigger around
+ * calibrated white and black levels.
  *=============================================================================================*/
 
 
+// C++ includes
+#include <limits>               // std::numeric_limits
+#include <string>               // Preferences keys
+
 // WPILIB includes
 #include <AnalogInput.h>        // parent class
-#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
+#include <Preferences.h>        // Saves the calibration
+#include <Timer.h>              // FPGA timestamp
 
 // Team 302 includes
 #include <LineTracker.h>            // This class
 
 //--------------------------------------------------------------------
 // Method:      LineTracker <<constructor>>
-// Description: This method creates and initializes the objects
+// Description: This method creates and initializes the objects.  The
+//              levels come from the Preferences if they were saved.
 //--------------------------------------------------------------------
 LineTracker::LineTracker
 (
     uint32_t        channel     // <I> - analog input channel
-) : AnalogInput( channel )      // initialize the parent class
+) : AnalogInput( channel ),     // initialize the parent class
+    m_voltage( 0.0 ),
+    m_sampleTime( 0.0 ),
+    m_voltageRate( 0.0 ),
+    m_accumulating( false ),
+    m_lastAccumulatorValue( 0 ),
+    m_lastAccumulatorCount( 0 ),
+    m_color( LINE_TRACKER_INDETERMINATE ),
+    m_whiteLevel( 0.0 ),
+    m_blackLevel( 0.0 ),
+    m_toWhite( 0.0 ),
+    m_toBlack( 0.0 ),
+    m_calibrating( false ),
+    m_sweepLow( 0.0 ),
+    m_sweepHigh( 0.0 ),
+    m_whiteKey( "LineTracker " + std::to_string( channel ) + " white" ),
+    m_blackKey( "LineTracker " + std::to_string( channel ) + " black" )
+{
+    // Let the FPGA do the filtering
+    SetOversampleBits( OVERSAMPLE_BITS );
+    SetAverageBits( AVERAGE_BITS );
+    m_accumulating = IsAccumulatorChannel();
+    if ( m_accumulating )
+    {
+        InitAccumulator();
+        GetAccumulatorOutput( m_lastAccumulatorValue, m_lastAccumulatorCount );
+    }
+
+    Preferences* prefs = Preferences::GetInstance();
+    SetLevels( prefs->GetFloat( m_whiteKey, DEFAULT_WHITE_LEVEL ),
+               prefs->GetFloat( m_blackKey, DEFAULT_BLACK_LEVEL ) );
+}
+
+//--------------------------------------------------------------------
+// Method:      Sample
+// Description: This method reads the line tracker voltage and updates
+//              the color.  IsBlack, IsWhite and GetSampledVoltage use
+//              this reading until the next time it is called.
+// Returns:     void
+//--------------------------------------------------------------------
+void LineTracker::Sample()
+{
+    double now     = Timer::GetFPGATimestamp();
+    float  voltage = ReadFilteredVoltage();
+    double dt      = now - m_sampleTime;
+    m_voltageRate  = ( m_sampleTime > 0.0 && dt > 0.0 ) ? ( voltage - m_voltage ) / dt : 0.0;
+    m_voltage      = voltage;
+    m_sampleTime   = now;
+
+    // Inside the band the color stays what it was
+    if ( m_voltage <= m_toWhite )
+    {
+        m_color = LINE_TRACKER_WHITE;
+    }
+    else if ( m_voltage >= m_toBlack )
+    {
+        m_color = LINE_TRACKER_BLACK;
+    }
+
+    if ( m_calibrating )
+    {
+        m_sweepLow  = ( m_voltage < m_sweepLow )  ? m_voltage : m_sweepLow;
+        m_sweepHigh = ( m_voltage > m_sweepHigh ) ? m_voltage : m_sweepHigh;
+    }
+}
+
+//--------------------------------------------------------------------
+// Method:      StartCalibration
+// Description: This method starts recording the lowest and highest
+//              readings.  Sweep the tracker over the white line and
+//              the black field, then call FinishCalibration().
+// Returns:     void
+//--------------------------------------------------------------------
+void LineTracker::StartCalibration()
+{
+    // Start from nothing, not from the saved levels: the first sample sets both ends, so a
+    // tracker that only ever sees one color never spans MIN_LEVEL_SPAN and isn't saved
+    m_calibrating = true;
+    m_sweepLow    = std::numeric_limits<float>::max();
+    m_sweepHigh   = std::numeric_limits<float>::lowest();
+}
+
+//--------------------------------------------------------------------
+// Method:      FinishCalibration
+// Description: This method stops recording.  If the tracker saw both
+//              white and black, the readings become the new levels
+//              and are saved in the Preferences.
+// Returns:     bool        true  = new levels saved
+//                          false = sweep too small, levels not changed
+//--------------------------------------------------------------------
+bool LineTracker::FinishCalibration()
 {
+    bool saved = false;
+    if ( m_calibrating && ( m_sweepHigh - m_sweepLow ) >= MIN_LEVEL_SPAN )
+    {
+        SetLevels( m_sweepLow, m_sweepHigh );
+
+        Preferences* prefs = Preferences::GetInstance();
+        prefs->PutFloat( m_whiteKey, m_whiteLevel );
+        prefs->PutFloat( m_blackKey, m_blackLevel );
+        prefs->Save();
+        saved = true;
+    }
+    m_calibrating = false;
+    return saved;
 }
 
 //--------------------------------------------------------------------
 // Method:      IsBlack
 // Description: This method returns whether the line tracker sees black
-//              or not.
+//              or not (based on the last Sample()).
 // Returns:     bool        true  = sees black
 //                          false = doesn't see black
 //--------------------------------------------------------------------
 bool LineTracker::IsBlack() const
 {
-    bool seesBlack = false;
-    float voltage = GetVoltage();
-    SmartDashboard::PutNumber(" isBlack", voltage );
-
-    if ( voltage >= LOWER_BLACK_VALUE && voltage <= UPPER_BLACK_VALUE )
-    {
-        seesBlack = true;
-    }
-    return seesBlack;
+    return ( m_color == LINE_TRACKER_BLACK );
 }
 
 //--------------------------------------------------------------------
 // Method:      IsWhite
 // Description: This method returns whether the line tracker sees white
-//              or not.
+//              or not (based on the last Sample()).
 // Returns:     bool        true  = sees white
 //                          false = doesn't see white
 //--------------------------------------------------------------------
 bool LineTracker::IsWhite() const
 {
-    bool seesWhite = false;
-    float voltage = GetVoltage();
-    SmartDashboard::PutNumber(" isBlack", voltage );
-    if ( voltage >= LOWER_WHITE_VALUE && voltage <= UPPER_WHITE_VALUE )
+    return ( m_color == LINE_TRACKER_WHITE );
+}
+
+//--------------------------------------------------------------------
+// Method:      GetColor
+// Description: This method returns what the line tracker sees (based
+//              on the last Sample()).
+// Returns:     LINE_TRACKER_COLOR  black, white or indeterminate
+//--------------------------------------------------------------------
+LINE_TRACKER_COLOR LineTracker::GetColor() const
+{
+    return m_color;
+}
+
+//--------------------------------------------------------------------
+// Method:      SetLevels
+// Description: This method sets the white and black levels and the
+//              switching voltages around their midpoint
+// Returns:     void
+//--------------------------------------------------------------------
+void LineTracker::SetLevels
+(
+    float           whiteLevel, // <I> - voltage over the line
+    float           blackLevel  // <I> - voltage over black
+)
+{
+    // A bad saved calibration would leave the tracker stuck on one color
+    if ( ( blackLevel - whiteLevel ) < MIN_LEVEL_SPAN )
     {
-        seesWhite = true;
+        whiteLevel = DEFAULT_WHITE_LEVEL;
+        blackLevel = DEFAULT_BLACK_LEVEL;
     }
-    return seesWhite;
+
+    float midpoint  = ( whiteLevel + blackLevel ) / 2.0;
+    float halfBand  = HYSTERESIS * ( blackLevel - whiteLevel ) / 2.0;
+
+    m_whiteLevel    = whiteLevel;
+    m_blackLevel    = blackLevel;
+    m_toWhite       = midpoint - halfBand;
+    m_toBlack       = midpoint + halfBand;
 }
 
+//--------------------------------------------------------------------
+// Method:      ReadFilteredVoltage
+// Description: This method reads the filtered voltage; the mean of the
+//              accumulator since the last read when there is one,
+//              otherwise the FPGA average
+// Returns:     float       voltage
+//--------------------------------------------------------------------
+float LineTracker::ReadFilteredVoltage()
+{
+    float voltage = GetAverageVoltage();
+    if ( m_accumulating )
+    {
+        int64_t value = 0;
+        int64_t count = 0;
+        GetAccumulatorOutput( value, count );
 
+        // No new values since the last read, so the last reading still holds
+        int64_t newCount = count - m_lastAccumulatorCount;
+        if ( newCount > 0 )
+        {
+            // The accumulator adds the oversampled values; scale them the way GetAverageVoltage() does
+            double meanValue = static_cast<double>( value - m_lastAccumulatorValue ) / newCount;
+            voltage = meanValue * GetLSBWeight() * 1.0e-9 / ( 1 << GetOversampleBits() ) - GetOffset() * 1.0e-9;
+        }
+        else if ( m_sampleTime > 0.0 )
+        {
+            voltage = m_voltage;
+        }
+        m_lastAccumulatorValue = value;
+        m_lastAccumulatorCount = count;
+    }
+    return voltage;
+}
@@ -6,16 +6,37 @@
  *
  * This class wraps an analog input line tracker simpifying the input to have methods to
  * return whether the line tracker sees white or black.
+ *
+ * Each tracker has its own white and black levels.  They are learned by sweeping the robot
+ * back and forth over the line (StartCalibration/FinishCalibration) and saved in the robot
+ * Preferences, so they survive a reboot.  The color is a Schmitt trigger around the midpoint
+ * of the levels: the reading has to get past the far side of the hysteresis band before the
+ * color changes, so noise near the midpoint doesn't make the color chatter.
+ *
+ * The FPGA oversamples and averages the input, so each reading is already filtered.  On the
+ * channels that have an accumulator, the reading is the mean of every averaged value since the
+ * last Sample(), so nothing between two control loop passes is lost.  Each reading is
+ * timestamped and the rate of change between readings is kept.
  *=============================================================================================*/
 
 #ifndef SRC_LINETRACKER_H_
 #define SRC_LINETRACKER_H_
 
+// C++ includes
+#include <string>               // Preferences keys
+
 // WPILIB includes
 #include <AnalogInput.h>        // parent class
 
 //  Team 302 includes
 
+enum LINE_TRACKER_COLOR
+{
+    LINE_TRACKER_BLACK,
+    LINE_TRACKER_WHITE,
+    LINE_TRACKER_INDETERMINATE      // inside the hysteresis band since the first reading
+};
+
 class LineTracker : public AnalogInput
 {
     public:
@@ -28,10 +49,75 @@ class LineTracker : public AnalogInput
             uint32_t        channel     // <I> - analog input channel
         );      // constructor
 
+        //--------------------------------------------------------------------
+        // Method:      Sample
+        // Description: This method reads the line tracker voltage and updates
+        //              the color.  IsBlack, IsWhite and GetSampledVoltage use
+        //              this reading until the next time it is called.
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void Sample();
+
+        //--------------------------------------------------------------------
+        // Method:      StartCalibration
+        // Description: This method starts recording the lowest and highest
+        //              readings.  Sweep the tracker over the white line and
+        //              the black field, then call FinishCalibration().
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void StartCalibration();
+
+        //--------------------------------------------------------------------
+        // Method:      FinishCalibration
+        // Description: This method stops recording.  If the tracker saw both
+        //              white and black, the readings become the new levels
+        //              and are saved in the Preferences.
+        // Returns:     bool        true  = new levels saved
+        //                          false = sweep too small, levels not changed
+        //--------------------------------------------------------------------
+        bool FinishCalibration();
+
+        //--------------------------------------------------------------------
+        // Method:      GetWhiteLevel
+        // Description: This method returns the voltage read over the line
+        // Returns:     float       voltage
+        //--------------------------------------------------------------------
+        inline float GetWhiteLevel() const { return m_whiteLevel; }
+
+        //--------------------------------------------------------------------
+        // Method:      GetBlackLevel
+        // Description: This method returns the voltage read over black
+        // Returns:     float       voltage
+        //--------------------------------------------------------------------
+        inline float GetBlackLevel() const { return m_blackLevel; }
+
+        //--------------------------------------------------------------------
+        // Method:      GetSampledVoltage
+        // Description: This method returns the filtered voltage read by the
+        //              last Sample()
+        // Returns:     float       voltage
+        //--------------------------------------------------------------------
+        inline float GetSampledVoltage() const { return m_voltage; }
+
+        //--------------------------------------------------------------------
+        // Method:      GetSampleTime
+        // Description: This method returns when the last Sample() was taken
+        // Returns:     double      FPGA time (seconds)
+        //--------------------------------------------------------------------
+        inline double GetSampleTime() const { return m_sampleTime; }
+
+        //--------------------------------------------------------------------
+        // Method:      GetVoltageRate
+        // Description: This method returns how fast the voltage changed
+        //              between the last two Sample() calls
+        // Returns:     float       volts per second
+        //--------------------------------------------------------------------
+        inline float GetVoltageRate() const { return m_voltageRate; }
+
         //--------------------------------------------------------------------
         // Method:      IsBlack
         // Description: This method returns whether the line tracker sees black
-        //              or not.
+        //              or not (based on the last Sample()).
         // Returns:     bool        true  = sees black
         //                          false = doesn't see black
         //--------------------------------------------------------------------
@@ -40,12 +126,20 @@ class LineTracker : public AnalogInput
         //--------------------------------------------------------------------
         // Method:      IsWhite
         // Description: This method returns whether the line tracker sees white
-        //              or not.
+        //              or not (based on the last Sample()).
         // Returns:     bool        true  = sees white
         //                          false = doesn't see white
         //--------------------------------------------------------------------
         bool IsWhite() const;
 
+        //--------------------------------------------------------------------
+        // Method:      GetColor
+        // Description: This method returns what the line tracker sees (based
+        //              on the last Sample()).
+        // Returns:     LINE_TRACKER_COLOR  black, white or indeterminate
+        //--------------------------------------------------------------------
+        LINE_TRACKER_COLOR GetColor() const;
+
         //--------------------------------------------------------------------
         // Method:      ~LineTracker <<destructor>>
         // Description: This method is called to delete these objects
@@ -55,12 +149,57 @@ class LineTracker : public AnalogInput
     protected:
 
     private:
+        //--------------------------------------------------------------------
+        // Method:      SetLevels
+        // Description: This method sets the white and black levels and the
+        //              switching voltages around their midpoint
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void SetLevels
+        (
+            float           whiteLevel, // <I> - voltage over the line
+            float           blackLevel  // <I> - voltage over black
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      ReadFilteredVoltage
+        // Description: This method reads the filtered voltage; the mean of the
+        //              accumulator since the last read when there is one,
+        //              otherwise the FPGA average
+        // Returns:     float       voltage
+        //--------------------------------------------------------------------
+        float ReadFilteredVoltage();
+
+        float           m_voltage;      // voltage from the last Sample()
+        double          m_sampleTime;   // FPGA time (seconds) of the last Sample()
+        float           m_voltageRate;  // volts per second between the last two Sample()s
+        bool            m_accumulating; // true = this channel has an accumulator
+        int64_t         m_lastAccumulatorValue;
+        int64_t         m_lastAccumulatorCount;
+        LINE_TRACKER_COLOR  m_color;    // color from the last Sample()
+
+        float           m_whiteLevel;   // voltage over the line
+        float           m_blackLevel;   // voltage over black
+        float           m_toWhite;      // at or below this the color becomes white
+        float           m_toBlack;      // at or above this the color becomes black
+
+        bool            m_calibrating;
+        float           m_sweepLow;     // lowest reading since StartCalibration()
+        float           m_sweepHigh;    // highest reading since StartCalibration()
+
+        const std::string   m_whiteKey; // Preferences keys
+        const std::string   m_blackKey;
 
-        const float     LOWER_WHITE_VALUE  = 0.0;
-        const float     UPPER_WHITE_VALUE  = 2.4;
+        const float     DEFAULT_WHITE_LEVEL  = 1.4;
+        const float     DEFAULT_BLACK_LEVEL  = 3.6;
+        const float     MIN_LEVEL_SPAN       = 1.0;     // volts between white and black for a good calibration
+        const float     HYSTERESIS           = 0.2;     // width of the band as a fraction of the span
 
-        const float     LOWER_BLACK_VALUE  = 2.6;
-        const float     UPPER_BLACK_VALUE  = 5.0;
+        // Each averaged value is 2^(OVERSAMPLE_BITS + AVERAGE_BITS) samples; 16 samples
+        // at the default sample rate is a new value about every 2.5 ms, which keeps up with
+        // the 500 Hz drive task
+        const uint32_t  OVERSAMPLE_BITS      = 2;
+        const uint32_t  AVERAGE_BITS         = 2;
 
         // Default methods we don't want the compiler to implement for us
         LineTracker() = delete;
@@ -12,6 +12,7 @@
 #include <IShooter.h>               // Class the control the shooter motors
 #include <IShooterFactory.h>        // Class constructs the correct chassis
 #include <OperatorInterface.h>      // Controls creating singleton of the gamepads
+#include <InputSnapshot.h>          // Inputs sampled this cycle
 #include <DigitalInput.h>
 #include <Year1Shooter.h>
 //--------------------------------------------------------------------
@@ -32,7 +33,10 @@ LineUpShooter::LineUpShooter() : m_oi( OperatorInterface::GetInstance() ),
 //              shooter left or right if the correct input is pressed
 // Returns:     void
 //--------------------------------------------------------------------
-void LineUpShooter::AdjustShooterPosition() const
+void LineUpShooter::AdjustShooterPosition
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+) const
 {
     // TODO:    Read the gamepad ...
     //              if the ALIGN_SHOOTER_RIGHT_BUTTON is pressed move the shooter to the right call ShiftRight).
@@ -40,15 +44,15 @@ void LineUpShooter::AdjustShooterPosition() const
 
 
 
-    if (m_oi-> GetRawButton(ALIGN_SHOOTER_RIGHT_BUTTON))
+    if (inputs.button[ALIGN_SHOOTER_RIGHT_BUTTON])
     {
-        ShiftRight();
+        ShiftRight( inputs );
 
     }
 
-    else if (m_oi-> GetRawButton(ALIGN_SHOOTER_LEFT_BUTTON))
+    else if (inputs.button[ALIGN_SHOOTER_LEFT_BUTTON])
     {
-        ShiftLeft();
+        ShiftLeft( inputs );
     }
     else
     {
@@ -62,12 +66,15 @@ void LineUpShooter::AdjustShooterPosition() const
 // Returns:     bool    true  = already at the farthest left postion
 //                      false = can move farther left
 //--------------------------------------------------------------------
-bool LineUpShooter::ShiftLeft() const
+bool LineUpShooter::ShiftLeft
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+) const
 {
     // TODO:    Set up speed constant in LineUpShooter.h
     //          call m_shooter's AlignShooter method with this speed
 
-    bool    atBound = m_shooter->IsShooterAtLeftBound();
+    bool    atBound = inputs.shooterAtLeftBound;
     float   speed = 0.0;
     if ( atBound )
     {
@@ -87,12 +94,15 @@ bool LineUpShooter::ShiftLeft() const
 // Returns:     bool    true  = already at the farthest right postion
 //                      false = can move farther right
 //--------------------------------------------------------------------
-bool LineUpShooter::ShiftRight() const
+bool LineUpShooter::ShiftRight
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+) const
 {
     // TODO:    Set up speed constant in LineUpShooter.h
 
 //          call m_shooter's AlignShooter method with this speed
-    bool    atBound = m_shooter->IsShooterAtRightBound();
+    bool    atBound = inputs.shooterAtRightBound;
     float   speed = 0.0;
     if ( atBound )
     {
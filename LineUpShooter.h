@@ -14,6 +14,7 @@
 //  Team 302 includes
 #include <IShooter.h>           // Class that controls the shooter motors
 #include <OperatorInterface.h>  // Driver Game pad interface
+#include <InputSnapshot.h>      // Inputs sampled this cycle
 
 class LineUpShooter
 {
@@ -30,7 +31,10 @@ class LineUpShooter
         //              shooter left or right if the correct input is pressed
         // Returns:     void
         //--------------------------------------------------------------------
-        void AdjustShooterPosition() const;
+        void AdjustShooterPosition
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const;
 
         //--------------------------------------------------------------------
         // Method:      ~LineUpShooter <<destructor>>
@@ -46,7 +50,10 @@ class LineUpShooter
         // Returns:     bool    true  = already at the farthest left postion
         //                      false = can move farther left
         //--------------------------------------------------------------------
-        bool ShiftLeft() const;
+        bool ShiftLeft
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const;
 
 
         //--------------------------------------------------------------------
@@ -55,7 +62,10 @@ class LineUpShooter
         // Returns:     bool    true  = already at the farthest right postion
         //                      false = can move farther right
         //--------------------------------------------------------------------
-        bool ShiftRight() const;
+        bool ShiftRight
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const;
 
     private:
         // Attributes
@@ -4,24 +4,43 @@
  *
  * File Description:
  *
- * This controls loading a ball into the shooter.
+ * This controls loading a ball into the shooter, one ball per loader cycle.
  *=============================================================================================*/
-#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
 
 
 // Team 302 includes
 #include <LoadBall.h>               // This class
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
 #include <IShooter.h>               // Class the control the shooter motors
 #include <IShooterFactory.h>        // Class constructs the correct chassis
 #include <OperatorInterface.h>      // Controls creating singleton of the gamepads
+#include <InputSnapshot.h>          // Inputs sampled this cycle
 
 //--------------------------------------------------------------------
 // Method:      LoadBall <<constructor>>
 // Description: This method creates and initializes the objects
 //--------------------------------------------------------------------
-LoadBall::LoadBall() : m_oi( OperatorInterface::GetInstance() ),
-                       m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
-					   m_switchTripped( false )
+LoadBall::LoadBall
+(
+    const SpinShooterWheel*     shooterWheel    // <I> - wheel that has to be at speed to fire
+) : m_oi( OperatorInterface::GetInstance() ),
+    m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+    m_shooterWheel( shooterWheel ),
+    m_dashboard( DashboardPublisher::GetInstance() ),
+    m_loadTrippedChannel( m_dashboard->RegisterChannel("load tripped") ),
+    m_shotCountChannel( m_dashboard->RegisterChannel("feed shots") ),
+    m_cycleTimeChannel( m_dashboard->RegisterChannel("feed cycle time") ),
+    m_wheelWaitChannel( m_dashboard->RegisterChannel("feed wheel wait time") ),
+    m_shotIntervalChannel( m_dashboard->RegisterChannel("feed shot interval") ),
+    m_ballsPerMinuteChannel( m_dashboard->RegisterChannel("feed balls per minute") ),
+    m_state( FEED_IDLE ),
+    m_isShot( false ),
+    m_returnsAtStart( 0 ),
+    m_waitStart( 0.0 ),
+    m_loadStart( 0.0 ),
+    m_lastShotTime( 0.0 ),
+    m_inBurst( false ),
+    m_shotCount( 0 )
 {
 
 
@@ -30,36 +49,146 @@ LoadBall::LoadBall() : m_oi( OperatorInterface::GetInstance() ),
 
 //--------------------------------------------------------------------
 // Method:      CycleLoader
-// Description: This method will read the gamepad input and move run
+// Description: This method will read the gamepad input and step the
+//              feed sequence: wait for the wheel, then run the
 //              loader motor until the sensor detects it is back in
-//              load position
+//              load position.
 // Returns:     void
 //--------------------------------------------------------------------
-void LoadBall::CycleLoader()
+void LoadBall::CycleLoader
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
-	SmartDashboard::PutBoolean("load tripped", m_shooter->IsLoaderInPosition());
+	m_dashboard->PutBoolean( m_loadTrippedChannel, inputs.loaderInPosition);
 
+    bool loadPressed = inputs.button[LOAD_BALL_BUTTON];
+    switch ( m_state )
+    {
+        case FEED_IDLE:
+            if ( !inputs.loaderInPosition )
+            {
+                StartLoading( inputs, false );      // finish a cycle that was cut off
+            }
+            else if ( loadPressed )
+            {
+                m_state     = FEED_WAIT_FOR_WHEEL;
+                m_waitStart = inputs.timestamp;
+                m_inBurst   = false;
+            }
+            break;
 
-	m_switchTripped = m_shooter->IsLoaderInPosition();
+        case FEED_WAIT_FOR_WHEEL:
+            // Only a wheel speed sampled after the last ball left shows that the wheel has
+            // recovered from that shot
+            if ( !loadPressed )
+            {
+                m_state = FEED_IDLE;
+            }
+            else if ( m_shooterWheel->IsAtSpeed() && inputs.shooterTimestamp > m_lastShotTime )
+            {
+                StartLoading( inputs, true );
+            }
+            break;
 
-    // If the button is pressed, load a ball
-    if (m_oi->GetRawButton(LOAD_BALL_BUTTON))
-    {
-        m_shooter->SetBallLoadMotor(m_shooterSpeedRun);
-        m_switchTripped = false;
+        case FEED_LOADING:
+            if ( IsLoaderBack( inputs ) )
+            {
+                if ( m_isShot )
+                {
+                    EndShot( inputs );
+                }
+
+                // Keep firing while the button is held, one ball per cycle
+                if ( loadPressed )
+                {
+                    m_state     = FEED_WAIT_FOR_WHEEL;
+                    m_waitStart = inputs.loaderReturnTimestamp;
+                    m_inBurst   = m_isShot;
+                }
+                else
+                {
+                    m_state = FEED_IDLE;
+                }
+            }
+            break;
+
+        default:
+            m_state = FEED_IDLE;
+            break;
     }
 
-    // If the loader isn't in position, keep running the loader
-    else if (m_shooter->IsLoaderInPosition() == false && !m_switchTripped )
+    m_shooter->SetBallLoadMotor( ( m_state == FEED_LOADING ) ? m_shooterSpeedRun : m_shooterSpeedStopped );
+}
+
+//--------------------------------------------------------------------
+// Method:      StartLoading
+// Description: This method starts the loader motor for a cycle
+// Returns:     void
+//--------------------------------------------------------------------
+void LoadBall::StartLoading
+(
+    const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+    bool                        isShot      // <I> - true = the cycle fires a ball
+)
+{
+    m_state          = FEED_LOADING;
+    m_isShot         = isShot;
+    m_returnsAtStart = inputs.loaderReturns;
+    m_loadStart      = inputs.timestamp;
+}
+
+//--------------------------------------------------------------------
+// Method:      IsLoaderBack
+// Description: This method checks whether the loader has got back to
+//              its load position since StartLoading()
+// Returns:     bool    true  = cycle is done
+//--------------------------------------------------------------------
+bool LoadBall::IsLoaderBack
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    if ( inputs.loaderReturns == m_returnsAtStart )
     {
-        m_shooter->SetBallLoadMotor(m_shooterSpeedRun);
+        return false;
     }
 
-    // Otherwise stop the loader
-    else
+    // A loader that started in position can't be back this soon; the sensor bounced as
+    // the loader left, so wait for the next return.  A loader that started out of position
+    // may be nearly home, so its first return ends the cycle.
+    if ( m_isShot && ( inputs.loaderReturnTimestamp - m_loadStart ) < m_minCycleTime )
     {
-        m_shooter->SetBallLoadMotor(m_shooterSpeedStopped);  // fixed case
+        m_returnsAtStart = inputs.loaderReturns;
+        return false;
     }
+    return true;
 }
 
+//--------------------------------------------------------------------
+// Method:      EndShot
+// Description: This method works out the timing of the shot that just
+//              finished and publishes it
+// Returns:     void
+//--------------------------------------------------------------------
+void LoadBall::EndShot
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    double shotTime = inputs.loaderReturnTimestamp;
+
+    m_shotCount++;
+    m_dashboard->PutNumber( m_shotCountChannel, m_shotCount );
+    m_dashboard->PutNumber( m_cycleTimeChannel, shotTime - m_loadStart );
+    m_dashboard->PutNumber( m_wheelWaitChannel, m_loadStart - m_waitStart );
 
+    // The sustained rate only makes sense between shots of the same burst
+    if ( m_inBurst && shotTime > m_lastShotTime )
+    {
+        double interval = shotTime - m_lastShotTime;
+        m_dashboard->PutNumber( m_shotIntervalChannel, interval );
+        m_dashboard->PutNumber( m_ballsPerMinuteChannel, 60.0 / interval );
+    }
+    m_lastShotTime = shotTime;
+}
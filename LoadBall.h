@@ -4,7 +4,22 @@
  *
  * File Description:
  *
- * This controls loading a ball into the shooter.
+ * This controls loading a ball into the shooter.  It is a feed sequencer: each loader cycle
+ * fires exactly one ball, and a cycle only starts when the shooter wheel is at speed.
+ *
+ *      FEED_IDLE            -> load button pressed         -> FEED_WAIT_FOR_WHEEL
+ *      FEED_WAIT_FOR_WHEEL  -> wheel at speed              -> FEED_LOADING
+ *      FEED_LOADING         -> loader back in position     -> FEED_IDLE or FEED_WAIT_FOR_WHEEL
+ *                                                             (button still pressed)
+ *
+ * The end of a cycle is the loader sensor edge counted by the shooter's interrupt, so a cycle
+ * isn't missed or stretched by the loop rate, and the shot times use the edge time.  Holding
+ * the button fires as fast as the wheel recovers: the next ball waits for the wheel to be at
+ * speed on a sample taken after the last ball left.  A cycle that has started is always
+ * finished, and a loader found out of position is run back to its load position (not counted
+ * as a shot).
+ *
+ * The shot count and the timing of the last shot are published to the dashboard.
  *=============================================================================================*/
 
 #ifndef SRC_LOADBALL_H_
@@ -14,6 +29,16 @@
 //  Team 302 includes
 #include <IShooter.h>           // Class that controls the shooter motors
 #include <OperatorInterface.h>  // Driver Game pad interface
+#include <InputSnapshot.h>      // Inputs sampled this cycle
+#include <DashboardPublisher.h> // Sends dashboard values from a background thread
+#include <SpinShooterWheel.h>   // Says when the wheel is ready to fire
+
+enum FEED_STATE
+{
+    FEED_IDLE,                  // loader in its load position and stopped
+    FEED_WAIT_FOR_WHEEL,        // a ball is wanted; waiting for the wheel to be at speed
+    FEED_LOADING                // loader running until it gets back to its load position
+};
 
 class LoadBall
 {
@@ -22,16 +47,23 @@ class LoadBall
         // Method:      LoadBall <<constructor>>
         // Description: This method creates and initializes the objects
         //--------------------------------------------------------------------
-        LoadBall();      // constructor
+        LoadBall
+        (
+            const SpinShooterWheel*     shooterWheel    // <I> - wheel that has to be at speed to fire
+        );
 
         //--------------------------------------------------------------------
         // Method:      CycleLoader
-        // Description: This method will read the gamepad input and move run
+        // Description: This method will read the gamepad input and step the
+        //              feed sequence: wait for the wheel, then run the
         //              loader motor until the sensor detects it is back in
-        //              load position
+        //              load position.
         // Returns:     void
         //--------------------------------------------------------------------
-        void CycleLoader();
+        void CycleLoader
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
 
         //--------------------------------------------------------------------
         // Method:      ~LoadBall <<destructor>>
@@ -43,20 +75,74 @@ class LoadBall
 
 
     private:
+        //--------------------------------------------------------------------
+        // Method:      StartLoading
+        // Description: This method starts the loader motor for a cycle
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void StartLoading
+        (
+            const InputSnapshotData&    inputs,     // <I> - inputs sampled this cycle
+            bool                        isShot      // <I> - true = the cycle fires a ball
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      IsLoaderBack
+        // Description: This method checks whether the loader has got back to
+        //              its load position since StartLoading()
+        // Returns:     bool    true  = cycle is done
+        //--------------------------------------------------------------------
+        bool IsLoaderBack
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      EndShot
+        // Description: This method works out the timing of the shot that just
+        //              finished and publishes it
+        // Returns:     void
+        //--------------------------------------------------------------------
+        void EndShot
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
         // Attributes
         OperatorInterface*      m_oi;
         IShooter*               m_shooter;
-        bool					m_switchTripped;
+        const SpinShooterWheel* m_shooterWheel;
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_loadTrippedChannel;
+        const DASHBOARD_CHANNEL m_shotCountChannel;
+        const DASHBOARD_CHANNEL m_cycleTimeChannel;
+        const DASHBOARD_CHANNEL m_wheelWaitChannel;
+        const DASHBOARD_CHANNEL m_shotIntervalChannel;
+        const DASHBOARD_CHANNEL m_ballsPerMinuteChannel;
+
+        FEED_STATE              m_state;
+        bool                    m_isShot;           // true = the running cycle fires a ball
+        unsigned int            m_returnsAtStart;   // loader return count when the cycle started
+        double                  m_waitStart;        // when the ball was wanted (button or last shot)
+        double                  m_loadStart;        // when the loader was started
+        double                  m_lastShotTime;     // loader return time of the last shot
+        bool                    m_inBurst;          // true = button held since the last shot
+        int                     m_shotCount;
 
         // This is the speed for the Loader's Motor- It's Constant
 
         const float m_shooterSpeedStopped = 0.0;
         const float m_shooterSpeedRun = 1.0;
 
+        // A return edge this soon after the loader starts is the sensor bouncing as the
+        // loader leaves, not the end of the cycle (seconds)
+        const double m_minCycleTime = 0.1;
+
         // Default methods we don't want the compiler to implement for us
         LoadBall( const LoadBall& ) = delete;
         LoadBall& operator= ( const LoadBall& ) = delete;
         explicit LoadBall( LoadBall* other ) = delete;
+        LoadBall() = delete;
 
 
 };
@@ -0,0 +1,238 @@
+/*=============================================================================================
+ * LoopProfiler.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This measures how much of the loop time each subsystem call uses.  The recent samples for
+ * each section are kept in a ring buffer (for the percentiles) and counted in a fixed bucket
+ * histogram (for the dump).
+ *=============================================================================================*/
+
+// Standard includes
+#include <algorithm>                // std::nth_element, std::copy
+#include <cstdio>                   // printf
+#include <string>                   // std::string
+
+// Team 302 includes
+#include <LoopProfiler.h>           // This class
+
+
+LoopProfiler* LoopProfiler::m_instance = nullptr; // initialize the instance variable to nullptr
+
+const char* LoopProfiler::SECTION_NAMES[MAX_PROFILE_SECTIONS] =
+{
+    "loop",
+    "inputs",
+    "drive",
+    "loader",
+    "shooter align",
+    "shooter wheel",
+    "follow line",
+    "control loop",
+    "auton"
+};
+
+//----------------------------------------------------------------------------------
+// Method:      GetInstance
+// Description: If there isn't an instance of this class, it will create one.  The
+//              single class instance will be returned.
+// Returns:     LoopProfiler*  instance of this class
+//----------------------------------------------------------------------------------
+LoopProfiler* LoopProfiler::GetInstance()
+{
+    if ( LoopProfiler::m_instance == nullptr )
+    {
+        LoopProfiler::m_instance = new LoopProfiler();
+    }
+    return LoopProfiler::m_instance;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      LoopProfiler <<constructor>>
+// Description: This will construct and initialize the object
+//----------------------------------------------------------------------------------
+LoopProfiler::LoopProfiler() : m_stats(),
+                               m_scratch(),
+                               m_loops( 0 ),
+                               m_dashboard( DashboardPublisher::GetInstance() ),
+                               m_p50Channels(),
+                               m_p99Channels(),
+                               m_maxChannels()
+{
+    // The keys are only built here; publishing just uses the handles
+    for ( int inx=0; inx<MAX_PROFILE_SECTIONS; ++inx )
+    {
+        std::string key = std::string( " profile " ) + SECTION_NAMES[inx];
+        m_p50Channels[inx] = m_dashboard->RegisterChannel( ( key + " p50 (ms)" ).c_str() );
+        m_p99Channels[inx] = m_dashboard->RegisterChannel( ( key + " p99 (ms)" ).c_str() );
+        m_maxChannels[inx] = m_dashboard->RegisterChannel( ( key + " max (ms)" ).c_str() );
+    }
+    Reset();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Record
+// Description: Stores an elapsed time for a section
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::Record
+(
+    PROFILE_SECTION section,        // <I> - section that was timed
+    float           microseconds    // <I> - elapsed time
+)
+{
+    if ( section >= 0 && section < MAX_PROFILE_SECTIONS )
+    {
+        SectionStats& stats = m_stats[section];
+        stats.samples[stats.next] = microseconds;
+        stats.next = ( stats.next + 1 ) % SAMPLE_COUNT;
+        stats.count++;
+        stats.max = ( microseconds > stats.max ) ? microseconds : stats.max;
+
+        int bucket = static_cast<int>( microseconds / BUCKET_WIDTH );
+        bucket = ( bucket < HISTOGRAM_BUCKETS ) ? bucket : HISTOGRAM_BUCKETS - 1;
+        stats.histogram[bucket]++;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PublishPeriodic
+// Description: Call once per loop.  Every PUBLISH_INTERVAL calls the p50/p99/max
+//              of the recent samples are sent to the dashboard.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::PublishPeriodic()
+{
+    m_loops++;
+    if ( m_loops >= PUBLISH_INTERVAL )
+    {
+        Publish();
+        m_loops = 0;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Dump
+// Description: Prints the statistics and histogram for each section to the
+//              console, publishes them and then clears them.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::Dump()
+{
+    printf( "Loop profile (ms)\n" );
+    for ( int inx=0; inx<MAX_PROFILE_SECTIONS; ++inx )
+    {
+        const SectionStats& stats = m_stats[inx];
+        if ( stats.count > 0 )
+        {
+            float p50 = 0.0;
+            float p99 = 0.0;
+            Percentiles( static_cast<PROFILE_SECTION>( inx ), p50, p99 );
+            printf( "  %-14s count %7u  p50 %7.3f  p99 %7.3f  max %7.3f\n",
+                    SECTION_NAMES[inx],
+                    stats.count,
+                    p50 / 1000.0,
+                    p99 / 1000.0,
+                    stats.max / 1000.0 );
+
+            // Only print the buckets that have something in them
+            for ( int bucket=0; bucket<HISTOGRAM_BUCKETS; ++bucket )
+            {
+                if ( stats.histogram[bucket] > 0 )
+                {
+                    float lower = bucket * BUCKET_WIDTH / 1000.0;
+                    if ( bucket < HISTOGRAM_BUCKETS - 1 )
+                    {
+                        printf( "      %5.1f - %5.1f  %7u\n", lower, lower + BUCKET_WIDTH / 1000.0, stats.histogram[bucket] );
+                    }
+                    else
+                    {
+                        printf( "      %5.1f +        %7u\n", lower, stats.histogram[bucket] );
+                    }
+                }
+            }
+        }
+    }
+
+    Publish();
+    Reset();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Reset
+// Description: Clears all of the samples and histograms
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::Reset()
+{
+    for ( int inx=0; inx<MAX_PROFILE_SECTIONS; ++inx )
+    {
+        SectionStats& stats = m_stats[inx];
+        std::fill( stats.samples, stats.samples + SAMPLE_COUNT, 0.0 );
+        std::fill( stats.histogram, stats.histogram + HISTOGRAM_BUCKETS, 0 );
+        stats.next  = 0;
+        stats.count = 0;
+        stats.max   = 0.0;
+    }
+    m_loops = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Percentiles
+// Description: Finds the 50th and 99th percentile of the recent samples for a
+//              section
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::Percentiles
+(
+    PROFILE_SECTION section,        // <I> - section to look at
+    float&          p50,            // <O> - median (microseconds)
+    float&          p99             // <O> - 99th percentile (microseconds)
+)
+{
+    const SectionStats& stats = m_stats[section];
+    int size = ( stats.count < SAMPLE_COUNT ) ? static_cast<int>( stats.count ) : SAMPLE_COUNT;
+    p50 = 0.0;
+    p99 = 0.0;
+    if ( size > 0 )
+    {
+        // The samples are in the order they were recorded, so work on a copy
+        std::copy( stats.samples, stats.samples + size, m_scratch );
+
+        int p99Index = ( size * 99 ) / 100;
+        std::nth_element( m_scratch, m_scratch + p99Index, m_scratch + size );
+        p99 = m_scratch[p99Index];
+
+        int p50Index = size / 2;
+        std::nth_element( m_scratch, m_scratch + p50Index, m_scratch + p99Index );
+        p50 = m_scratch[p50Index];
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Publish
+// Description: Sends the p50/p99/max for each section to the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void LoopProfiler::Publish()
+{
+    for ( int inx=0; inx<MAX_PROFILE_SECTIONS; ++inx )
+    {
+        float p50 = 0.0;
+        float p99 = 0.0;
+        Percentiles( static_cast<PROFILE_SECTION>( inx ), p50, p99 );
+        m_dashboard->PutNumber( m_p50Channels[inx], p50 / 1000.0 );
+        m_dashboard->PutNumber( m_p99Channels[inx], p99 / 1000.0 );
+        m_dashboard->PutNumber( m_maxChannels[inx], m_stats[inx].max / 1000.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~LoopProfiler <<destructor>>
+// Description: This will clean up the object
+//----------------------------------------------------------------------------------
+LoopProfiler::~LoopProfiler()
+{
+    LoopProfiler::m_instance = nullptr;
+}
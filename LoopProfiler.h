@@ -0,0 +1,200 @@
+/*=============================================================================================
+ * LoopProfiler.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This measures how much of the loop time each subsystem call uses.  A ScopedLoopTimer is put
+ * around each call; when it goes out of scope the elapsed time (monotonic clock) is stored in
+ * a ring buffer of recent samples for that section and counted in a fixed bucket histogram.
+ * Recording never allocates, so the timers can stay in the match code.
+ *
+ * The p50/p99/max of the recent samples are published to the dashboard at a low rate, and
+ * Dump() prints all of the statistics and the histograms to the console (call it when the
+ * robot is disabled).  It is a Singleton.
+ *
+ * Each section must only be recorded from one thread (the drive and shooter sections are
+ * recorded from the TaskExecutor thread when the ControlLoop is running).  Publishing reads
+ * the samples without locking, so a published value may miss the sample being recorded at that
+ * moment.
+ *=============================================================================================*/
+
+#ifndef SRC_LOOPPROFILER_H_
+#define SRC_LOOPPROFILER_H_
+
+// Standard includes
+#include <chrono>                   // std::chrono::steady_clock
+
+// Team 302 includes
+#include <DashboardPublisher.h>     // Sends the statistics from a background thread
+
+enum PROFILE_SECTION
+{
+    PROFILE_LOOP,               // all of TeleopPeriodic
+    PROFILE_SAMPLE_INPUTS,      // InputSnapshot::Sample
+    PROFILE_DRIVE,              // IJoystickDrive::DriveWithJoysticks
+    PROFILE_LOADER,             // LoadBall::CycleLoader
+    PROFILE_SHOOTER_ALIGN,      // LineUpShooter::AdjustShooterPosition
+    PROFILE_SHOOTER_WHEEL,      // SpinShooterWheel::SpinWheels
+    PROFILE_FOLLOW_LINE,        // FollowLine::Drive
+    PROFILE_CONTROL_LOOP,       // one pass of the TaskExecutor
+    PROFILE_AUTON,              // IAutonAction::Run of the autonomous routine
+    MAX_PROFILE_SECTIONS
+};
+
+class LoopProfiler
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetInstance
+        // Description: If there isn't an instance of this class, it will create one.  The
+        //              single class instance will be returned.
+        // Returns:     LoopProfiler*  instance of this class
+        //----------------------------------------------------------------------------------
+        static LoopProfiler* GetInstance();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Record
+        // Description: Stores an elapsed time for a section
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Record
+        (
+            PROFILE_SECTION section,        // <I> - section that was timed
+            float           microseconds    // <I> - elapsed time
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      PublishPeriodic
+        // Description: Call once per loop.  Every PUBLISH_INTERVAL calls the p50/p99/max
+        //              of the recent samples are sent to the dashboard.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void PublishPeriodic();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Dump
+        // Description: Prints the statistics and histogram for each section to the
+        //              console, publishes them and then clears them.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Dump();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Reset
+        // Description: Clears all of the samples and histograms
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Reset();
+
+    private:
+        static const int    SAMPLE_COUNT = 256;         // recent samples kept for each section
+        static const int    HISTOGRAM_BUCKETS = 21;     // last bucket holds everything larger
+        const float         BUCKET_WIDTH = 500.0;       // microseconds
+        static const int    PUBLISH_INTERVAL = 50;      // loops between dashboard updates (~1 sec)
+
+        struct SectionStats
+        {
+            float           samples[SAMPLE_COUNT];      // ring buffer of recent times (microseconds)
+            int             next;                       // next slot to write in samples
+            unsigned int    count;                      // samples recorded since the last Reset()
+            float           max;                        // largest time since the last Reset()
+            unsigned int    histogram[HISTOGRAM_BUCKETS];   // counts since the last Reset()
+        };
+
+        //----------------------------------------------------------------------------------
+        // Method:      Percentiles
+        // Description: Finds the 50th and 99th percentile of the recent samples for a
+        //              section
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Percentiles
+        (
+            PROFILE_SECTION section,        // <I> - section to look at
+            float&          p50,            // <O> - median (microseconds)
+            float&          p99             // <O> - 99th percentile (microseconds)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Publish
+        // Description: Sends the p50/p99/max for each section to the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Publish();
+
+        //----------------------------------------------------------------------------------
+        // Method:      LoopProfiler <<constructor>>
+        // Description: This will construct and initialize the object
+        //----------------------------------------------------------------------------------
+        LoopProfiler();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~LoopProfiler <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~LoopProfiler();
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static LoopProfiler*    m_instance;     // Singleton instance of this class
+        static const char*      SECTION_NAMES[MAX_PROFILE_SECTIONS];
+
+        SectionStats            m_stats[MAX_PROFILE_SECTIONS];
+        float                   m_scratch[SAMPLE_COUNT];    // working copy for the percentiles
+        int                     m_loops;                    // loops since the last publish
+
+        DashboardPublisher*     m_dashboard;
+        DASHBOARD_CHANNEL       m_p50Channels[MAX_PROFILE_SECTIONS];
+        DASHBOARD_CHANNEL       m_p99Channels[MAX_PROFILE_SECTIONS];
+        DASHBOARD_CHANNEL       m_maxChannels[MAX_PROFILE_SECTIONS];
+
+        // Default methods we don't want the compiler to implement for us
+        LoopProfiler( const LoopProfiler& ) = delete;
+        LoopProfiler& operator= ( const LoopProfiler& ) = delete;
+        explicit LoopProfiler( LoopProfiler* other ) = delete;
+};
+
+//==============================================================================================
+// ScopedLoopTimer times the block it is declared in and records it when the block exits:
+//
+//      {
+//          ScopedLoopTimer timer( PROFILE_LOADER );
+//          m_loader->CycleLoader();
+//      }
+//==============================================================================================
+class ScopedLoopTimer
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      ScopedLoopTimer <<constructor>>
+        // Description: Starts timing the section
+        //----------------------------------------------------------------------------------
+        explicit ScopedLoopTimer
+        (
+            PROFILE_SECTION section         // <I> - section being timed
+        ) : m_section( section ),
+            m_start( std::chrono::steady_clock::now() )
+        {
+        }
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~ScopedLoopTimer <<destructor>>
+        // Description: Records the time since the constructor
+        //----------------------------------------------------------------------------------
+        ~ScopedLoopTimer()
+        {
+            std::chrono::duration<float, std::micro> elapsed = std::chrono::steady_clock::now() - m_start;
+            LoopProfiler::GetInstance()->Record( m_section, elapsed.count() );
+        }
+
+    private:
+        PROFILE_SECTION                         m_section;
+        std::chrono::steady_clock::time_point   m_start;
+
+        // Default methods we don't want the compiler to implement for us
+        ScopedLoopTimer( const ScopedLoopTimer& ) = delete;
+        ScopedLoopTimer& operator= ( const ScopedLoopTimer& ) = delete;
+};
+
+#endif /* SRC_LOOPPROFILER_H_ */
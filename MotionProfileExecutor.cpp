@@ -0,0 +1,329 @@
+/*=============================================================================================
+ * MotionProfileExecutor.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This drives the robot a set distance with a motion profile that runs on the drive motor
+ * controllers.  The points are planned up front and streamed to the chassis by Stream(), on
+ * the thread that owns the chassis.
+ *=============================================================================================*/
+
+// Standard includes
+#include <algorithm>                // std::min, std::max
+#include <cmath>                    // ceil, fabs, sqrt
+
+// Team 302 includes
+#include <MotionProfileExecutor.h>  // This class
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+
+
+//----------------------------------------------------------------------------------
+// Method:      MotionProfileExecutor <<constructor>>
+// Description: This will construct and initialize the object
+//----------------------------------------------------------------------------------
+MotionProfileExecutor::MotionProfileExecutor() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                                                 m_points(),
+                                                 m_pointCount( 0 ),
+                                                 m_started( false ),
+                                                 m_streaming( false ),
+                                                 m_nextPoint( 0 ),
+                                                 m_enabled( false ),
+                                                 m_lastStreamTime( 0.0 ),
+                                                 m_done( false ),
+                                                 m_underrun( false )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Plans a straight move from where the robot is now and gets the
+//              drive motors ready for it (Stream() loads the points).  A move
+//              that is still running is stopped first.
+// Returns:     bool    true  = move started
+//                      false = the move is too long for the point buffer (or the
+//                              limits aren't positive); the robot doesn't move
+//----------------------------------------------------------------------------------
+bool MotionProfileExecutor::Start
+(
+    float       distance,           // <I> - feet to drive (negative is backward)
+    float       maxVelocity,        // <I> - feet per second (limited to the chassis maximum)
+    float       maxAcceleration     // <I> - feet per second per second
+)
+{
+    Stop();
+
+    m_done     = false;
+    m_underrun = false;
+
+    float velocity = std::min( maxVelocity, m_chassis->GetMaxVelocity() );
+    bool  planned  = Plan( distance, velocity, maxAcceleration,
+                           m_chassis->GetLeftSideDistance(), m_chassis->GetRightSideDistance() );
+    if ( planned )
+    {
+        BeginMove();
+    }
+    return planned;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Gets a trajectory made ahead of time ready to drive from where the
+//              robot is now (Stream() loads the points).  A move that is still
+//              running is stopped first.
+// Returns:     bool    true  = move started
+//                      false = the trajectory is too long for the point buffer;
+//                              the robot doesn't move
+//----------------------------------------------------------------------------------
+bool MotionProfileExecutor::Start
+(
+    const Trajectory&   trajectory      // <I> - samples to drive
+)
+{
+    Stop();
+
+    m_done       = false;
+    m_underrun   = false;
+    m_pointCount = 0;
+    if ( trajectory.sampleCount < 1 || trajectory.sampleCount > MAX_POINTS )
+    {
+        return false;
+    }
+
+    float leftStart  = m_chassis->GetLeftSideDistance();
+    float rightStart = m_chassis->GetRightSideDistance();
+    for ( int inx=0; inx<trajectory.sampleCount; ++inx )
+    {
+        const TrajectorySample& sample = trajectory.samples[inx];
+        DriveProfilePoint&      point  = m_points[inx];
+        point.leftPosition  = leftStart  + sample.leftPosition;
+        point.leftVelocity  = sample.leftVelocity;
+        point.rightPosition = rightStart + sample.rightPosition;
+        point.rightVelocity = sample.rightVelocity;
+        point.durationMs    = trajectory.samplePeriodMs;
+        point.isLastPoint   = ( inx == trajectory.sampleCount - 1 );
+    }
+    m_pointCount = trajectory.sampleCount;
+
+    BeginMove();
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsDone
+// Description: Checks whether the motors have reached the last point.  They keep
+//              holding it until Stop() or SetMotorSpeeds() is called.
+// Returns:     bool    true  = move finished
+//----------------------------------------------------------------------------------
+bool MotionProfileExecutor::IsDone() const
+{
+    return m_done;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      HasUnderrun
+// Description: Checks whether the motors ran out of points during the move
+//              (Stream() wasn't called often enough)
+// Returns:     bool    true  = the motors had to wait for points
+//----------------------------------------------------------------------------------
+bool MotionProfileExecutor::HasUnderrun() const
+{
+    return m_underrun;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stop
+// Description: Stops streaming and turns the profile output off (the motors go
+//              neutral)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void MotionProfileExecutor::Stop()
+{
+    m_streaming = false;
+
+    // only touch the motors if a move was started; otherwise they belong to someone else
+    if ( m_started )
+    {
+        m_chassis->SetProfileOutput( PROFILE_OUTPUT_DISABLE );
+        m_started = false;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      BeginMove
+// Description: Puts the drive motors in motion profile mode for the planned points
+//              and gets Stream() ready to load them
+// Returns:     void
+//----------------------------------------------------------------------------------
+void MotionProfileExecutor::BeginMove()
+{
+    m_chassis->StartProfile();
+    m_started        = true;
+    m_streaming      = true;
+    m_nextPoint      = 0;
+    m_enabled        = false;
+    m_lastStreamTime = 0.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Plan
+// Description: Fills in the points for a trapezoidal move
+// Returns:     bool    true  = the points fit in the buffer
+//----------------------------------------------------------------------------------
+bool MotionProfileExecutor::Plan
+(
+    float       distance,           // <I> - feet to drive (negative is backward)
+    float       maxVelocity,        // <I> - feet per second
+    float       maxAcceleration,    // <I> - feet per second per second
+    float       leftStart,          // <I> - current left side distance (feet)
+    float       rightStart          // <I> - current right side distance (feet)
+)
+{
+    m_pointCount = 0;
+    if ( maxVelocity <= 0.0 || maxAcceleration <= 0.0 )
+    {
+        return false;
+    }
+
+    // Speed up, cruise, slow down; moves too short to reach the maximum velocity
+    // speed up half way and slow down the other half
+    float direction      = ( distance < 0.0 ) ? -1.0 : 1.0;
+    float length         = fabs( distance );
+    float accelTime      = maxVelocity / maxAcceleration;
+    float accelDistance  = 0.5 * maxAcceleration * accelTime * accelTime;
+    float cruiseVelocity = maxVelocity;
+    float cruiseTime     = 0.0;
+    if ( 2.0 * accelDistance > length )
+    {
+        accelTime      = sqrt( length / maxAcceleration );
+        accelDistance  = length / 2.0;
+        cruiseVelocity = maxAcceleration * accelTime;
+    }
+    else
+    {
+        cruiseTime = ( length - 2.0 * accelDistance ) / cruiseVelocity;
+    }
+    float totalTime = 2.0 * accelTime + cruiseTime;
+
+    float period = POINT_DURATION_MS / 1000.0;
+    int   count  = std::max( 1, static_cast<int>( ceil( totalTime / period ) ) );
+    if ( count > MAX_POINTS )
+    {
+        return false;
+    }
+
+    // Each point is where the robot should be at the end of its period
+    for ( int inx=0; inx<count; ++inx )
+    {
+        float time     = std::min( ( inx + 1 ) * period, totalTime );
+        float position = 0.0;
+        float velocity = 0.0;
+        if ( time < accelTime )
+        {
+            velocity = maxAcceleration * time;
+            position = 0.5 * maxAcceleration * time * time;
+        }
+        else if ( time < accelTime + cruiseTime )
+        {
+            velocity = cruiseVelocity;
+            position = accelDistance + cruiseVelocity * ( time - accelTime );
+        }
+        else
+        {
+            float remaining = totalTime - time;
+            velocity = maxAcceleration * remaining;
+            position = length - 0.5 * maxAcceleration * remaining * remaining;
+        }
+
+        bool isLastPoint = ( inx == count - 1 );
+        if ( isLastPoint )
+        {
+            velocity = 0.0;
+            position = length;
+        }
+
+        DriveProfilePoint& point = m_points[inx];
+        point.leftPosition  = leftStart  + direction * position;
+        point.leftVelocity  = direction * velocity;
+        point.rightPosition = rightStart + direction * position;
+        point.rightVelocity = direction * velocity;
+        point.durationMs    = POINT_DURATION_MS;
+        point.isLastPoint   = isLastPoint;
+    }
+    m_pointCount = count;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stream
+// Description: Keeps the chassis buffers full, turns the profile on once enough
+//              points are loaded and checks for the last point.  Call it every
+//              cycle while a move runs, from the thread that owns the chassis.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void MotionProfileExecutor::Stream
+(
+    double      timestamp           // <I> - FPGA time (seconds) of this cycle
+)
+{
+    if ( !m_streaming )
+    {
+        return;
+    }
+
+    DriveProfileStatus status;
+    m_chassis->GetProfileStatus( status );
+
+    // Top up the roboRIO buffer a batch at a time
+    int batch = std::min( POINTS_PER_BATCH, status.topBufferRemaining );
+    for ( int inx=0; inx<batch && m_nextPoint<m_pointCount; ++inx )
+    {
+        if ( !m_chassis->PushProfilePoint( m_points[m_nextPoint] ) )
+        {
+            break;
+        }
+        m_nextPoint++;
+    }
+
+    // Each pass moves one point into the motors, so a caller that runs less often than
+    // STREAM_PERIOD_MS makes up the passes it missed
+    int passes = 1;
+    if ( m_lastStreamTime > 0.0 )
+    {
+        int missed = static_cast<int>( ( timestamp - m_lastStreamTime ) * 1000.0 / STREAM_PERIOD_MS );
+        passes = std::max( 1, std::min( missed, POINTS_PER_BATCH ) );
+    }
+    m_lastStreamTime = timestamp;
+    for ( int inx=0; inx<passes; ++inx )
+    {
+        m_chassis->ProcessProfileBuffer();
+    }
+
+    int cushion = std::min( POINTS_BEFORE_ENABLE, m_pointCount );
+    if ( !m_enabled && status.bottomBufferCount >= cushion )
+    {
+        m_chassis->SetProfileOutput( PROFILE_OUTPUT_ENABLE );
+        m_enabled = true;
+    }
+    else if ( m_enabled )
+    {
+        if ( status.hasUnderrun )
+        {
+            m_underrun = true;
+        }
+        if ( m_nextPoint >= m_pointCount && status.isLastPointActive )
+        {
+            m_done      = true;
+            m_streaming = false;    // the motors hold the last point on their own
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~MotionProfileExecutor <<destructor>>
+// Description: This will stop any move and clean up the object
+//----------------------------------------------------------------------------------
+MotionProfileExecutor::~MotionProfileExecutor()
+{
+    Stop();
+}
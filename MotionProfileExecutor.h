@@ -0,0 +1,166 @@
+/*=============================================================================================
+ * MotionProfileExecutor.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This drives the robot a set distance with a motion profile that runs on the drive motor
+ * controllers.  Start() plans a trapezoidal move (speed up at the maximum acceleration, cruise
+ * at the maximum velocity and slow down to stop on the distance) as a list of position and
+ * velocity points, one every 10 ms.  Stream() loads the points in batches into the chassis
+ * motion profile buffers and turns the profile on once enough points are loaded.  The motor
+ * controllers then servo to each point on their own, so the move is the same every time no
+ * matter when the robot program gets to run.
+ *
+ * Start() can also run a Trajectory made ahead of time (see TrajectoryFile); its side
+ * positions are added to where the sides are now, so nothing is planned on the robot.
+ *
+ * Everything runs on the caller's thread; there is no thread of its own.  The owner (an
+ * autonomous action, run by the ControlLoop's drive task) calls Stream() every cycle while the
+ * move runs, at least every STREAM_PERIOD_MS; a caller that runs less often has the points it
+ * missed moved into the motors on its next call.  While a move is running it owns the drive
+ * chassis (IChassis::IsInProfile() says so); nothing else should command the drive motors until
+ * it is stopped.  Calling SetMotorSpeeds() afterwards returns the chassis to normal driving.
+ *=============================================================================================*/
+
+#ifndef SRC_MOTIONPROFILEEXECUTOR_H_
+#define SRC_MOTIONPROFILEEXECUTOR_H_
+
+// Team 302 includes
+#include <IChassis.h>
+#include <TrajectoryFile.h>         // Trajectories made ahead of time
+
+class MotionProfileExecutor
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      MotionProfileExecutor <<constructor>>
+        // Description: This will construct and initialize the object
+        //----------------------------------------------------------------------------------
+        MotionProfileExecutor();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Plans a straight move from where the robot is now and gets the
+        //              drive motors ready for it (Stream() loads the points).  A move
+        //              that is still running is stopped first.
+        // Returns:     bool    true  = move started
+        //                      false = the move is too long for the point buffer (or the
+        //                              limits aren't positive); the robot doesn't move
+        //----------------------------------------------------------------------------------
+        bool Start
+        (
+            float       distance,           // <I> - feet to drive (negative is backward)
+            float       maxVelocity,        // <I> - feet per second (limited to the chassis maximum)
+            float       maxAcceleration     // <I> - feet per second per second
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Gets a trajectory made ahead of time ready to drive from where the
+        //              robot is now (Stream() loads the points).  A move that is still
+        //              running is stopped first.
+        // Returns:     bool    true  = move started
+        //                      false = the trajectory is too long for the point buffer;
+        //                              the robot doesn't move
+        //----------------------------------------------------------------------------------
+        bool Start
+        (
+            const Trajectory&   trajectory      // <I> - samples to drive
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stream
+        // Description: Keeps the chassis buffers full, turns the profile on once enough
+        //              points are loaded and checks for the last point.  Call it every
+        //              cycle while a move runs, from the thread that owns the chassis.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stream
+        (
+            double      timestamp           // <I> - FPGA time (seconds) of this cycle
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsDone
+        // Description: Checks whether the motors have reached the last point.  They keep
+        //              holding it until Stop() or SetMotorSpeeds() is called.
+        // Returns:     bool    true  = move finished
+        //----------------------------------------------------------------------------------
+        bool IsDone() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      HasUnderrun
+        // Description: Checks whether the motors ran out of points during the move
+        //              (Stream() wasn't called often enough)
+        // Returns:     bool    true  = the motors had to wait for points
+        //----------------------------------------------------------------------------------
+        bool HasUnderrun() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stop
+        // Description: Stops streaming and turns the profile output off (the motors go
+        //              neutral)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stop();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~MotionProfileExecutor <<destructor>>
+        // Description: This will stop any move and clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~MotionProfileExecutor();
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      BeginMove
+        // Description: Puts the drive motors in motion profile mode for the planned points
+        //              and gets Stream() ready to load them
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void BeginMove();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Plan
+        // Description: Fills in the points for a trapezoidal move
+        // Returns:     bool    true  = the points fit in the buffer
+        //----------------------------------------------------------------------------------
+        bool Plan
+        (
+            float       distance,           // <I> - feet to drive (negative is backward)
+            float       maxVelocity,        // <I> - feet per second
+            float       maxAcceleration,    // <I> - feet per second per second
+            float       leftStart,          // <I> - current left side distance (feet)
+            float       rightStart          // <I> - current right side distance (feet)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static const int            MAX_POINTS = 1500;          // 15 seconds of points
+        const int                   POINT_DURATION_MS = 10;     // time between points
+        const int                   STREAM_PERIOD_MS = 5;       // twice per point, so the buffer never runs dry
+        const int                   POINTS_PER_BATCH = 20;      // points pushed per Stream()
+        const int                   POINTS_BEFORE_ENABLE = 10;  // loaded in the motors before they start
+
+        IChassis*                   m_chassis;
+
+        // Written by Start(), then read by Stream()
+        DriveProfilePoint           m_points[MAX_POINTS];
+        int                         m_pointCount;
+
+        bool                        m_started;          // a move was started and not stopped (it owns the motors)
+        bool                        m_streaming;        // false = nothing left for Stream() to do
+        int                         m_nextPoint;        // next point to load
+        bool                        m_enabled;          // profile output turned on
+        double                      m_lastStreamTime;   // FPGA time (seconds) of the last Stream() (0 = none yet)
+        bool                        m_done;             // last point reached
+        bool                        m_underrun;         // motors ran out of points
+
+        // Default methods we don't want the compiler to implement for us
+        MotionProfileExecutor( const MotionProfileExecutor& ) = delete;
+        MotionProfileExecutor& operator= ( const MotionProfileExecutor& ) = delete;
+        explicit MotionProfileExecutor( MotionProfileExecutor* other ) = delete;
+};
+
+#endif /* SRC_MOTIONPROFILEEXECUTOR_H_ */
@@ -0,0 +1,150 @@
+/*=============================================================================================
+ * Odometry.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This keeps track of where the robot is on the field by integrating the left and right side
+ * encoder distances.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // cos, sin, fabs
+
+// Team 302 includes
+#include <Odometry.h>               // This class
+#include <IChassisFactory.h>        // Class constructs the correct chassis
+
+
+Odometry* Odometry::m_instance = nullptr; // initialize the instance variable to nullptr
+
+//----------------------------------------------------------------------------------
+// Method:      GetInstance
+// Description: If there isn't an instance of this class, it will create one.  The
+//              single class instance will be returned.
+// Returns:     Odometry*   instance of this class
+//----------------------------------------------------------------------------------
+Odometry* Odometry::GetInstance()
+{
+    if ( Odometry::m_instance == nullptr )
+    {
+        Odometry::m_instance = new Odometry();
+    }
+    return Odometry::m_instance;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Odometry <<constructor>>
+// Description: This will construct and initialize the object
+//----------------------------------------------------------------------------------
+Odometry::Odometry() : m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                       m_dashboard( DashboardPublisher::GetInstance() ),
+                       m_xChannel( m_dashboard->RegisterChannel(" pose x (ft)") ),
+                       m_yChannel( m_dashboard->RegisterChannel(" pose y (ft)") ),
+                       m_headingChannel( m_dashboard->RegisterChannel(" pose heading (deg)") ),
+                       m_pose(),
+                       m_lastLeftDistance( 0.0 ),
+                       m_lastRightDistance( 0.0 ),
+                       m_initialized( false ),
+                       m_published(),
+                       m_resets(),
+                       m_resetPending( false )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Update
+// Description: Moves the pose by how far each side drove since the last update.
+//              Only call this from the thread that samples the drive chassis.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Odometry::Update
+(
+    const InputSnapshotData&    inputs      // <I> - chassis values just sampled
+)
+{
+    if ( m_resetPending.exchange( false, std::memory_order_acquire ) )
+    {
+        RobotPose reset;
+        if ( m_resets.Read( reset ) )
+        {
+            m_pose.x       = reset.x;
+            m_pose.y       = reset.y;
+            m_pose.heading = reset.heading;
+        }
+    }
+
+    float left  = inputs.leftDistance  - m_lastLeftDistance;
+    float right = inputs.rightDistance - m_lastRightDistance;
+    m_lastLeftDistance  = inputs.leftDistance;
+    m_lastRightDistance = inputs.rightDistance;
+
+    if ( m_initialized && fabs( left ) <= MAX_STEP && fabs( right ) <= MAX_STEP )
+    {
+        // Follow the arc: move along the average heading of this step
+        float distance = ( left + right ) / 2.0;
+        float turn     = ( right - left ) / m_chassis->GetTrackWidth();
+        float heading  = m_pose.heading + turn / 2.0;
+
+        m_pose.x       += distance * cos( heading );
+        m_pose.y       += distance * sin( heading );
+        m_pose.heading += turn;
+    }
+    m_initialized = true;
+
+    m_pose.timestamp       = inputs.chassisTimestamp;
+    m_pose.velocity        = ( inputs.leftState.velocity + inputs.rightState.velocity ) / 2.0;
+    m_pose.angularVelocity = ( inputs.rightState.velocity - inputs.leftState.velocity ) / m_chassis->GetTrackWidth();
+    m_published.Write( m_pose );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetPose
+// Description: Copies the latest pose.  This can be called from any thread.
+// Returns:     bool    true  = pose copied
+//                      false = there hasn't been an update yet
+//----------------------------------------------------------------------------------
+bool Odometry::GetPose
+(
+    RobotPose&      pose            // <O> - latest pose
+) const
+{
+    return m_published.Read( pose );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ResetPose
+// Description: Moves the robot to a known pose (e.g. its starting position).  The
+//              next Update() starts from here.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Odometry::ResetPose
+(
+    float           x,              // <I> - feet forward
+    float           y,              // <I> - feet to the left
+    float           heading         // <I> - radians counterclockwise
+)
+{
+    RobotPose reset = RobotPose();
+    reset.x       = x;
+    reset.y       = y;
+    reset.heading = heading;
+    m_resets.Write( reset );
+    m_resetPending.store( true, std::memory_order_release );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Publish
+// Description: Sends the latest pose to the dashboard
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Odometry::Publish()
+{
+    RobotPose pose;
+    if ( GetPose( pose ) )
+    {
+        m_dashboard->PutNumber( m_xChannel, pose.x );
+        m_dashboard->PutNumber( m_yChannel, pose.y );
+        m_dashboard->PutNumber( m_headingChannel, pose.heading * 180.0 / M_PI );
+    }
+}
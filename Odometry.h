@@ -0,0 +1,144 @@
+/*=============================================================================================
+ * Odometry.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This keeps track of where the robot is on the field by integrating the left and right side
+ * encoder distances.  Each update moves the pose along the arc the two sides drove:
+ *
+ *      distance = ( left + right ) / 2
+ *      turn     = ( right - left ) / track width
+ *      x       += distance * cos( heading + turn / 2 )
+ *      y       += distance * sin( heading + turn / 2 )
+ *      heading += turn
+ *
+ * x is forward and y is to the left of where the robot was when the pose was last reset, and
+ * the heading is counterclockwise (radians).  It is a Singleton.
+ *
+ * Update() is called by whichever thread samples the drive chassis (the drive task when the
+ * ControlLoop is running), right after the sample.  Any thread can read the latest pose with
+ * GetPose(); the reads never block or lock.  ResetPose() can also be called from any one
+ * thread; the new pose is picked up by the next Update().
+ *=============================================================================================*/
+
+#ifndef SRC_ODOMETRY_H_
+#define SRC_ODOMETRY_H_
+
+// Standard includes
+#include <atomic>                   // std::atomic
+
+// Team 302 includes
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
+#include <DoubleBuffer.h>           // Passes the pose between threads
+#include <IChassis.h>
+#include <InputSnapshot.h>
+
+struct RobotPose
+{
+    double      timestamp;          // FPGA time (seconds) of the chassis sample
+    float       x;                  // feet forward
+    float       y;                  // feet to the left
+    float       heading;            // radians counterclockwise
+    float       velocity;           // feet per second forward
+    float       angularVelocity;    // radians per second counterclockwise
+};
+
+class Odometry
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetInstance
+        // Description: If there isn't an instance of this class, it will create one.  The
+        //              single class instance will be returned.
+        // Returns:     Odometry*   instance of this class
+        //----------------------------------------------------------------------------------
+        static Odometry* GetInstance();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Update
+        // Description: Moves the pose by how far each side drove since the last update.
+        //              Only call this from the thread that samples the drive chassis.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Update
+        (
+            const InputSnapshotData&    inputs      // <I> - chassis values just sampled
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetPose
+        // Description: Copies the latest pose.  This can be called from any thread.
+        // Returns:     bool    true  = pose copied
+        //                      false = there hasn't been an update yet
+        //----------------------------------------------------------------------------------
+        bool GetPose
+        (
+            RobotPose&      pose            // <O> - latest pose
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ResetPose
+        // Description: Moves the robot to a known pose (e.g. its starting position).  The
+        //              next Update() starts from here.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void ResetPose
+        (
+            float           x,              // <I> - feet forward
+            float           y,              // <I> - feet to the left
+            float           heading         // <I> - radians counterclockwise
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Publish
+        // Description: Sends the latest pose to the dashboard
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Publish();
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      Odometry <<constructor>>
+        // Description: This will construct and initialize the object
+        //----------------------------------------------------------------------------------
+        Odometry();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~Odometry <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~Odometry() = default;
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static Odometry*        m_instance;     // Singleton instance of this class
+
+        // A side can't really move this far between updates; a jump like this means the
+        // encoders were reset (e.g. IChassis::ResetDistance()), so the step is skipped
+        const float             MAX_STEP = 0.5;         // feet
+
+        IChassis*               m_chassis;
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_xChannel;
+        const DASHBOARD_CHANNEL m_yChannel;
+        const DASHBOARD_CHANNEL m_headingChannel;
+
+        // Update() thread only
+        RobotPose               m_pose;
+        float                   m_lastLeftDistance;
+        float                   m_lastRightDistance;
+        bool                    m_initialized;          // false = next update just records the distances
+
+        DoubleBuffer<RobotPose> m_published;            // update thread -> any thread
+        DoubleBuffer<RobotPose> m_resets;               // ResetPose() -> update thread
+        std::atomic<bool>       m_resetPending;
+
+        // Default methods we don't want the compiler to implement for us
+        Odometry( const Odometry& ) = delete;
+        Odometry& operator= ( const Odometry& ) = delete;
+        explicit Odometry( Odometry* other ) = delete;
+};
+
+#endif /* SRC_ODOMETRY_H_ */
@@ -0,0 +1,428 @@
+/*=============================================================================================
+ * PathFollower.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This drives the robot along a path of waypoints with pure pursuit on the Odometry pose, with
+ * the speed scheduled on the curvature of the path.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // sqrt, hypotf, fabs, fmax, cos, sin
+
+// Team 302 includes
+#include <PathFollower.h>           // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      PathFollower <<constructor>>
+// Description: This will construct the follower with the default config.  There
+//              is no path until SetPath() is called.
+//----------------------------------------------------------------------------------
+PathFollower::PathFollower
+(
+    IChassis*           chassis         // <I> - chassis to drive (or a simulated one)
+) : m_chassis( chassis ),
+    m_config(),
+    m_feedforward(),
+    m_trackWidth( chassis->GetTrackWidth() ),
+    m_count( 0 ),
+    m_reversed( false ),
+    m_x(),
+    m_y(),
+    m_distance(),
+    m_velocity(),
+    m_done( true ),
+    m_started( false ),
+    m_segment( 0 ),
+    m_progress( 0.0 ),
+    m_curvature( 0.0 ),
+    m_lastTime( 0.0 ),
+    m_lastVelocity( 0.0 ),
+    m_lastLeft( 0.0 ),
+    m_lastRight( 0.0 )
+{
+    m_config.lookahead              = DEFAULT_LOOKAHEAD;
+    m_config.maxVelocity            = DEFAULT_MAX_VELOCITY;
+    m_config.maxAcceleration        = DEFAULT_MAX_ACCELERATION;
+    m_config.maxLateralAcceleration = DEFAULT_MAX_LATERAL_ACCELERATION;
+    m_config.goalTolerance          = DEFAULT_GOAL_TOLERANCE;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Configure
+// Description: Changes how the paths are driven.  It is used by the next SetPath().
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PathFollower::Configure
+(
+    const PathFollowerConfig&   config  // <I> - lookahead and limits
+)
+{
+    m_config = config;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetPath
+// Description: Copies the waypoints, builds the speed schedule and starts
+//              following the path from its start on the next Drive()
+// Returns:     bool    true  = path set
+//                      false = fewer than 2 or more than MAX_WAYPOINTS waypoints
+//                              (the follower is stopped)
+//----------------------------------------------------------------------------------
+bool PathFollower::SetPath
+(
+    const PathWaypoint* waypoints,      // <I> - path in the Odometry field frame
+    int                 count,          // <I> - number of waypoints
+    bool                reversed        // <I> - true = drive the path backwards
+)
+{
+    m_count = 0;
+    m_done  = true;
+    if ( waypoints == nullptr || count < 2 || count > MAX_WAYPOINTS )
+    {
+        return false;
+    }
+
+    m_count    = count;
+    m_reversed = reversed;
+    for ( int inx=0; inx<count; ++inx )
+    {
+        m_x[inx] = waypoints[inx].x;
+        m_y[inx] = waypoints[inx].y;
+        m_distance[inx] = ( inx == 0 ) ? 0.0 :
+                          m_distance[inx-1] + hypotf( m_x[inx] - m_x[inx-1], m_y[inx] - m_y[inx-1] );
+    }
+
+    // Fastest speed for the turn at each waypoint (the circle through it and its
+    // neighbors has curvature 2 * cross / ( a * b * c ))
+    m_velocity[0]       = m_config.maxVelocity;
+    m_velocity[count-1] = 0.0;
+    for ( int inx=1; inx<count-1; ++inx )
+    {
+        float ax = m_x[inx] - m_x[inx-1];
+        float ay = m_y[inx] - m_y[inx-1];
+        float bx = m_x[inx+1] - m_x[inx];
+        float by = m_y[inx+1] - m_y[inx];
+        float sides = hypotf( ax, ay ) * hypotf( bx, by ) * hypotf( ax + bx, ay + by );
+        float curvature = ( sides > 0.0 ) ? 2.0 * fabs( ax * by - ay * bx ) / sides : 0.0;
+
+        m_velocity[inx] = m_config.maxVelocity;
+        if ( curvature * m_config.maxVelocity * m_config.maxVelocity > m_config.maxLateralAcceleration )
+        {
+            m_velocity[inx] = sqrt( m_config.maxLateralAcceleration / curvature );
+        }
+    }
+
+    // Slow down in time for each waypoint after it
+    for ( int inx=count-2; inx>=0; --inx )
+    {
+        float braking = sqrt( m_velocity[inx+1] * m_velocity[inx+1] +
+                              2.0 * m_config.maxAcceleration * ( m_distance[inx+1] - m_distance[inx] ) );
+        if ( braking < m_velocity[inx] )
+        {
+            m_velocity[inx] = braking;
+        }
+    }
+
+    m_chassis->GetFeedforward( m_feedforward );
+    m_trackWidth = m_chassis->GetTrackWidth();
+
+    m_done      = false;
+    m_started   = false;
+    m_segment   = 0;
+    m_progress  = 0.0;
+    m_curvature = 0.0;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Drive
+// Description: Steers toward the lookahead point and sets the motor outputs.
+//              Call it once for each new pose.
+// Returns:     bool    true  = the end of the path was reached (motors stopped)
+//                      false = still driving
+//----------------------------------------------------------------------------------
+bool PathFollower::Drive
+(
+    const RobotPose&    pose            // <I> - latest pose from the Odometry
+)
+{
+    if ( m_done )
+    {
+        return true;
+    }
+
+    // Driving backwards is driving forwards with the robot turned around
+    float heading  = pose.heading;
+    float velocity = pose.velocity;
+    if ( m_reversed )
+    {
+        heading  += M_PI;
+        velocity  = -velocity;
+    }
+
+    double dt = 0.0;
+    if ( !m_started )
+    {
+        // Speed up from however fast the robot is already going
+        m_started      = true;
+        m_lastVelocity = velocity;
+        m_lastLeft     = 0.0;
+        m_lastRight    = 0.0;
+    }
+    else
+    {
+        dt = pose.timestamp - m_lastTime;
+        if ( dt <= 0.0 || dt > MAX_DT )
+        {
+            dt = 0.0;
+        }
+    }
+    m_lastTime = pose.timestamp;
+
+    UpdateProgress( pose.x, pose.y );
+
+    int   last      = m_count - 1;
+    float remaining = m_distance[last] - m_progress;
+    if ( remaining <= 0.0 ||
+         hypotf( m_x[last] - pose.x, m_y[last] - pose.y ) <= m_config.goalTolerance )
+    {
+        Stop();
+        return true;
+    }
+
+    // Arc through the lookahead point (in the robot's frame, y is to the left)
+    float lookX = 0.0;
+    float lookY = 0.0;
+    GetPointAt( m_progress + m_config.lookahead, lookX, lookY );
+    float dx       = lookX - pose.x;
+    float dy       = lookY - pose.y;
+    float sideways = -sin( heading ) * dx + cos( heading ) * dy;
+    float distSq   = dx * dx + dy * dy;
+    m_curvature    = ( distSq > 0.0 ) ? 2.0 * sideways / distSq : 0.0;
+
+    // Speed from the schedule, the arc and how fast the speed can change
+    float target = GetScheduledVelocity( m_progress );
+    if ( fabs( m_curvature ) * target * target > m_config.maxLateralAcceleration )
+    {
+        target = sqrt( m_config.maxLateralAcceleration / fabs( m_curvature ) );
+    }
+    float step = m_config.maxAcceleration * dt;
+    if ( target > m_lastVelocity + step )
+    {
+        target = m_lastVelocity + step;
+    }
+    else if ( target < m_lastVelocity - step )
+    {
+        target = m_lastVelocity - step;
+    }
+    if ( target < MIN_VELOCITY )
+    {
+        target = MIN_VELOCITY;
+    }
+    m_lastVelocity = target;
+
+    // Split it between the sides, slowing both if the outside one is too fast
+    float left  = target * ( 1.0 - m_curvature * m_trackWidth / 2.0 );
+    float right = target * ( 1.0 + m_curvature * m_trackWidth / 2.0 );
+    float fastest = fmax( fabs( left ), fabs( right ) );
+    if ( fastest > m_config.maxVelocity )
+    {
+        left  *= m_config.maxVelocity / fastest;
+        right *= m_config.maxVelocity / fastest;
+    }
+
+    if ( m_reversed )
+    {
+        // Turned around, the robot's left side is the path's right side
+        SetSides( -right, -left, dt );
+    }
+    else
+    {
+        SetSides( left, right, dt );
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stop
+// Description: Stops following the path and stops the drive motors
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PathFollower::Stop()
+{
+    m_done         = true;
+    m_curvature    = 0.0;
+    m_lastVelocity = 0.0;
+    m_chassis->SetMotorSpeeds( 0.0, 0.0 );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsDone
+// Description: Checks whether the path is finished (or there is no path)
+// Returns:     bool    true  = not following a path
+//----------------------------------------------------------------------------------
+bool PathFollower::IsDone() const
+{
+    return m_done;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRemainingDistance
+// Description: Returns how far along the path is left to go as of the last Drive()
+// Returns:     float   feet
+//----------------------------------------------------------------------------------
+float PathFollower::GetRemainingDistance() const
+{
+    if ( m_count < 2 || m_progress >= m_distance[m_count-1] )
+    {
+        return 0.0;
+    }
+    return m_distance[m_count-1] - m_progress;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetCurvature
+// Description: Returns the curvature of the arc steered by the last Drive()
+// Returns:     float   1 / feet (positive turns counterclockwise)
+//----------------------------------------------------------------------------------
+float PathFollower::GetCurvature() const
+{
+    return m_curvature;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      UpdateProgress
+// Description: Moves the closest point on the path forward to the robot
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PathFollower::UpdateProgress
+(
+    float               x,              // <I> - robot position (feet forward)
+    float               y               // <I> - robot position (feet to the left)
+)
+{
+    int   lastSegment = m_count - 2;
+    int   endSegment  = m_segment + SEARCH_SEGMENTS;
+    if ( endSegment > lastSegment )
+    {
+        endSegment = lastSegment;
+    }
+
+    float bestDistSq = -1.0;
+    for ( int seg=m_segment; seg<=endSegment; ++seg )
+    {
+        float segX   = m_x[seg+1] - m_x[seg];
+        float segY   = m_y[seg+1] - m_y[seg];
+        float length = m_distance[seg+1] - m_distance[seg];
+        float along  = 0.0;
+        if ( length > 0.0 )
+        {
+            along = ( ( x - m_x[seg] ) * segX + ( y - m_y[seg] ) * segY ) / length;
+        }
+
+        // Only the last segment carries on past its end (that is how the end is passed)
+        if ( along < 0.0 )
+        {
+            along = 0.0;
+        }
+        else if ( along > length && seg != lastSegment )
+        {
+            along = length;
+        }
+
+        float fraction = ( length > 0.0 ) ? along / length : 0.0;
+        float offX     = x - ( m_x[seg] + segX * fraction );
+        float offY     = y - ( m_y[seg] + segY * fraction );
+        float distSq   = offX * offX + offY * offY;
+        float progress = m_distance[seg] + along;
+        if ( ( bestDistSq < 0.0 || distSq < bestDistSq ) && progress >= m_progress )
+        {
+            bestDistSq = distSq;
+            m_segment  = seg;
+            m_progress = progress;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetPointAt
+// Description: Finds the point a distance along the path (past the end, along the
+//              direction of the last segment)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PathFollower::GetPointAt
+(
+    float               distance,       // <I> - feet along the path
+    float&              x,              // <O> - feet forward
+    float&              y               // <O> - feet to the left
+) const
+{
+    int seg = m_segment;
+    while ( seg < m_count - 2 && distance > m_distance[seg+1] )
+    {
+        ++seg;
+    }
+
+    float length   = m_distance[seg+1] - m_distance[seg];
+    float fraction = ( length > 0.0 ) ? ( distance - m_distance[seg] ) / length : 0.0;
+    x = m_x[seg] + ( m_x[seg+1] - m_x[seg] ) * fraction;
+    y = m_y[seg] + ( m_y[seg+1] - m_y[seg] ) * fraction;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetScheduledVelocity
+// Description: Returns the fastest the robot can go at a distance along the path
+//              and still make the speeds of the waypoints after it
+// Returns:     float   feet per second
+//----------------------------------------------------------------------------------
+float PathFollower::GetScheduledVelocity
+(
+    float               distance        // <I> - feet along the path
+) const
+{
+    // The segments are straight, so only the braking for the next waypoint (which
+    // already brakes for the ones after it) limits the speed
+    int   next     = ( m_segment + 1 < m_count ) ? m_segment + 1 : m_count - 1;
+    float toNext   = m_distance[next] - distance;
+    float velocity = m_velocity[next] * m_velocity[next];
+    if ( toNext > 0.0 )
+    {
+        velocity += 2.0 * m_config.maxAcceleration * toNext;
+    }
+    velocity = sqrt( velocity );
+    return ( velocity < m_config.maxVelocity ) ? velocity : m_config.maxVelocity;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetSides
+// Description: Turns the side speeds into motor outputs with the feedforward
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PathFollower::SetSides
+(
+    float               leftVelocity,   // <I> - feet per second (positive is forward)
+    float               rightVelocity,  // <I> - feet per second (positive is forward)
+    double              dt              // <I> - seconds since the last Drive() (0.0 = unknown)
+)
+{
+    float leftAccel  = ( dt > 0.0 ) ? ( leftVelocity - m_lastLeft ) / dt : 0.0;
+    float rightAccel = ( dt > 0.0 ) ? ( rightVelocity - m_lastRight ) / dt : 0.0;
+    m_lastLeft  = leftVelocity;
+    m_lastRight = rightVelocity;
+
+    float leftVolts  = m_feedforward.kV * leftVelocity + m_feedforward.kA * leftAccel;
+    float rightVolts = m_feedforward.kV * rightVelocity + m_feedforward.kA * rightAccel;
+    if ( leftVelocity != 0.0 )
+    {
+        leftVolts += ( leftVelocity > 0.0 ) ? m_feedforward.kS : -m_feedforward.kS;
+    }
+    if ( rightVelocity != 0.0 )
+    {
+        rightVolts += ( rightVelocity > 0.0 ) ? m_feedforward.kS : -m_feedforward.kS;
+    }
+
+    m_chassis->SetMotorSpeeds( leftVolts / NOMINAL_VOLTAGE, rightVolts / NOMINAL_VOLTAGE );
+}
@@ -0,0 +1,238 @@
+/*=============================================================================================
+ * PathFollower.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This drives the robot along a path of waypoints with pure pursuit.  Each Drive() takes the
+ * robot pose from the Odometry and:
+ *
+ *  - finds the closest point on the path (it only moves forward, a few segments at a time, so
+ *    a path that crosses itself is still followed in order)
+ *  - picks the point lookahead feet further along the path (past the last waypoint the path
+ *    carries on in a straight line) and steers on the arc that goes through it:
+ *
+ *          curvature = 2 * sideways distance to the point / distance to the point^2
+ *
+ *  - sets the speed from a schedule built when the path is set: each waypoint can only be
+ *    taken as fast as the lateral acceleration allows for the turn there, and the robot
+ *    slows down at maxAcceleration to make each waypoint's speed and to stop at the end.
+ *    The speed is also limited for the arc being driven (so the robot slows down while it
+ *    gets back onto the path) and can only change by maxAcceleration each second.
+ *  - splits the speed between the sides for the curvature and turns each side's speed and
+ *    acceleration into a motor output with the chassis feedforward (IChassis::GetFeedforward)
+ *
+ * The path is done when the robot is within goalTolerance of the last waypoint or has driven
+ * past it; the motors are then stopped.
+ *
+ * Nothing here reads the clock or any hardware except through the pose and the IChassis it
+ * was given, so the same poses always give the same motor outputs and it can be driven
+ * against a simulated chassis.  Paths can have at most MAX_WAYPOINTS waypoints; they are
+ * copied into fixed arrays, so nothing is allocated while driving.
+ *
+ * SetPath(), Drive() and Stop() should all be called from the same thread (the one that
+ * samples the drive chassis).
+ *=============================================================================================*/
+
+#ifndef SRC_PATHFOLLOWER_H_
+#define SRC_PATHFOLLOWER_H_
+
+// Team 302 includes
+#include <IChassis.h>
+#include <Odometry.h>               // RobotPose
+
+// One point of a path, in the Odometry field frame
+struct PathWaypoint
+{
+    float       x;                  // feet forward
+    float       y;                  // feet to the left
+};
+
+// How a path is driven
+struct PathFollowerConfig
+{
+    float       lookahead;              // feet along the path to steer at
+    float       maxVelocity;            // feet per second
+    float       maxAcceleration;        // feet per second per second (speeding up and slowing down)
+    float       maxLateralAcceleration; // feet per second per second in the turns
+    float       goalTolerance;          // feet from the last waypoint that counts as there
+};
+
+class PathFollower
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      PathFollower <<constructor>>
+        // Description: This will construct the follower with the default config.  There
+        //              is no path until SetPath() is called.
+        //----------------------------------------------------------------------------------
+        PathFollower
+        (
+            IChassis*           chassis         // <I> - chassis to drive (or a simulated one)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Configure
+        // Description: Changes how the paths are driven.  It is used by the next SetPath().
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Configure
+        (
+            const PathFollowerConfig&   config  // <I> - lookahead and limits
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetPath
+        // Description: Copies the waypoints, builds the speed schedule and starts
+        //              following the path from its start on the next Drive()
+        // Returns:     bool    true  = path set
+        //                      false = fewer than 2 or more than MAX_WAYPOINTS waypoints
+        //                              (the follower is stopped)
+        //----------------------------------------------------------------------------------
+        bool SetPath
+        (
+            const PathWaypoint* waypoints,      // <I> - path in the Odometry field frame
+            int                 count,          // <I> - number of waypoints
+            bool                reversed        // <I> - true = drive the path backwards
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Drive
+        // Description: Steers toward the lookahead point and sets the motor outputs.
+        //              Call it once for each new pose.
+        // Returns:     bool    true  = the end of the path was reached (motors stopped)
+        //                      false = still driving
+        //----------------------------------------------------------------------------------
+        bool Drive
+        (
+            const RobotPose&    pose            // <I> - latest pose from the Odometry
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stop
+        // Description: Stops following the path and stops the drive motors
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stop();
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsDone
+        // Description: Checks whether the path is finished (or there is no path)
+        // Returns:     bool    true  = not following a path
+        //----------------------------------------------------------------------------------
+        bool IsDone() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetRemainingDistance
+        // Description: Returns how far along the path is left to go as of the last Drive()
+        // Returns:     float   feet
+        //----------------------------------------------------------------------------------
+        float GetRemainingDistance() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetCurvature
+        // Description: Returns the curvature of the arc steered by the last Drive()
+        // Returns:     float   1 / feet (positive turns counterclockwise)
+        //----------------------------------------------------------------------------------
+        float GetCurvature() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~PathFollower <<destructor>>
+        // Description: This will clean up the object (the motors are left as they are)
+        //----------------------------------------------------------------------------------
+        virtual ~PathFollower() = default;
+
+    private:
+        static const int    MAX_WAYPOINTS = 32;
+
+        //----------------------------------------------------------------------------------
+        // Method:      UpdateProgress
+        // Description: Moves the closest point on the path forward to the robot
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void UpdateProgress
+        (
+            float               x,              // <I> - robot position (feet forward)
+            float               y               // <I> - robot position (feet to the left)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetPointAt
+        // Description: Finds the point a distance along the path (past the end, along the
+        //              direction of the last segment)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void GetPointAt
+        (
+            float               distance,       // <I> - feet along the path
+            float&              x,              // <O> - feet forward
+            float&              y               // <O> - feet to the left
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetScheduledVelocity
+        // Description: Returns the fastest the robot can go at a distance along the path
+        //              and still make the speeds of the waypoints after it
+        // Returns:     float   feet per second
+        //----------------------------------------------------------------------------------
+        float GetScheduledVelocity
+        (
+            float               distance        // <I> - feet along the path
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      SetSides
+        // Description: Turns the side speeds into motor outputs with the feedforward
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void SetSides
+        (
+            float               leftVelocity,   // <I> - feet per second (positive is forward)
+            float               rightVelocity,  // <I> - feet per second (positive is forward)
+            double              dt              // <I> - seconds since the last Drive() (0.0 = unknown)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        const float         DEFAULT_LOOKAHEAD = 2.0;            // feet
+        const float         DEFAULT_MAX_VELOCITY = 8.0;         // feet per second
+        const float         DEFAULT_MAX_ACCELERATION = 6.0;     // feet per second per second
+        const float         DEFAULT_MAX_LATERAL_ACCELERATION = 5.0; // feet per second per second
+        const float         DEFAULT_GOAL_TOLERANCE = 0.25;      // feet
+        const float         MIN_VELOCITY = 0.5;                 // feet per second; slowest until the end is reached
+        const float         NOMINAL_VOLTAGE = 12.0;             // volts at full output
+        const int           SEARCH_SEGMENTS = 3;                // segments ahead checked for the closest point
+        const double        MAX_DT = 0.05;                      // seconds; longer gaps restart the acceleration limit
+
+        IChassis*           m_chassis;
+        PathFollowerConfig  m_config;
+        DriveFeedforward    m_feedforward;      // read when the path is set
+        float               m_trackWidth;       // feet
+
+        // Path (the distances and speeds are built by SetPath())
+        int                 m_count;
+        bool                m_reversed;
+        float               m_x[MAX_WAYPOINTS];
+        float               m_y[MAX_WAYPOINTS];
+        float               m_distance[MAX_WAYPOINTS];  // feet along the path to each waypoint
+        float               m_velocity[MAX_WAYPOINTS];  // fastest speed at each waypoint
+
+        // Following
+        bool                m_done;
+        bool                m_started;          // false = the next Drive() is the first
+        int                 m_segment;          // segment the closest point is on
+        float               m_progress;         // feet along the path to the closest point
+        float               m_curvature;        // 1 / feet
+        double              m_lastTime;         // pose timestamp of the last Drive()
+        float               m_lastVelocity;     // feet per second (along the path direction)
+        float               m_lastLeft;         // feet per second
+        float               m_lastRight;
+
+        // Default methods we don't want the compiler to implement for us
+        PathFollower() = delete;
+        PathFollower( const PathFollower& ) = delete;
+        PathFollower& operator= ( const PathFollower& ) = delete;
+};
+
+#endif /* SRC_PATHFOLLOWER_H_ */
@@ -0,0 +1,95 @@
+/*=============================================================================================
+ * PeriodicCommand.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a command that calls a function every cycle until it is cancelled.
+ *=============================================================================================*/
+
+// Team 302 includes
+#include <PeriodicCommand.h>        // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      PeriodicCommand <<constructor>>
+// Description: This will create the command
+//----------------------------------------------------------------------------------
+PeriodicCommand::PeriodicCommand
+(
+    const char*                 name,           // <I> - name of the command (string literal)
+    unsigned int                requirements,   // <I> - COMMAND_SUBSYSTEM values or'ed together
+    PROFILE_SECTION             section,        // <I> - profiler section for the runs
+    CommandRunFunction          run,            // <I> - called every cycle
+    CommandEndFunction          end             // <I> - called when the command is cut off (optional)
+) : ICommand(),
+    m_name( name ),
+    m_requirements( requirements ),
+    m_section( section ),
+    m_run( run ),
+    m_end( end )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRequirements
+// Description: This gets the subsystems the command drives
+// Returns:     unsigned int    COMMAND_SUBSYSTEM values or'ed together
+//----------------------------------------------------------------------------------
+unsigned int PeriodicCommand::GetRequirements() const
+{
+    return m_requirements;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Nothing to get ready
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PeriodicCommand::Start
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Calls the run function
+// Returns:     bool    false; the command runs until it is cancelled
+//----------------------------------------------------------------------------------
+bool PeriodicCommand::Run
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
+{
+    ScopedLoopTimer timer( m_section );
+    m_run( inputs );
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      End
+// Description: Calls the end function (if there is one)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void PeriodicCommand::End
+(
+    bool                        interrupted // <I> - true = cut off before it was done
+)
+{
+    if ( m_end )
+    {
+        m_end();
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetName
+// Description: This gets the name of the command
+// Returns:     const char*     name of the command
+//----------------------------------------------------------------------------------
+const char* PeriodicCommand::GetName() const
+{
+    return m_name;
+}
@@ -0,0 +1,114 @@
+/*=============================================================================================
+ * PeriodicCommand.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a command that calls a function every cycle until it is cancelled, so the existing
+ * mechanisms (LoadBall, SpinShooterWheel, ...) can be run by the CommandScheduler without
+ * changing them.  The functions are bound once when the robot starts, the same way the
+ * ControlLoop tasks are added to the TaskExecutor:
+ *
+ *      PeriodicCommand loader( "load ball", SUBSYSTEM_LOADER, PROFILE_LOADER,
+ *                              [this] ( const InputSnapshotData& inputs )
+ *                              {
+ *                                  m_loader->CycleLoader( inputs );
+ *                              } );
+ *
+ * Each run is timed under its LoopProfiler section.
+ *=============================================================================================*/
+
+#ifndef SRC_PERIODICCOMMAND_H_
+#define SRC_PERIODICCOMMAND_H_
+
+// Standard includes
+#include <functional>               // std::function
+
+// Team 302 includes
+#include <ICommand.h>               // Interface being implemented
+#include <LoopProfiler.h>           // Times each run
+
+typedef std::function<void( const InputSnapshotData& )> CommandRunFunction;
+typedef std::function<void()>                           CommandEndFunction;
+
+class PeriodicCommand : public ICommand
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      PeriodicCommand <<constructor>>
+        // Description: This will create the command
+        //----------------------------------------------------------------------------------
+        PeriodicCommand
+        (
+            const char*                 name,           // <I> - name of the command (string literal)
+            unsigned int                requirements,   // <I> - COMMAND_SUBSYSTEM values or'ed together
+            PROFILE_SECTION             section,        // <I> - profiler section for the runs
+            CommandRunFunction          run,            // <I> - called every cycle
+            CommandEndFunction          end = nullptr   // <I> - called when the command is cut off (optional)
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetRequirements
+        // Description: This gets the subsystems the command drives
+        // Returns:     unsigned int    COMMAND_SUBSYSTEM values or'ed together
+        //----------------------------------------------------------------------------------
+        unsigned int GetRequirements() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Nothing to get ready
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Calls the run function
+        // Returns:     bool    false; the command runs until it is cancelled
+        //----------------------------------------------------------------------------------
+        bool Run
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      End
+        // Description: Calls the end function (if there is one)
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void End
+        (
+            bool                        interrupted // <I> - true = cut off before it was done
+        ) override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      GetName
+        // Description: This gets the name of the command
+        // Returns:     const char*     name of the command
+        //----------------------------------------------------------------------------------
+        const char* GetName() const override;
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~PeriodicCommand <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~PeriodicCommand() = default;
+
+    private:
+        // Attributes
+        const char*             m_name;
+        unsigned int            m_requirements;
+        PROFILE_SECTION         m_section;
+        CommandRunFunction      m_run;
+        CommandEndFunction      m_end;
+
+        // Default methods we don't want the compiler to implement for us
+        PeriodicCommand() = delete;
+        PeriodicCommand( const PeriodicCommand& ) = delete;
+        PeriodicCommand& operator= ( const PeriodicCommand& ) = delete;
+};
+
+#endif /* SRC_PERIODICCOMMAND_H_ */
@@ -22,15 +22,25 @@
 
 // Team 302 includes
 #include <ArcadeDrive.h>
+#include <AutonRoutines.h>          // Autonomous routines picked on the dashboard
+#include <ControlLoop.h>            // Runs the drive and shooter at fixed rates on their own thread
+#include <DashboardPublisher.h>     // Sends dashboard values from a background thread
+#include <DragonTalon.h>            // Counts the Set() calls and config frames of each motor controller
+#include <DriveCharacterization.h>  // Measures the drive feedforward in test mode
 #include <FollowLine.h>
+#include <IAutonAction.h>           // Runs an autonomous routine
 #include <IChassis.h>               // Class the control the drive motors
 #include <IChassisFactory.h>        // Class constructs the correct chassis
 #include <IJoystickDrive.h>
+#include <InputSnapshot.h>          // Reads the inputs once per cycle
 #include <LineUpShooter.h>
+#include <LoopProfiler.h>           // Measures the time used by each subsystem
 #include <LoadBall.h>
+#include <Odometry.h>                // Tracks the robot pose from the drive encoders
 #include <OperatorInterface.h>
 #include <SpinShooterWheel.h>
 #include <TankDrive.h>
+#include <TrajectoryFile.h>         // Trajectories made ahead of time by the TrajectoryGenerator
 
 
 
@@ -48,6 +58,9 @@ class Robot: public IterativeRobot
         SendableChooser*    m_teleopChooser;        // Selections for teleop on the dashboard
         std::string         m_selectedTeleopMode;   // selected option on the m_teleopChooser
         */
+        // Constants for the autonomous chooser
+        const std::string   m_autonRoutineName = "Auton Routine";
+
         IJOYSTICK_DRIVE_IDENTIFIER  m_currentDriveMode; // current drive mode
         OperatorInterface*          m_oi;               // controller interface
 
@@ -56,12 +69,40 @@ class Robot: public IterativeRobot
         IJoystickDrive*             m_currentDrive;
 
         LineUpShooter*      m_shooterAlignment;
-        LoadBall*           m_loader;
         SpinShooterWheel*   m_shooterWheel;
+        LoadBall*           m_loader;           // only fires when m_shooterWheel is at speed
         FollowLine*         m_followLine;
         bool                m_autonMode;
 
+        AutonRoutines*      m_autonRoutines;        // every routine, built once
+        SendableChooser*    m_autonChooser;         // Selections for autonomous on the dashboard
+        IAutonAction*       m_autonRoutine;         // routine the control loop runs in autonomous
+
         IChassis*               m_chassis;
+        InputSnapshot*          m_snapshot;
+        Odometry*               m_odometry;
+        LoopProfiler*           m_profiler;
+        ControlLoop*            m_controlLoop;
+        DriveCharacterization*  m_characterization;
+        bool                    m_characterizationFitted;  // true = this test run was fit
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_driveModeChannel;
+        const DASHBOARD_CHANNEL m_driveTypeChannel;
+        const DASHBOARD_CHANNEL m_autonModeChannel;
+        const DASHBOARD_CHANNEL m_autonRoutineChannel;
+        const DASHBOARD_CHANNEL m_lineCalibrationChannel;
+
+        const double            m_dashboardRate = 10.0;     // Hz
+
+        // Written by the TrajectoryGenerator host tool and copied to the roboRIO
+        const char* const       m_trajectoryPath = "/home/lvuser/trajectories.bin";
+
+        // When true the drive, line following and shooter run on the control loop's
+        // fixed rate tasks; when false they run here whenever a driver station packet arrives
+        const bool              m_useControlLoop = true;
+
+        // How the line is followed in autonomous mode
+        const LINE_FOLLOW_MODE  m_lineFollowMode = CONTINUOUS_LINE_FOLLOW;
 
 
     public:
@@ -78,11 +119,26 @@ class Robot: public IterativeRobot
                   m_arcadeDrive( new ArcadeDrive()  ),
                   m_currentDrive( m_tankDrive ),
                   m_shooterAlignment( new LineUpShooter() ),
-                  m_loader( new LoadBall() ),
                   m_shooterWheel( new SpinShooterWheel() ),
+                  m_loader( new LoadBall( m_shooterWheel ) ),
                   m_followLine( new FollowLine() ),
                   m_autonMode( false ),
-                  m_chassis( IChassisFactory::GetInstance()->GetIChassis() )
+                  m_autonRoutines( new AutonRoutines( m_followLine ) ),
+                  m_autonChooser( new SendableChooser() ),
+                  m_autonRoutine( nullptr ),
+                  m_chassis( IChassisFactory::GetInstance()->GetIChassis() ),
+                  m_snapshot( InputSnapshot::GetInstance() ),
+                  m_odometry( Odometry::GetInstance() ),
+                  m_profiler( LoopProfiler::GetInstance() ),
+                  m_controlLoop( new ControlLoop( m_followLine, m_loader, m_shooterAlignment, m_shooterWheel ) ),
+                  m_characterization( new DriveCharacterization() ),
+                  m_characterizationFitted( false ),
+                  m_dashboard( DashboardPublisher::GetInstance() ),
+                  m_driveModeChannel( m_dashboard->RegisterChannel(" Drive mode") ),
+                  m_driveTypeChannel( m_dashboard->RegisterChannel(" Drive type") ),
+                  m_autonModeChannel( m_dashboard->RegisterChannel(" auton ") ),
+                  m_autonRoutineChannel( m_dashboard->RegisterChannel(" auton routine") ),
+                  m_lineCalibrationChannel( m_dashboard->RegisterChannel(" line calibration") )
 
         {
         }
@@ -96,6 +152,27 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void RobotInit()
         {
+            m_dashboard->Start( m_dashboardRate );
+            m_followLine->SetMode( m_lineFollowMode );
+
+            // map the trajectories now, so autonomous can start driving them right away
+            TrajectoryFile::GetInstance()->Open( m_trajectoryPath, m_chassis->GetTrackWidth() );
+
+            // Put the autonomous choices on the dashboard (the first one does nothing)
+            for ( int inx = 0; inx < m_autonRoutines->GetCount(); inx++ )
+            {
+                IAutonAction* routine = m_autonRoutines->GetRoutine( inx );
+                if ( inx == 0 )
+                {
+                    m_autonChooser->AddDefault( routine->GetName(), (void*)routine );
+                }
+                else
+                {
+                    m_autonChooser->AddObject( routine->GetName(), (void*)routine );
+                }
+            }
+            SmartDashboard::PutData( m_autonRoutineName, m_autonChooser );
+
             // Put the teleop choices on the dashboard
             /*
             m_teleopChooser->AddObject(m_driveJoystickArcadeDrive, (void*)&m_driveJoystickArcadeDrive );
@@ -112,6 +189,17 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void DisabledInit()
         {
+            m_controlLoop->Stop();
+            m_characterization->Stop();
+
+            // print where the loop time went while we were enabled
+            m_profiler->Dump();
+            m_controlLoop->Dump();
+            DragonTalon::DumpFrameCounts();
+
+            // learn the line tracker levels while the robot is pushed over the line
+            m_chassis->StartLineTrackerCalibration();
+            m_dashboard->PutString( m_lineCalibrationChannel, "sweeping" );
         }
 
         //----------------------------------------------------------------------------------
@@ -123,6 +211,13 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void DisabledPeriodic()
         {
+            // the control loop is stopped, so read the line trackers here and show
+            // what they see on the lights; keep the pose up to date if the robot is pushed
+            m_snapshot->Sample();
+            m_odometry->Update( m_snapshot->GetInputs() );
+            m_chassis->UpdateLineTrackerLights();
+            m_odometry->Publish();
+            m_snapshot->Publish( m_snapshot->GetInputs() );
         }
 
         //----------------------------------------------------------------------------------
@@ -133,6 +228,23 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void AutonomousInit()
         {
+            m_controlLoop->Stop();
+            FinishLineTrackerCalibration();
+
+            // the routines' waypoints are measured from where the robot starts
+            m_odometry->ResetPose( 0.0, 0.0, 0.0 );
+
+            // the control loop starts the routine with the first command that names it
+            m_autonRoutine = (IAutonAction*) m_autonChooser->GetSelected();
+            if ( m_autonRoutine == nullptr )
+            {
+                m_autonRoutine = m_autonRoutines->GetRoutine( 0 );
+            }
+            m_dashboard->PutString( m_autonRoutineChannel, m_autonRoutine->GetName() );
+            if ( m_useControlLoop )
+            {
+                m_controlLoop->Start();
+            }
         }
 
         //----------------------------------------------------------------------------------
@@ -144,6 +256,27 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void AutonomousPeriodic()
         {
+            // the routine runs in the control loop's drive task, which reads the chassis
+            // and the shooter itself; keep handing it the command so it doesn't time out
+            DriveCommand command;
+            command.followLine   = false;
+            command.drive        = nullptr;
+            command.autonRoutine = m_autonRoutine;
+            if ( m_useControlLoop )
+            {
+                m_snapshot->SampleOperatorInputs();
+                command.inputs = m_snapshot->GetInputs();
+                m_controlLoop->SetCommand( command );
+            }
+            else
+            {
+                m_snapshot->Sample();
+                command.inputs = m_snapshot->GetInputs();
+                m_odometry->Update( command.inputs );
+                m_controlLoop->RunCommands( command );
+                m_odometry->Publish();
+                m_snapshot->Publish( command.inputs );
+            }
         }
 
         //----------------------------------------------------------------------------------
@@ -160,6 +293,9 @@ class Robot: public IterativeRobot
 //          m_currentDriveMode = TANK_DRIVE;
 //          m_currentDrive = m_tankDrive;
 
+            // cut off the autonomous routine if autonomous ended before it did
+            m_controlLoop->Stop();
+
             // Run the teleop drive
             m_currentDriveMode = ARCADE_DRIVE;          // default
             m_currentDrive = m_arcadeDrive;             // default
@@ -172,6 +308,12 @@ class Robot: public IterativeRobot
                 m_currentDrive = m_tankDrive;
             }
             */
+
+            FinishLineTrackerCalibration();
+            if ( m_useControlLoop )
+            {
+                m_controlLoop->Start();
+            }
         }
 
         //----------------------------------------------------------------------------------
@@ -183,27 +325,42 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void TeleopPeriodic()
         {
-            SmartDashboard::PutNumber(" Drive mode", m_currentDriveMode );
-            SmartDashboard::PutString(" Drive type", m_currentDrive->GetIdentifier() );
+            m_profiler->PublishPeriodic();
+            ScopedLoopTimer loopTimer( PROFILE_LOOP );
 
-            m_chassis->UpdateLineTrackerLights();
-            if ( m_oi->GetRawButton( STOP_AUTON_MODE ) )
+            // Read all of the inputs once, so everything below uses the same values
+            // (the control loop reads the drive chassis and shooter itself)
             {
-                m_followLine->Stop();
-                m_autonMode = false;
+                ScopedLoopTimer timer( PROFILE_SAMPLE_INPUTS );
+                if ( m_useControlLoop )
+                {
+                    m_snapshot->SampleOperatorInputs();
+                }
+                else
+                {
+                    m_snapshot->Sample();
+                    m_odometry->Update( m_snapshot->GetInputs() );
+                }
             }
-            else if ( m_oi->GetRawButton( START_AUTON_MODE ) )
+            const InputSnapshotData& inputs = m_snapshot->GetInputs();
+
+            m_dashboard->PutNumber( m_driveModeChannel, m_currentDriveMode );
+            m_dashboard->PutString( m_driveTypeChannel, m_currentDrive->GetIdentifier() );
+
+            if ( !m_useControlLoop )
             {
-                m_autonMode = true;
+                m_chassis->UpdateLineTrackerLights();
             }
-            SmartDashboard::PutBoolean(" auton ", m_autonMode );
-
-            if ( m_autonMode )
+            if ( inputs.button[ STOP_AUTON_MODE ] )
             {
-               m_followLine->Drive();
+                m_autonMode = false;
             }
-            else
+            else if ( inputs.button[ START_AUTON_MODE ] )
             {
+                m_autonMode = true;
+            }
+            m_dashboard->PutBoolean( m_autonModeChannel, m_autonMode );
+
  //                BUTTON_STATE state = m_oi->GetButtonState( SWITCH_DRIVE_MODE );
  //                if ( state == BUTTON_PRESSED )
  //               {
@@ -227,13 +384,22 @@ class Robot: public IterativeRobot
  //                   }
  //               }
 
-                // teleop drive
-                m_currentDrive->DriveWithJoysticks();
-
-                // handle the teleop shoot code
-                m_loader->CycleLoader();
-                m_shooterAlignment->AdjustShooterPosition();
-                m_shooterWheel->SpinWheels();
+            // hand the commands their inputs; following the line takes the chassis from
+            // the joystick drive and the shooter keeps running either way
+            DriveCommand command;
+            command.followLine   = m_autonMode;
+            command.drive        = m_currentDrive;
+            command.autonRoutine = nullptr;
+            command.inputs       = inputs;
+            if ( m_useControlLoop )
+            {
+                // they run on the next pass of the control loop
+                m_controlLoop->SetCommand( command );
+            }
+            else
+            {
+                m_controlLoop->RunCommands( command );
+                m_snapshot->Publish( inputs );
             }
         }
 
@@ -245,6 +411,12 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void TestInit()
         {
+            m_controlLoop->Stop();
+            FinishLineTrackerCalibration();
+
+            // drive the characterization tests (the robot needs clear space in front of it)
+            m_characterizationFitted = false;
+            m_characterization->Start();
         }
 
         //----------------------------------------------------------------------------------
@@ -256,6 +428,34 @@ class Robot: public IterativeRobot
         //----------------------------------------------------------------------------------
         void TestPeriodic()
         {
+            m_characterization->Publish();
+            if ( m_characterization->IsDone() && !m_characterizationFitted )
+            {
+                m_characterization->Stop();
+
+                // Use the new constants right away (they are also saved for the next boot)
+                DriveFeedforward feedforward;
+                if ( m_characterization->Fit( feedforward ) )
+                {
+                    m_chassis->SetFeedforward( feedforward );
+                }
+                m_characterizationFitted = true;
+            }
+        }
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      FinishLineTrackerCalibration
+        // Description: Stops learning the line tracker levels (started in DisabledInit)
+        //              and hands the new levels to the line follower.  Trackers that
+        //              weren't swept over both white and black keep their saved levels.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void FinishLineTrackerCalibration()
+        {
+            bool calibrated = m_chassis->FinishLineTrackerCalibration();
+            m_followLine->UpdateCalibration();
+            m_dashboard->PutString( m_lineCalibrationChannel, calibrated ? "saved" : "kept previous" );
         }
 };
 
@@ -26,10 +26,43 @@
 //#define RUN_COMPETITION_BOT
 
 
+    // CAN status frame periods (ms) for a group of Talons; 0 leaves the frame at the Talon
+    // default (feedback 20 ms, quadrature encoder 100 ms, analog/temperature/battery 100 ms).
+    // DragonTalon::GetSensorPosition() and GetSensorVelocity() come from the feedback frame; a
+    // reading is at most one period old.  The quadrature encoder frame has the raw counts.
+    struct TalonStatusFrameProfile
+    {
+        int     feedbackMs;             // closed loop sensor
+        int     quadEncoderMs;          // quadrature encoder position and velocity
+        int     analogTempVbatMs;       // analog input, temperature and battery voltage
+    };
+
+
 #ifdef RUN_SOFTWARE_BOT
     const int ROBOT_CONFIGURATION = 3025;
+
+    // The shooter motors share CAN IDs with the drive motors on this robot, so they
+    // have to keep the drive rates
+    const TalonStatusFrameProfile DRIVE_STATUS_FRAMES       = { 10, 10, 0 };
+    const TalonStatusFrameProfile SHOOTER_WHEEL_STATUS_FRAMES = { 10, 10, 0 };
+
+    // The back drive motors follow the front ones (USE_DRIVE_FOLLOWERS), so their encoders are
+    // only read by the encoder health check, every 100 ms.  The shooter loader and align motors
+    // are the same Talons and don't use their sensors, so they get the same slow rates (put
+    // them back to the drive rates if the back motors stop following).
+    const TalonStatusFrameProfile DRIVE_FOLLOWER_STATUS_FRAMES = { 100, 100, 0 };
+    const TalonStatusFrameProfile MECHANISM_STATUS_FRAMES   = { 100, 100, 0 };
 #elif defined( RUN_YEAR1_BOT )
     const int ROBOT_CONFIGURATION   = 3029;
+
+    // Drive encoders (the feedback frame) as fast as the control loop can use them; the raw
+    // quadrature counts aren't read, and the shooter loader and align motors don't use their
+    // sensors, so those frames are slowed down.  The shooter wheel speed comes from the
+    // closed loop feedback frame, read at the shooter task rate.
+    const TalonStatusFrameProfile DRIVE_STATUS_FRAMES       = { 10, 250, 0 };
+    const TalonStatusFrameProfile MECHANISM_STATUS_FRAMES   = { 100, 250, 250 };
+    const TalonStatusFrameProfile SHOOTER_WHEEL_STATUS_FRAMES = { 10, 250, 250 };
+    const TalonStatusFrameProfile DRIVE_FOLLOWER_STATUS_FRAMES = { 100, 250, 250 };    // no followers on this robot
 #endif
 
 
@@ -0,0 +1,74 @@
+/*=============================================================================================
+ * ShooterSpeedMonitor.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This decides whether the shooter wheel is up to speed.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // std::fabs
+
+// Team 302 includes
+#include <ShooterSpeedMonitor.h>    // This class
+
+
+//----------------------------------------------------------------------------------
+// Method:      ShooterSpeedMonitor <<constructor>>
+// Description: This will create the monitor with the wheel not at speed
+//----------------------------------------------------------------------------------
+ShooterSpeedMonitor::ShooterSpeedMonitor() : m_inTolerance( false ),
+                                             m_inToleranceSince( 0.0 ),
+                                             m_atSpeed( false )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Update
+// Description: Checks the latest wheel speed against the target.  A target of
+//              zero (or less) is never at speed.
+// Returns:     bool    true  = wheel is at speed
+//----------------------------------------------------------------------------------
+bool ShooterSpeedMonitor::Update
+(
+    float           targetVelocity, // <I> - RPM the wheel is being held at
+    float           velocity,       // <I> - RPM measured
+    double          timestamp       // <I> - seconds when the speed was measured
+)
+{
+    if ( targetVelocity <= 0.0 || std::fabs( velocity - targetVelocity ) > AT_SPEED_TOLERANCE )
+    {
+        Reset();
+        return m_atSpeed;
+    }
+
+    if ( !m_inTolerance )
+    {
+        m_inTolerance      = true;
+        m_inToleranceSince = timestamp;
+    }
+    m_atSpeed = ( timestamp - m_inToleranceSince ) >= SETTLE_TIME;
+    return m_atSpeed;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsAtSpeed
+// Description: This gets the result of the last Update()
+// Returns:     bool    true  = wheel is at speed
+//----------------------------------------------------------------------------------
+bool ShooterSpeedMonitor::IsAtSpeed() const
+{
+    return m_atSpeed;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Reset
+// Description: Starts over with the wheel not at speed
+// Returns:     void
+//----------------------------------------------------------------------------------
+void ShooterSpeedMonitor::Reset()
+{
+    m_inTolerance = false;
+    m_atSpeed     = false;
+}
@@ -0,0 +1,76 @@
+/*=============================================================================================
+ * ShooterSpeedMonitor.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This decides whether the shooter wheel is up to speed: the measured speed has to stay
+ * within the tolerance of the target for the settle time.  A reading that passes through the
+ * target while the wheel is still speeding up (or overshooting) doesn't count, and the flag
+ * drops as soon as a shot slows the wheel down, so the next ball waits for the wheel to
+ * recover.
+ *
+ * The times come from the shooter sample timestamps, so the monitor does the same thing for
+ * the same readings.
+ *=============================================================================================*/
+
+#ifndef SRC_SHOOTERSPEEDMONITOR_H_
+#define SRC_SHOOTERSPEEDMONITOR_H_
+
+class ShooterSpeedMonitor
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      ShooterSpeedMonitor <<constructor>>
+        // Description: This will create the monitor with the wheel not at speed
+        //----------------------------------------------------------------------------------
+        ShooterSpeedMonitor();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Update
+        // Description: Checks the latest wheel speed against the target.  A target of
+        //              zero (or less) is never at speed.
+        // Returns:     bool    true  = wheel is at speed
+        //----------------------------------------------------------------------------------
+        bool Update
+        (
+            float           targetVelocity, // <I> - RPM the wheel is being held at
+            float           velocity,       // <I> - RPM measured
+            double          timestamp       // <I> - seconds when the speed was measured
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsAtSpeed
+        // Description: This gets the result of the last Update()
+        // Returns:     bool    true  = wheel is at speed
+        //----------------------------------------------------------------------------------
+        bool IsAtSpeed() const;
+
+        //----------------------------------------------------------------------------------
+        // Method:      Reset
+        // Description: Starts over with the wheel not at speed
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Reset();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~ShooterSpeedMonitor <<destructor>>
+        // Description: This will clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~ShooterSpeedMonitor() = default;
+
+    private:
+        // Attributes
+        const float     AT_SPEED_TOLERANCE = 100.0;     // RPM the wheel can be off and still shoot
+        const double    SETTLE_TIME = 0.1;              // seconds the wheel has to stay in tolerance
+
+        bool            m_inTolerance;      // true = the last reading was within the tolerance
+        double          m_inToleranceSince; // timestamp of the first reading of this stretch
+        bool            m_atSpeed;
+
+        // Default methods we don't want the compiler to implement for us
+        ShooterSpeedMonitor( const ShooterSpeedMonitor& ) = delete;
+        ShooterSpeedMonitor& operator= ( const ShooterSpeedMonitor& ) = delete;
+};
+
+#endif /* SRC_SHOOTERSPEEDMONITOR_H_ */
@@ -7,6 +7,12 @@
  * This file interacts with the hardware (motors and sensors) used to drive the robot.
  *=============================================================================================*/
 
+// Standard includes
+#include <algorithm>                        // std::max
+#include <climits>                          // INT_MAX
+#include <cmath>                            // fabs
+#include <cstdio>                           // printf
+
 // WPILib includes
 #include <CANTalon.h>                       // Motor Controllers
 #include <DigitalInput.h>
@@ -14,6 +20,7 @@
 // Team 302 includes
 #include <SoftwareTestChassis.h>            // This class'
 #include <IChassis.h>                       // Interface this class implements'
+#include <DriveCharacterization.h>          // Saved drive feedforward
 #include <LimitValue.h>                     // Contains utility to force values within the valid range
 #include <SoftwareTestBotMap.h>             // Contains the CAN IDs and Digital IO
 
@@ -23,17 +30,64 @@
 // Description: Create the motor controllers and set whether they are inverted or not.
 //----------------------------------------------------------------------------------
 SoftwareTestChassis::SoftwareTestChassis() : IChassis(),
-                                             m_frontLeftMotor( new CANTalon( LEFT_DRIVE_MOTOR ) ) ,
-                                             m_frontRightMotor( new CANTalon( RIGHT_DRIVE_MOTOR ) ),
-                                             m_backLeftMotor( new CANTalon( LEFT_DRIVE_MOTOR2 ) ),
-                                             m_backRightMotor( new CANTalon( RIGHT_DRIVE_MOTOR2 ) ),
-                                             m_bumperSwitch( new DigitalInput( GOAL_DETECTION_SENSOR ) )
-{
-    // Set whether each drive motor is inverted or not
-    m_frontLeftMotor->SetInverted( IS_LEFT_DRIVE_MOTOR_INVERTED );
-    m_frontRightMotor->SetInverted( IS_RIGHT_DRIVE_MOTOR_INVERTED );
-    m_backLeftMotor->SetInverted( IS_LEFT_DRIVE_MOTOR_INVERTED );
-    m_backRightMotor->SetInverted( IS_RIGHT_DRIVE_MOTOR_INVERTED );
+                                             m_frontLeftMotor( new DragonTalon( LEFT_DRIVE_MOTOR, "left drive" ) ) ,
+                                             m_frontRightMotor( new DragonTalon( RIGHT_DRIVE_MOTOR, "right drive" ) ),
+                                             m_backLeftMotor( new DragonTalon( LEFT_DRIVE_MOTOR2, "back left drive" ) ),
+                                             m_backRightMotor( new DragonTalon( RIGHT_DRIVE_MOTOR2, "back right drive" ) ),
+                                             m_feedforward(),
+                                             m_leftEstimator( nullptr ),
+                                             m_rightEstimator( nullptr ),
+                                             m_bumperSwitch( new DigitalInput( GOAL_DETECTION_SENSOR ) ),
+                                             m_encoderCheckCount( 0 ),
+                                             m_encodersHealthy( true )
+{
+    // Drive constants from the last characterization (nominal ones until there is one)
+    m_feedforward.kS = 0.0;
+    m_feedforward.kV = DRIVE_NOMINAL_VOLTAGE / DRIVE_MAX_VELOCITY;
+    m_feedforward.kA = m_feedforward.kV * DRIVE_TIME_CONSTANT;
+    DriveCharacterization::LoadFeedforward( m_feedforward );
+    m_leftEstimator  = new DriveSideEstimator( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+    m_rightEstimator = new DriveSideEstimator( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+
+    // Set whether each drive motor is inverted or not; start in brake mode so we don't
+    // roll until a drive asks for coast
+    const DragonTalonConfig leftConfig  = { IS_LEFT_DRIVE_MOTOR_INVERTED,  IS_LEFT_DRIVE_SENSOR_REVERSED,  CANSpeedController::kNeutralMode_Brake };
+    const DragonTalonConfig rightConfig = { IS_RIGHT_DRIVE_MOTOR_INVERTED, IS_RIGHT_DRIVE_SENSOR_REVERSED, CANSpeedController::kNeutralMode_Brake };
+    m_frontLeftMotor->Configure( leftConfig );
+    m_frontRightMotor->Configure( rightConfig );
+
+    // A follower copies its front motor's output, which is already reversed, so it is only
+    // reversed when it is mounted the other way from the front motor
+    const DragonTalonConfig backLeftConfig  = { USE_DRIVE_FOLLOWERS ? ( IS_LEFT_DRIVE_MOTOR2_INVERTED != IS_LEFT_DRIVE_MOTOR_INVERTED ) : IS_LEFT_DRIVE_MOTOR2_INVERTED,
+                                                IS_LEFT_DRIVE_SENSOR_REVERSED,  CANSpeedController::kNeutralMode_Brake };
+    const DragonTalonConfig backRightConfig = { USE_DRIVE_FOLLOWERS ? ( IS_RIGHT_DRIVE_MOTOR2_INVERTED != IS_RIGHT_DRIVE_MOTOR_INVERTED ) : IS_RIGHT_DRIVE_MOTOR2_INVERTED,
+                                                IS_RIGHT_DRIVE_SENSOR_REVERSED, CANSpeedController::kNeutralMode_Brake };
+    m_backLeftMotor->Configure( backLeftConfig );
+    m_backRightMotor->Configure( backRightConfig );
+
+    // Load the velocity gains once, so SetVelocities() only has to switch modes
+    ConfigVelocityControl( m_frontLeftMotor );
+    ConfigVelocityControl( m_frontRightMotor );
+    ConfigVelocityControl( m_backLeftMotor );
+    ConfigVelocityControl( m_backRightMotor );
+
+    // Get the encoder readings as often as the control loop runs (followers' encoders are
+    // only read by CheckDriveEncoders(), so they can be sent less often)
+    const TalonStatusFrameProfile& backFrames = USE_DRIVE_FOLLOWERS ? DRIVE_FOLLOWER_STATUS_FRAMES : DRIVE_STATUS_FRAMES;
+    m_frontLeftMotor->SetStatusFrameProfile( DRIVE_STATUS_FRAMES );
+    m_frontRightMotor->SetStatusFrameProfile( DRIVE_STATUS_FRAMES );
+    m_backLeftMotor->SetStatusFrameProfile( backFrames );
+    m_backRightMotor->SetStatusFrameProfile( backFrames );
+
+    // Have the back motors copy the output of the front motors, so only the front motors
+    // are commanded from here on (the roboRIO keeps sending the follow frame on its own)
+    if ( USE_DRIVE_FOLLOWERS )
+    {
+        m_backLeftMotor->SetControlMode( CANSpeedController::kFollower );
+        m_backLeftMotor->Set( LEFT_DRIVE_MOTOR );
+        m_backRightMotor->SetControlMode( CANSpeedController::kFollower );
+        m_backRightMotor->Set( RIGHT_DRIVE_MOTOR );
+    }
 
     ResetDistance();
 }
@@ -53,15 +107,207 @@ void SoftwareTestChassis::SetMotorSpeeds
     const float rightSideSpeeds // <I> - Speed for the right side of the robot (range -1.0 to 1.0)
 ) const
 {
-    // Make sure the left side speed is within range and then set both left motors to this speed
-    float leftSpeed = LimitValue::ForceInRange( leftSideSpeeds, -1.0, 1.0 );
-    m_frontLeftMotor->Set( leftSpeed );
-    m_backLeftMotor->Set( leftSpeed );
+    // Open loop (no-op when already in this mode)
+    m_frontLeftMotor->SetControlMode( CANSpeedController::kPercentVbus );
+    m_frontRightMotor->SetControlMode( CANSpeedController::kPercentVbus );
 
-    // Make sure the right side speed is within range and then set both right motors to this speed
+    // Make sure the side speeds are within range and then set the motors to these speeds
+    float leftSpeed  = LimitValue::ForceInRange( leftSideSpeeds, -1.0, 1.0 );
     float rightSpeed = LimitValue::ForceInRange( rightSideSpeeds, -1.0, 1.0 );
+    m_frontLeftMotor->Set( leftSpeed );
     m_frontRightMotor->Set( rightSpeed );
-    m_backRightMotor->Set( rightSpeed );
+    SetBackMotors( CANSpeedController::kPercentVbus, leftSpeed, rightSpeed );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetVelocities
+// Description: This will have the motor controllers hold the left and right side
+//              velocities with their own closed loop (PIDF on the drive encoders).
+//              The setpoints aren't negated for an inverted side: its Talon
+//              reverses the closed loop output instead.
+//              Velocities outside of the range are limited to the range.  The next
+//              call to SetMotorSpeeds() goes back to open loop.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::SetVelocities
+(
+    const float leftSideVelocity,   // <I> - feet per second for the left side (positive is forward)
+    const float rightSideVelocity   // <I> - feet per second for the right side (positive is forward)
+) const
+{
+    // Closed loop on the Talons (no-op when already in this mode)
+    m_frontLeftMotor->SetControlMode( CANSpeedController::kSpeed );
+    m_frontRightMotor->SetControlMode( CANSpeedController::kSpeed );
+
+    // The Talons want encoder counts per 0.1 sec; each one runs off its own encoder
+    float leftVelocity  = LimitValue::ForceInRange( leftSideVelocity, -DRIVE_MAX_VELOCITY, DRIVE_MAX_VELOCITY );
+    float rightVelocity = LimitValue::ForceInRange( rightSideVelocity, -DRIVE_MAX_VELOCITY, DRIVE_MAX_VELOCITY );
+    m_frontLeftMotor->Set( leftVelocity / ENCODER_VELOCITY_CONVERSION );
+    m_frontRightMotor->Set( rightVelocity / ENCODER_VELOCITY_CONVERSION );
+    SetBackMotors( CANSpeedController::kSpeed,
+                   leftVelocity / ENCODER_VELOCITY_CONVERSION,
+                   rightVelocity / ENCODER_VELOCITY_CONVERSION );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetMaxVelocity
+// Description: This will return the fastest a side can be told to go with
+//              SetVelocities()
+// Returns:     float   feet per second
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetMaxVelocity() const
+{
+    return DRIVE_MAX_VELOCITY;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      StartProfile
+// Description: This will throw away the points of any earlier motion profile and
+//              put the drive motors in motion profile mode with the output disabled.
+//              The next call to SetMotorSpeeds() or SetVelocities() leaves motion
+//              profile mode.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::StartProfile() const
+{
+    m_frontLeftMotor->SetControlMode( CANSpeedController::kMotionProfile );
+    m_frontLeftMotor->Set( CANTalon::SetValueMotionProfileDisable );
+    m_frontLeftMotor->ClearMotionProfileTrajectories();
+    m_frontLeftMotor->ClearMotionProfileHasUnderrun();
+    m_frontLeftMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+
+    m_frontRightMotor->SetControlMode( CANSpeedController::kMotionProfile );
+    m_frontRightMotor->Set( CANTalon::SetValueMotionProfileDisable );
+    m_frontRightMotor->ClearMotionProfileTrajectories();
+    m_frontRightMotor->ClearMotionProfileHasUnderrun();
+    m_frontRightMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+
+    // Followers just copy the profile output of the front motors
+    if ( !USE_DRIVE_FOLLOWERS )
+    {
+        m_backLeftMotor->SetControlMode( CANSpeedController::kMotionProfile );
+        m_backLeftMotor->Set( CANTalon::SetValueMotionProfileDisable );
+        m_backLeftMotor->ClearMotionProfileTrajectories();
+        m_backLeftMotor->ClearMotionProfileHasUnderrun();
+        m_backLeftMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+
+        m_backRightMotor->SetControlMode( CANSpeedController::kMotionProfile );
+        m_backRightMotor->Set( CANTalon::SetValueMotionProfileDisable );
+        m_backRightMotor->ClearMotionProfileTrajectories();
+        m_backRightMotor->ClearMotionProfileHasUnderrun();
+        m_backRightMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PushProfilePoint
+// Description: This will add a point to the end of the motion profile (the top
+//              buffer on the roboRIO).  Check topBufferRemaining first; a point is
+//              only added when every drive motor has room for it.
+// Returns:     bool        true  = point added
+//                          false = buffer full
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::PushProfilePoint
+(
+    const DriveProfilePoint&    point   // <I> - next point of the profile
+) const
+{
+    bool pushed = ( PushMotorProfilePoint( m_frontLeftMotor, point.leftPosition, point.leftVelocity, point.durationMs, point.isLastPoint ) &&
+                    PushMotorProfilePoint( m_frontRightMotor, point.rightPosition, point.rightVelocity, point.durationMs, point.isLastPoint ) );
+    if ( pushed && !USE_DRIVE_FOLLOWERS )
+    {
+        pushed = ( PushMotorProfilePoint( m_backLeftMotor, point.leftPosition, point.leftVelocity, point.durationMs, point.isLastPoint ) &&
+                   PushMotorProfilePoint( m_backRightMotor, point.rightPosition, point.rightVelocity, point.durationMs, point.isLastPoint ) );
+    }
+    return pushed;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ProcessProfileBuffer
+// Description: This will move points from the top buffer into the motor controllers.
+//              Call this at least twice per point duration while a profile runs.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::ProcessProfileBuffer() const
+{
+    m_frontLeftMotor->ProcessMotionProfileBuffer();
+    m_frontRightMotor->ProcessMotionProfileBuffer();
+    if ( !USE_DRIVE_FOLLOWERS )
+    {
+        m_backLeftMotor->ProcessMotionProfileBuffer();
+        m_backRightMotor->ProcessMotionProfileBuffer();
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetProfileStatus
+// Description: This will return the state of the motion profile buffers
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::GetProfileStatus
+(
+    DriveProfileStatus&         status  // <O> - buffer state of the drive motors
+) const
+{
+    status.topBufferRemaining = INT_MAX;
+    status.bottomBufferCount  = INT_MAX;
+    status.hasUnderrun        = false;
+    status.isLastPointActive  = true;
+
+    AddMotorProfileStatus( m_frontLeftMotor, status );
+    AddMotorProfileStatus( m_frontRightMotor, status );
+    if ( !USE_DRIVE_FOLLOWERS )
+    {
+        AddMotorProfileStatus( m_backLeftMotor, status );
+        AddMotorProfileStatus( m_backRightMotor, status );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetProfileOutput
+// Description: This will start, hold or stop running the loaded motion profile
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::SetProfileOutput
+(
+    DRIVE_PROFILE_OUTPUT        output  // <I> - what the motors should do
+) const
+{
+    CANTalon::SetValueMotionProfile value = CANTalon::SetValueMotionProfileDisable;
+    switch ( output )
+    {
+        case PROFILE_OUTPUT_ENABLE:
+            value = CANTalon::SetValueMotionProfileEnable;
+            break;
+
+        case PROFILE_OUTPUT_HOLD:
+            value = CANTalon::SetValueMotionProfileHold;
+            break;
+
+        default:
+            break;
+    }
+
+    // These are mode codes, not outputs, so they are the same for an inverted side
+    m_frontLeftMotor->Set( value );
+    m_frontRightMotor->Set( value );
+    if ( !USE_DRIVE_FOLLOWERS )
+    {
+        m_backLeftMotor->Set( value );
+        m_backRightMotor->Set( value );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsInProfile
+// Description: This will check whether the drive motors are in motion profile mode
+//              (StartProfile() was called and SetMotorSpeeds() or SetVelocities()
+//              hasn't been called since), so a motion profile owns them
+// Returns:     bool        true  = motion profile mode
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::IsInProfile() const
+{
+    return ( m_frontLeftMotor->GetControlMode() == CANSpeedController::kMotionProfile );    // cached, so no CAN traffic
 }
 
 //----------------------------------------------------------------------------------
@@ -76,6 +322,10 @@ void SoftwareTestChassis::ResetDistance()
     m_frontRightMotor->SetPosition( 0 );
     m_backLeftMotor->SetPosition( 0 );
     m_backRightMotor->SetPosition( 0 );
+
+    // The encoders start out agreeing again
+    m_encoderCheckCount = 0;
+    m_encodersHealthy   = true;
 }
 
 //----------------------------------------------------------------------------------
@@ -87,8 +337,9 @@ void SoftwareTestChassis::ResetDistance()
 //----------------------------------------------------------------------------------
 float SoftwareTestChassis::GetLeftSideDistance() const
 {
-    int frontEncoderCounts = m_frontLeftMotor->GetEncPosition();
-    int rearEncoderCounts  = m_backLeftMotor->GetEncPosition();
+    // Followers' encoders are only read by CheckDriveEncoders()
+    int frontEncoderCounts = m_frontLeftMotor->GetSensorPosition();
+    int rearEncoderCounts  = USE_DRIVE_FOLLOWERS ? frontEncoderCounts : m_backLeftMotor->GetSensorPosition();
     return ConvertEncoderCountsToDistance( frontEncoderCounts, rearEncoderCounts );
 }
 
@@ -101,8 +352,9 @@ float SoftwareTestChassis::GetLeftSideDistance() const
 //----------------------------------------------------------------------------------
 float SoftwareTestChassis::GetRightSideDistance() const
 {
-    int frontEncoderCounts = m_frontRightMotor->GetEncPosition();
-    int rearEncoderCounts  = m_backRightMotor->GetEncPosition();
+    // Followers' encoders are only read by CheckDriveEncoders()
+    int frontEncoderCounts = m_frontRightMotor->GetSensorPosition();
+    int rearEncoderCounts  = USE_DRIVE_FOLLOWERS ? frontEncoderCounts : m_backRightMotor->GetSensorPosition();
     return ConvertEncoderCountsToDistance( frontEncoderCounts, rearEncoderCounts );
 }
 
@@ -131,8 +383,9 @@ float SoftwareTestChassis::ConvertEncoderCountsToDistance
 //----------------------------------------------------------------------------------
 float SoftwareTestChassis::GetLeftSideVelocity() const
 {
-    int frontEncoderCounts = m_frontLeftMotor->GetEncVel();
-    int rearEncoderCounts  = m_backLeftMotor->GetEncVel();
+    // Followers' encoders are only read by CheckDriveEncoders()
+    int frontEncoderCounts = m_frontLeftMotor->GetSensorVelocity();
+    int rearEncoderCounts  = USE_DRIVE_FOLLOWERS ? frontEncoderCounts : m_backLeftMotor->GetSensorVelocity();
 
     return ConvertEncoderCountsToVelocity( frontEncoderCounts, rearEncoderCounts );
 }
@@ -145,12 +398,151 @@ float SoftwareTestChassis::GetLeftSideVelocity() const
 //----------------------------------------------------------------------------------
 float SoftwareTestChassis::GetRightSideVelocity() const
 {
-    int frontEncoderCounts = m_frontRightMotor->GetEncVel();
-    int rearEncoderCounts  = m_backRightMotor->GetEncVel();
+    // Followers' encoders are only read by CheckDriveEncoders()
+    int frontEncoderCounts = m_frontRightMotor->GetSensorVelocity();
+    int rearEncoderCounts  = USE_DRIVE_FOLLOWERS ? frontEncoderCounts : m_backRightMotor->GetSensorVelocity();
 
     return ConvertEncoderCountsToVelocity( frontEncoderCounts, rearEncoderCounts );
 }
 
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideSampleAge
+// Description: This will return the expected age of a left side encoder reading
+//              (half the encoder status frame period; a reading is at most twice
+//              this old)
+// Returns:     float   seconds
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetLeftSideSampleAge() const
+{
+    return static_cast<float>( m_frontLeftMotor->GetEncoderSampleAge() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideSampleAge
+// Description: This will return the expected age of a right side encoder reading
+//              (half the encoder status frame period; a reading is at most twice
+//              this old)
+// Returns:     float   seconds
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetRightSideSampleAge() const
+{
+    return static_cast<float>( m_frontRightMotor->GetEncoderSampleAge() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideVoltage
+// Description: This will return the voltage applied to the left side motors
+// Returns:     float   volts (positive is forward)
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetLeftSideVoltage() const
+{
+    return static_cast<float>( m_frontLeftMotor->GetOutputVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideVoltage
+// Description: This will return the voltage applied to the right side motors
+// Returns:     float   volts (positive is forward)
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetRightSideVoltage() const
+{
+    return static_cast<float>( m_frontRightMotor->GetOutputVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetFeedforward
+// Description: This will return the drive feedforward constants (the last saved
+//              characterization, or the robot's nominal values)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::GetFeedforward
+(
+    DriveFeedforward&   feedforward // <O> - drive constants
+) const
+{
+    feedforward = m_feedforward;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetFeedforward
+// Description: This will start using new drive feedforward constants (e.g. a new
+//              characterization): the Talon velocity gains, the state estimates'
+//              motor model and what GetFeedforward() returns.  A path follower
+//              picks them up the next time a path is set.  Only call this while
+//              the control loop is stopped.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::SetFeedforward
+(
+    const DriveFeedforward&     feedforward // <I> - drive constants
+)
+{
+    m_feedforward = feedforward;
+    m_leftEstimator->SetModel( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+    m_rightEstimator->SetModel( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+
+    // The velocity feedforward gain comes from kV
+    ConfigVelocityControl( m_frontLeftMotor );
+    ConfigVelocityControl( m_frontRightMotor );
+    ConfigVelocityControl( m_backLeftMotor );
+    ConfigVelocityControl( m_backRightMotor );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      UpdateStateEstimates
+// Description: This will fold the latest encoder readings and applied motor voltages
+//              into the left and right side state estimates.  Call it once per sample
+//              of the chassis, from the thread that samples it.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::UpdateStateEstimates
+(
+    double              timestamp   // <I> - FPGA time (seconds) of the sample
+)
+{
+    // The output voltage comes from the same status frames as the encoders (no extra CAN traffic)
+    m_leftEstimator->Update( timestamp, GetLeftSideDistance(), GetLeftSideSampleAge(), GetLeftSideVoltage() );
+    m_rightEstimator->Update( timestamp, GetRightSideDistance(), GetRightSideSampleAge(), GetRightSideVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideState
+// Description: This will return the left side estimate from the last
+//              UpdateStateEstimates() (no hardware is read)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::GetLeftSideState
+(
+    DriveSideState&     state       // <O> - position, velocity and acceleration
+) const
+{
+    m_leftEstimator->GetState( state );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideState
+// Description: This will return the right side estimate from the last
+//              UpdateStateEstimates() (no hardware is read)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::GetRightSideState
+(
+    DriveSideState&     state       // <O> - position, velocity and acceleration
+) const
+{
+    m_rightEstimator->GetState( state );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetTrackWidth
+// Description: This will return the distance between the left and right wheels
+// Returns:     float   track width in feet
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetTrackWidth() const
+{
+    return DRIVE_TRACK_WIDTH;
+}
+
 //----------------------------------------------------------------------------------
 // Method:      ConvertEncoderCountsToVelocity
 // Description: This will average the counts and then convert that value to feet per second
@@ -205,6 +597,95 @@ bool SoftwareTestChassis::IsBumperPressed()
     return m_bumperSwitch->Get();
 }
 
+//----------------------------------------------------------------------------------
+// Method:      CheckDriveEncoders
+// Description: This will compare the drive encoders on the same side of the robot
+//              (on chassis that have more than one).  Call it once per cycle; the
+//              encoders are only compared every so often.  Once they disagree they
+//              stay unhealthy until ResetDistance() is called.
+// Returns:     bool        true  = encoders agree (or there is nothing to compare)
+//                          false = encoders on a side disagree
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::CheckDriveEncoders()
+{
+    m_encoderCheckCount++;
+    if ( m_encoderCheckCount >= ENCODER_CHECK_PERIOD )
+    {
+        m_encoderCheckCount = 0;
+
+        // Both wheels on a side are chained together, so their encoders should read
+        // the same distance (a slipping or unplugged encoder drifts away)
+        float leftError  = fabs( static_cast<float>( m_frontLeftMotor->GetSensorPosition() -
+                                                     m_backLeftMotor->GetSensorPosition() ) ) * ENCODER_DISTANCE_CONVERSION;
+        float rightError = fabs( static_cast<float>( m_frontRightMotor->GetSensorPosition() -
+                                                     m_backRightMotor->GetSensorPosition() ) ) * ENCODER_DISTANCE_CONVERSION;
+
+        // A back reading can be up to one of its (slower) status frame periods older than
+        // the front one, so allow for how far the side moves in that time
+        float leftLag    = 2.0 * ( m_backLeftMotor->GetEncoderSampleAge() - m_frontLeftMotor->GetEncoderSampleAge() );
+        float rightLag   = 2.0 * ( m_backRightMotor->GetEncoderSampleAge() - m_frontRightMotor->GetEncoderSampleAge() );
+        float leftLimit  = ENCODER_DISAGREEMENT_LIMIT + fabs( GetLeftSideVelocity() ) * std::max( leftLag, 0.0f );
+        float rightLimit = ENCODER_DISAGREEMENT_LIMIT + fabs( GetRightSideVelocity() ) * std::max( rightLag, 0.0f );
+        if ( m_encodersHealthy && ( leftError > leftLimit || rightError > rightLimit ) )
+        {
+            printf( "Drive encoders disagree: left %.2f ft  right %.2f ft\n", leftError, rightError );
+            m_encodersHealthy = false;
+        }
+    }
+    return m_encodersHealthy;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SampleLineTrackers
+// Description: This will read each of the line trackers once.  GetLineTrackerVoltage,
+//              GetLineTrackerState and UpdateLineTrackerLights use these readings
+//              until the next time this is called.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::SampleLineTrackers()
+{
+    // No-op
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerVoltage
+// Description: This will return the voltage read by the last SampleLineTrackers()
+// Returns:     float       voltage of the line tracker
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetLineTrackerVoltage
+(
+    LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+) const
+{
+    return 0.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerRate
+// Description: This will return how fast the line tracker voltage was changing at
+//              the last SampleLineTrackers()
+// Returns:     float       volts per second
+//----------------------------------------------------------------------------------
+float SoftwareTestChassis::GetLineTrackerRate
+(
+    LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+) const
+{
+    return 0.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerMask
+// Description: This will return the line trackers (from the last SampleLineTrackers())
+//              packed into a mask of LINE_MASK_ bits
+// Returns:     unsigned int    LINE_MASK_ bits
+//----------------------------------------------------------------------------------
+unsigned int SoftwareTestChassis::GetLineTrackerMask()
+{
+    // No line trackers, so always on the line
+    return ( LINE_MASK_LEFT_WHITE | LINE_MASK_CENTER_WHITE | LINE_MASK_RIGHT_WHITE );
+}
+
 //----------------------------------------------------------------------------------
 // Method:      GetLineTrackerState
 // Description: This will return the state of the line trackers
@@ -213,7 +694,7 @@ bool SoftwareTestChassis::IsBumperPressed()
 //----------------------------------------------------------------------------------
 LINE_TRACK_STATE SoftwareTestChassis::GetLineTrackerState()
 {
-    return LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE;
+    return DecodeLineTrackMask( GetLineTrackerMask() );
 }
 
 //----------------------------------------------------------------------------------
@@ -226,6 +707,146 @@ void SoftwareTestChassis::UpdateLineTrackerLights()
     // No-op
 }
 
+//----------------------------------------------------------------------------------
+// Method:      StartLineTrackerCalibration
+// Description: This will start learning the white and black levels of each line
+//              tracker.  Sweep the robot over the line while sampling the trackers.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::StartLineTrackerCalibration()
+{
+    // No-op
+}
+
+//----------------------------------------------------------------------------------
+// Method:      FinishLineTrackerCalibration
+// Description: This will stop learning the levels.  The levels of each tracker
+//              that saw both white and black are changed and saved.
+// Returns:     bool        true  = every tracker was calibrated
+//                          false = at least one tracker kept its old levels
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::FinishLineTrackerCalibration()
+{
+    // No line trackers to calibrate
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerLevels
+// Description: This will return the voltages a line tracker reads over white
+//              and over black
+// Returns:     bool        true  = levels returned
+//                          false = no such line tracker
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::GetLineTrackerLevels
+(
+    LINE_TRACKER_IDENTIFIER tracker,        // <I> - line tracker to query
+    float&                  whiteLevel,     // <O> - voltage over the line
+    float&                  blackLevel      // <O> - voltage over black
+) const
+{
+    return false;
+}
+
+
+//----------------------------------------------------------------------------------
+// Method:      PushMotorProfilePoint
+// Description: This will add one side's part of a profile point to a drive motor.
+//              The point is in the motor's closed loop sensor counts, which count
+//              up going forward on both sides, so it isn't negated for an inverted
+//              side: that side's Talon reverses its closed loop output.
+// Returns:     bool        true  = point added
+//                          false = buffer full
+//----------------------------------------------------------------------------------
+bool SoftwareTestChassis::PushMotorProfilePoint
+(
+    DragonTalon*    motor,          // <I> - drive motor
+    float           position,       // <I> - feet (positive is forward)
+    float           velocity,       // <I> - feet per second (positive is forward)
+    int         durationMs,         // <I> - how long the point lasts
+    bool        isLastPoint         // <I> - true = last point of the profile
+) const
+{
+    // The Talons want closed loop sensor counts and counts per 0.1 sec (the same
+    // counts GetLeftSideDistance() and GetRightSideDistance() read, so a profile
+    // started from the current distances starts where the Talon is)
+    CANTalon::TrajectoryPoint point;
+    point.position          = position / ENCODER_DISTANCE_CONVERSION;
+    point.velocity          = velocity / ENCODER_VELOCITY_CONVERSION;
+    point.timeDurMs         = durationMs;
+    point.profileSlotSelect = DRIVE_VELOCITY_PROFILE;
+    point.velocityOnly      = false;
+    point.isLastPoint       = isLastPoint;
+    point.zeroPos           = false;
+    return motor->PushMotionProfileTrajectory( point );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddMotorProfileStatus
+// Description: This will fold a drive motor's buffer state into the status (keeping
+//              the worst of the motors)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::AddMotorProfileStatus
+(
+    CANTalon*           motor,      // <I> - drive motor
+    DriveProfileStatus& status      // <IO> - status of the motors checked so far
+) const
+{
+    CANTalon::MotionProfileStatus motorStatus;
+    motor->GetMotionProfileStatus( motorStatus );
+
+    int topBufferRemaining = static_cast<int>( motorStatus.topBufferRem );
+    int bottomBufferCount  = static_cast<int>( motorStatus.btmBufferCnt );
+    status.topBufferRemaining = ( topBufferRemaining < status.topBufferRemaining ) ? topBufferRemaining : status.topBufferRemaining;
+    status.bottomBufferCount  = ( bottomBufferCount < status.bottomBufferCount ) ? bottomBufferCount : status.bottomBufferCount;
+    status.hasUnderrun        = status.hasUnderrun || motorStatus.hasUnderrun;
+    status.isLastPointActive  = status.isLastPointActive &&
+                                motorStatus.activePointValid && motorStatus.activePoint.isLastPoint;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetBackMotors
+// Description: This will drive the back motors the same as the front motors.  When
+//              they are followers they already copy the front motors, so nothing
+//              is sent.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::SetBackMotors
+(
+    CANSpeedController::ControlMode mode,       // <I> - control mode of the front motors
+    float                           leftValue,  // <I> - left side output in the units of the mode
+    float                           rightValue  // <I> - right side output in the units of the mode
+) const
+{
+    if ( !USE_DRIVE_FOLLOWERS )
+    {
+        m_backLeftMotor->SetControlMode( mode );
+        m_backRightMotor->SetControlMode( mode );
+        m_backLeftMotor->Set( leftValue );
+        m_backRightMotor->Set( rightValue );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ConfigVelocityControl
+// Description: This will point the Talon's closed loop at the drive encoder and
+//              load the drive velocity gains.  The sensor and output directions
+//              come from the motor's Configure(), so the setpoints are positive
+//              forward on both sides.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestChassis::ConfigVelocityControl
+(
+    CANTalon*   motor               // <I> - drive motor to configure
+) const
+{
+    motor->SetFeedbackDevice( CANTalon::QuadEncoder );
+    motor->SelectProfileSlot( DRIVE_VELOCITY_PROFILE );
+    // The feedforward gain is full output (1023) per encoder count per 0.1 sec at kV
+    float feedforwardGain = 1023.0 * m_feedforward.kV / DRIVE_NOMINAL_VOLTAGE * ENCODER_VELOCITY_CONVERSION;
+    motor->SetPID( DRIVE_VELOCITY_P, DRIVE_VELOCITY_I, DRIVE_VELOCITY_D, feedforwardGain );
+}
 
 //----------------------------------------------------------------------------------
 // Method:      ~SoftwareTestChassis <<Destructor>>
@@ -244,5 +865,11 @@ SoftwareTestChassis::~SoftwareTestChassis()
 
     delete m_backRightMotor;
     m_backRightMotor = nullptr;
+
+    delete m_leftEstimator;
+    m_leftEstimator = nullptr;
+
+    delete m_rightEstimator;
+    m_rightEstimator = nullptr;
 }
 
@@ -17,6 +17,10 @@
 #include <LimitValue.h>                     // Contains utility to force values within the valid range
 #include <SoftwareTestBotMap.h>             // Contains the CAN IDs and Digital IO
 
+// The feedforward gain is full output (1023) per encoder count per 0.1 sec at the full
+// output speed
+static const float SHOOTER_VELOCITY_F = 1023.0 * SHOOTER_VELOCITY_CONVERSION / SHOOTER_WHEEL_MAX_RPM;
+
 
 //----------------------------------------------------------------------------------
 // Method:      SoftwareTestShooter <<Constructor>>
@@ -25,31 +29,48 @@
 SoftwareTestShooter::SoftwareTestShooter() : IShooter(),
                                              m_shooterWheel( nullptr ) ,
                                              m_shooterLoader( nullptr ),
-                                             m_shooterAlign( nullptr )
+                                             m_shooterAlign( nullptr ),
+                                             m_loaderPosition( nullptr ),
+                                             m_loaderReturns( 0 ),
+                                             m_loaderReturnTimestamp( 0.0 )
 {
 
     // Shooter Alignment
-    m_shooterAlign   = new CANTalon( SHOOTER_ALIGN_MOTOR );                         // create object
+    m_shooterAlign   = new DragonTalon( SHOOTER_ALIGN_MOTOR, "shooter align" );     // create object
     m_shooterAlign->SetInverted( IS_SHOOTER_ALIGN_MOTOR_INVERTED );                 // make sure it moves in the correct direction
     m_shooterAlign->ConfigNeutralMode( CANSpeedController::kNeutralMode_Brake );    // Make it stop immediately
+    m_shooterAlign->SetStatusFrameProfile( MECHANISM_STATUS_FRAMES );              // sensors aren't used
 
     // Shooter wheels
-    m_shooterWheel  = new CANTalon( SHOOTER_WHEEL_MOTOR );                          // create object
-    m_shooterWheel->SetInverted( IS_SHOOTER_WHEEL_MOTOR_INVERTED );                 // make sure the wheel is spinning in the correct direction
-    m_shooterWheel->ConfigNeutralMode( CANSpeedController::kNeutralMode_Coast );    // Let wheel coast after power is stopped
+    m_shooterWheel  = new DragonTalon( SHOOTER_WHEEL_MOTOR, "shooter wheel" );      // create object
+    // The Talon reverses its closed loop output for an inverted wheel and the encoder counts
+    // up when shooting, so positive RPM setpoints and the measured speed both mean shooting
+    // (what ShooterSpeedMonitor compares); coast after power is stopped
+    const DragonTalonConfig wheelConfig = { IS_SHOOTER_WHEEL_MOTOR_INVERTED, IS_SHOOTER_WHEEL_SENSOR_REVERSED, CANSpeedController::kNeutralMode_Coast };
+    m_shooterWheel->Configure( wheelConfig );
+    m_shooterWheel->SetStatusFrameProfile( SHOOTER_WHEEL_STATUS_FRAMES );          // speed for the closed loop and at speed check
+    m_shooterWheel->SetFeedbackDevice( CANTalon::QuadEncoder );                    // closed loop on the wheel encoder
+    m_shooterWheel->SelectProfileSlot( SHOOTER_VELOCITY_PROFILE );
+    m_shooterWheel->SetPID( SHOOTER_VELOCITY_P, SHOOTER_VELOCITY_I, SHOOTER_VELOCITY_D, SHOOTER_VELOCITY_F );
 
     // Shooter Loader
-    m_shooterLoader = new CANTalon( SHOOTER_LOAD_MOTOR );                           // create object
+    m_shooterLoader = new DragonTalon( SHOOTER_LOAD_MOTOR, "shooter loader" );      // create object
     m_shooterLoader->SetInverted( IS_SHOOTER_LOAD_MOTOR_INVERTED );                 // make sure rotating in the correct direction
     m_shooterLoader->ConfigNeutralMode( CANSpeedController::kNeutralMode_Brake );   // Make it stop immediately
+    m_shooterLoader->SetStatusFrameProfile( MECHANISM_STATUS_FRAMES );             // sensors aren't used
 
+    // Loader sensor: count the edge where the loader gets back to its load position (the
+    // sensor reads true in position, so it is the rising edge)
     m_loaderPosition = new DigitalInput( BALL_LOAD_SENSOR );
+    m_loaderPosition->RequestInterrupts( LoaderReturned, this );
+    m_loaderPosition->SetUpSourceEdge( true, false );
+    m_loaderPosition->EnableInterrupts();
 }
 
 
 //----------------------------------------------------------------------------------
 // Method:      SetShooterSpeed
-// Description: This will set the motor speed for the shooter wheel.
+// Description: This will set the motor speed for the shooter wheel (open loop).
 //              If a value is specified that is outside the range, the value
 //              used will be the closest bounding value (e.g. if 2.0 is passed in and
 //              the range is -1.0 to 1.0, 1.0 will be used.
@@ -60,9 +81,40 @@ void SoftwareTestShooter::SetShooterSpeed
     const float speed   // <I> - Speed for the shooter wheel (range -1.0 to 1.0)
 ) const
 {
+    m_shooterWheel->SetControlMode( CANSpeedController::kPercentVbus ); // no-op when already in this mode
     m_shooterWheel->Set( LimitValue::ForceInRange( speed, -1.0, 1.0 ) );
 }
 
+//----------------------------------------------------------------------------------
+// Method:      SetShooterVelocity
+// Description: This will have the motor controller hold the shooter wheel speed with
+//              its own closed loop (PIDF on the wheel encoder).  Speeds outside of the
+//              range are limited to the range.  The next call to SetShooterSpeed()
+//              goes back to open loop.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestShooter::SetShooterVelocity
+(
+    const float rpm     // <I> - Wheel speed (range -SHOOTER_WHEEL_MAX_RPM to SHOOTER_WHEEL_MAX_RPM)
+) const
+{
+    m_shooterWheel->SetControlMode( CANSpeedController::kSpeed );       // no-op when already in this mode
+
+    // The Talon wants encoder counts per 0.1 sec
+    float velocity = LimitValue::ForceInRange( rpm, -SHOOTER_WHEEL_MAX_RPM, SHOOTER_WHEEL_MAX_RPM );
+    m_shooterWheel->Set( velocity / SHOOTER_VELOCITY_CONVERSION );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetShooterVelocity
+// Description: This will return the shooter wheel speed measured by its encoder
+// Returns:     float       RPM (positive is shooting)
+//----------------------------------------------------------------------------------
+float SoftwareTestShooter::GetShooterVelocity() const
+{
+    return m_shooterWheel->GetSensorVelocity() * SHOOTER_VELOCITY_CONVERSION;
+}
+
 //----------------------------------------------------------------------------------
 // Method:      SetBallLoadMotor
 // Description: This will run the loader motor.
@@ -87,6 +139,47 @@ bool SoftwareTestShooter::IsLoaderInPosition() const
     return m_loaderPosition->Get();
 }
 
+//----------------------------------------------------------------------------------
+// Method:      GetLoaderReturns
+// Description: This will return how many times the loader has come back to its load
+//              position.  The sensor edge is caught by an interrupt, so a cycle is
+//              counted even when the loader leaves and comes back between samples.
+// Returns:     unsigned int    returns since the robot started (wraps around)
+//----------------------------------------------------------------------------------
+unsigned int SoftwareTestShooter::GetLoaderReturns() const
+{
+    return m_loaderReturns;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLoaderReturnTimestamp
+// Description: This will return when the loader last came back to its load position.
+// Returns:     double      FPGA time (seconds) of the sensor edge
+//----------------------------------------------------------------------------------
+double SoftwareTestShooter::GetLoaderReturnTimestamp() const
+{
+    return m_loaderReturnTimestamp;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      LoaderReturned
+// Description: Interrupt handler for the edge where the loader gets back to its
+//              load position.  This runs on the WPILib interrupt thread.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void SoftwareTestShooter::LoaderReturned
+(
+    uint32_t    interruptAssertedMask,  // <I> - edges that fired (unused; only one is enabled)
+    void*       param                   // <I> - the shooter
+)
+{
+    SoftwareTestShooter* shooter = static_cast<SoftwareTestShooter*>( param );
+
+    // store the time before the count so a reader that sees the new count also sees its time
+    shooter->m_loaderReturnTimestamp = shooter->m_loaderPosition->ReadRisingTimestamp();
+    shooter->m_loaderReturns++;
+}
+
 //----------------------------------------------------------------------------------
 // Method:      AlignShooter
 // Description: This will set the motor speed for shooter alignment.
@@ -140,6 +233,7 @@ SoftwareTestShooter::~SoftwareTestShooter()
     delete m_shooterAlign;
     m_shooterAlign = nullptr;
 
+    m_loaderPosition->CancelInterrupts();
     delete m_loaderPosition;
     m_loaderPosition = nullptr;
 }
@@ -4,7 +4,7 @@
  *
  * File Description:
  *
- * This controls loading a ball into the shooter.
+ * This controls the shooter wheel speed and whether it is ready to fire.
  *=============================================================================================*/
 
 // Team 302 includes
@@ -12,13 +12,17 @@
 #include <IShooter.h>               // Class the control the shooter motors
 #include <IShooterFactory.h>        // Class constructs the correct chassis
 #include <OperatorInterface.h>      // Controls creating singleton of the gamepads
+#include <InputSnapshot.h>          // Inputs sampled this cycle
 
 //--------------------------------------------------------------------
 // Method:      SpinShooterWheel <<constructor>>
 // Description: This method creates and initializes the objects
 //--------------------------------------------------------------------
 SpinShooterWheel::SpinShooterWheel() : m_oi( OperatorInterface::GetInstance() ),
-                                       m_shooter( IShooterFactory::GetInstance()->GetIShooter() )
+                                       m_shooter( IShooterFactory::GetInstance()->GetIShooter() ),
+                                       m_speedMonitor(),
+                                       m_dashboard( DashboardPublisher::GetInstance() ),
+                                       m_atSpeedChannel( m_dashboard->RegisterChannel("shooter at speed") )
 {
 
 }
@@ -31,34 +35,36 @@ SpinShooterWheel::SpinShooterWheel() : m_oi( OperatorInterface::GetInstance() ),
 //              If not, stop the wheel.
 // Returns:     void
 //--------------------------------------------------------------------
-void SpinShooterWheel::SpinWheels() const
+void SpinShooterWheel::SpinWheels
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+)
 {
-    // TODO:    Define a motor speed constants in SpinShooterWheel.h
-    //
-    //          Define a float variable named speed and set it to the stopped speed (one of the
-    //          constants that should be 0.0)
-    //
-    //          Read the gamepad ...
-    //              if the SPIN_SHOOTER_WHEEL is pressed set the a speed variable to the
-    //              desired wheel speed (constant from above that should be 1.0)
-    //
-    //          call m_shooter's SetShooterSpeed method passing the speed.
-
-    float speed = m_shooterMotorSpeedStop;
-    if (m_oi->GetRawButton(SPIN_SHOOTER_WHEEL) ||
-        m_oi->GetRawButton(LOAD_BALL_BUTTON))
-    {
-        speed = m_shooterMotorSpeedGo;
-    }
-    else if ( !m_shooter->IsLoaderInPosition() )
+    // Hold the shot speed while the wheel is wanted or a ball is being loaded
+    if (inputs.button[SPIN_SHOOTER_WHEEL] ||
+        inputs.button[LOAD_BALL_BUTTON]   ||
+        !inputs.loaderInPosition )
     {
-        speed = m_shooterMotorSpeedGo;
+        m_shooter->SetShooterVelocity( m_shooterWheelVelocityGo );
+        m_speedMonitor.Update( m_shooterWheelVelocityGo, inputs.shooterVelocity, inputs.shooterTimestamp );
     }
     else
     {
-        speed = m_shooterMotorSpeedStop;
+        m_shooter->SetShooterSpeed( m_shooterMotorSpeedStop );
+        m_speedMonitor.Reset();
     }
-    m_shooter->SetShooterSpeed(speed);
+    m_dashboard->PutBoolean( m_atSpeedChannel, m_speedMonitor.IsAtSpeed() );
+}
+
+//--------------------------------------------------------------------
+// Method:      IsAtSpeed
+// Description: This method returns whether the wheel was at speed
+//              the last time SpinWheels() ran
+// Returns:     bool    true  = ready to fire
+//--------------------------------------------------------------------
+bool SpinShooterWheel::IsAtSpeed() const
+{
+    return m_speedMonitor.IsAtSpeed();
 }
 
 
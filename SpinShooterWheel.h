@@ -4,7 +4,10 @@
  *
  * File Description:
  *
- * This controls loading a ball into the shooter.
+ * This controls the shooter wheel.  The wheel speed is held by the motor controller's closed
+ * loop, and the wheel is at speed once the measured speed has settled near the target (see
+ * ShooterSpeedMonitor).  The at speed flag is published to the dashboard and LoadBall only
+ * fires a ball while it is set.
  *=============================================================================================*/
 
 #ifndef SRC_SPINSHOOTERWHEEL_H_
@@ -14,6 +17,9 @@
 //  Team 302 includes
 #include <IShooter.h>           // Class that controls the shooter motors
 #include <OperatorInterface.h>  // Controls creating singleton of the gamepads
+#include <InputSnapshot.h>      // Inputs sampled this cycle
+#include <DashboardPublisher.h> // Sends dashboard values from a background thread
+#include <ShooterSpeedMonitor.h> // Decides when the wheel is up to speed
 
 class SpinShooterWheel
 {
@@ -31,7 +37,18 @@ class SpinShooterWheel
         //              If not, stop the wheel.
         // Returns:     void
         //--------------------------------------------------------------------
-        void SpinWheels() const;
+        void SpinWheels
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        );
+
+        //--------------------------------------------------------------------
+        // Method:      IsAtSpeed
+        // Description: This method returns whether the wheel was at speed
+        //              the last time SpinWheels() ran
+        // Returns:     bool    true  = ready to fire
+        //--------------------------------------------------------------------
+        bool IsAtSpeed() const;
 
         //--------------------------------------------------------------------
         // Method:      ~SpinShooterWheel <<destructor>>
@@ -46,10 +63,13 @@ class SpinShooterWheel
         // Attributes
         OperatorInterface*      m_oi;
         IShooter*               m_shooter;
+        ShooterSpeedMonitor     m_speedMonitor;
+        DashboardPublisher*     m_dashboard;
+        const DASHBOARD_CHANNEL m_atSpeedChannel;
 
-        //These are the speeds. S= stop and G= go
+        //These are the speeds. S= stop (open loop, so the wheel coasts) and G= go (RPM)
         const float m_shooterMotorSpeedStop = 0.0;
-        const float m_shooterMotorSpeedGo = .75;
+        const float m_shooterWheelVelocityGo = 3750.0;
 
         // Default methods we don't want the compiler to implement for us
         SpinShooterWheel( const SpinShooterWheel& ) = delete;
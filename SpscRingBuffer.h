@@ -0,0 +1,99 @@
+/*=============================================================================================
+ * SpscRingBuffer.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is a fixed size, lock-free ring buffer for passing items from exactly one producer
+ * thread to exactly one consumer thread.  Neither side ever blocks or allocates: Push fails
+ * when the buffer is full and Pop fails when it is empty.
+ *
+ * SIZE must be a power of two.  One slot is always left empty to tell full from empty, so the
+ * buffer holds at most SIZE-1 items.
+ *=============================================================================================*/
+
+#ifndef SRC_SPSCRINGBUFFER_H_
+#define SRC_SPSCRINGBUFFER_H_
+
+// Standard includes
+#include <atomic>       // std::atomic
+#include <cstddef>      // size_t
+
+template <typename T, size_t SIZE>
+class SpscRingBuffer
+{
+    static_assert( SIZE >= 2 && ( SIZE & ( SIZE - 1 ) ) == 0, "SpscRingBuffer SIZE must be a power of two" );
+
+    public:
+        //------------------------------------------------------------------
+        // Method:      SpscRingBuffer     <<constructor>>
+        // Description: Create an empty buffer.
+        //------------------------------------------------------------------
+        SpscRingBuffer() : m_items(),
+                           m_head( 0 ),
+                           m_tail( 0 )
+        {
+        }
+
+        //------------------------------------------------------------------
+        // Method:      Push
+        // Description: Adds an item to the buffer.  Only call this from the
+        //              producer thread.
+        // Returns:     bool    true  = item added
+        //                      false = buffer full, item dropped
+        //------------------------------------------------------------------
+        bool Push
+        (
+            const T&    item            // <I> - item to add
+        )
+        {
+            size_t head = m_head.load( std::memory_order_relaxed );
+            size_t next = ( head + 1 ) & MASK;
+            bool   added = false;
+            if ( next != m_tail.load( std::memory_order_acquire ) )
+            {
+                m_items[head] = item;
+                m_head.store( next, std::memory_order_release );
+                added = true;
+            }
+            return added;
+        }
+
+        //------------------------------------------------------------------
+        // Method:      Pop
+        // Description: Removes the oldest item from the buffer.  Only call
+        //              this from the consumer thread.
+        // Returns:     bool    true  = item was removed and copied to item
+        //                      false = buffer empty
+        //------------------------------------------------------------------
+        bool Pop
+        (
+            T&          item            // <O> - oldest item
+        )
+        {
+            size_t tail = m_tail.load( std::memory_order_relaxed );
+            bool   removed = false;
+            if ( tail != m_head.load( std::memory_order_acquire ) )
+            {
+                item = m_items[tail];
+                m_tail.store( ( tail + 1 ) & MASK, std::memory_order_release );
+                removed = true;
+            }
+            return removed;
+        }
+
+        virtual ~SpscRingBuffer() = default;
+
+    private:
+        static const size_t MASK = SIZE - 1;
+
+        T                   m_items[SIZE];      // storage
+        std::atomic<size_t> m_head;             // next slot the producer writes
+        std::atomic<size_t> m_tail;             // next slot the consumer reads
+
+        // Default methods we don't want the compiler to implement for us
+        SpscRingBuffer( const SpscRingBuffer& ) = delete;
+        SpscRingBuffer& operator= ( const SpscRingBuffer& ) = delete;
+};
+
+#endif /* SRC_SPSCRINGBUFFER_H_ */
@@ -18,6 +18,7 @@
 #include <TankDrive.h>              // This class
 #include <IChassis.h>               // Class the control the drive motors
 #include <IChassisFactory.h>        // Class constructs the correct chassis
+#include <InputSnapshot.h>          // Inputs sampled this cycle
 #include <OperatorInterface.h>      // Class that owns the driver gamepad
 
 //--------------------------------------------------------------------
@@ -32,9 +33,7 @@ TankDrive::TankDrive() : IJoystickDrive(),
     m_oi->SetAxisProfile( TANK_DRIVE_LEFT_CONTROL, CUBIC_SCALING );
     m_oi->SetAxisProfile( TANK_DRIVE_RIGHT_CONTROL, CUBIC_SCALING );
 
-    // Set to Coast Mode
     m_chassis = IChassisFactory::GetInstance()->GetIChassis();
-    m_chassis->SetCoastMode();
 
 }
 
@@ -45,11 +44,17 @@ TankDrive::TankDrive() : IJoystickDrive(),
 //              to drive in tank drive mode.
 // Returns:     void
 //--------------------------------------------------------------------
-void TankDrive::DriveWithJoysticks() const
+void TankDrive::DriveWithJoysticks
+(
+    const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+) const
 {
     // Read the desired motor speeds
-    float leftSpeed  = m_oi->GetRawAxis( TANK_DRIVE_LEFT_CONTROL );
-    float rightSpeed  = m_oi->GetRawAxis( TANK_DRIVE_RIGHT_CONTROL );
+    float leftSpeed  = inputs.axis[ TANK_DRIVE_LEFT_CONTROL ];
+    float rightSpeed  = inputs.axis[ TANK_DRIVE_RIGHT_CONTROL ];
+
+    // Coast while driving with the joysticks (only sent when the mode changes)
+    m_chassis->SetCoastMode();
 
     // Set the motors
     m_chassis->SetMotorSpeeds( leftSpeed, rightSpeed );
@@ -19,6 +19,7 @@
 #include <IJoystickDrive.h>     // Interface being implemented
 #include <IChassis.h>           // Class that controls the motors on the drive chassis
 #include <OperatorInterface.h>
+#include <InputSnapshot.h>      // Inputs sampled this cycle
 
 
 class TankDrive: public IJoystickDrive
@@ -37,7 +38,10 @@ class TankDrive: public IJoystickDrive
         //              to drive in tank drive mode.
         // Returns:     void
         //--------------------------------------------------------------------
-        void DriveWithJoysticks() const override;
+        void DriveWithJoysticks
+        (
+            const InputSnapshotData&    inputs      // <I> - inputs sampled this cycle
+        ) const override;
 
         //--------------------------------------------------------------------
         // Method:      GetIdentifier
@@ -0,0 +1,232 @@
+/*=============================================================================================
+ * TaskExecutor.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs a set of periodic tasks, each at its own rate, on one high priority thread and
+ * counts the deadlines each task misses.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cstdio>                   // printf
+#include <pthread.h>                // pthread_setschedparam
+#include <string>                   // std::string
+
+// WPILib includes
+#include <Timer.h>                  // FPGA timestamp
+
+// Team 302 includes
+#include <TaskExecutor.h>           // This class
+#include <LoopProfiler.h>           // Measures the time used by each pass
+
+
+//----------------------------------------------------------------------------------
+// Method:      TaskExecutor <<constructor>>
+// Description: This will construct and initialize the object.  No tasks run
+//              until Start() is called.
+//----------------------------------------------------------------------------------
+TaskExecutor::TaskExecutor() : m_tasks(),
+                               m_taskCount( 0 ),
+                               m_basePeriod( 0.0 ),
+                               m_notifier( new Notifier( &TaskExecutor::Run, this ) ),
+                               m_running( false ),
+                               m_threadInitialized( false ),
+                               m_dashboard( DashboardPublisher::GetInstance() )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      AddTask
+// Description: Adds a periodic task.  Higher priority tasks run first when more
+//              than one task is due.
+// Returns:     bool    true  = task added
+//                      false = too many tasks, bad rate or already started
+//----------------------------------------------------------------------------------
+bool TaskExecutor::AddTask
+(
+    const char*     name,           // <I> - name for the dashboard (string literal)
+    TaskFunction    function,       // <I> - what to run
+    double          rate,           // <I> - how often (Hz) to run it
+    int             priority        // <I> - larger numbers run first
+)
+{
+    bool added = false;
+    if ( !m_running && m_taskCount < MAX_TASKS && rate > 0.0 )
+    {
+        // keep the tasks sorted by priority, so Run() can just walk the list
+        int slot = m_taskCount;
+        while ( slot > 0 && m_tasks[slot-1].priority < priority )
+        {
+            m_tasks[slot] = m_tasks[slot-1];
+            slot--;
+        }
+
+        Task& task          = m_tasks[slot];
+        task.name           = name;
+        task.function       = function;
+        task.period         = 1.0 / rate;
+        task.priority       = priority;
+        task.nextRelease    = 0.0;
+        task.runs           = 0;
+        task.misses         = 0;
+        task.maxRunTime     = 0.0;
+
+        std::string key     = std::string( " task " ) + name;
+        task.missChannel    = m_dashboard->RegisterChannel( ( key + " misses" ).c_str() );
+        task.runTimeChannel = m_dashboard->RegisterChannel( ( key + " max (ms)" ).c_str() );
+
+        m_taskCount++;
+        m_basePeriod = ( m_basePeriod <= 0.0 || task.period < m_basePeriod ) ? task.period : m_basePeriod;
+        added = true;
+    }
+    return added;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Start
+// Description: Starts running the tasks
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::Start()
+{
+    if ( !m_running && m_taskCount > 0 )
+    {
+        // everything is due right away
+        double now = Timer::GetFPGATimestamp();
+        for ( int inx=0; inx<m_taskCount; ++inx )
+        {
+            m_tasks[inx].nextRelease = now;
+        }
+        m_notifier->StartPeriodic( m_basePeriod );
+        m_running = true;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Stop
+// Description: Stops running the tasks.  A task that is running finishes first.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::Stop()
+{
+    if ( m_running )
+    {
+        m_notifier->Stop();
+        m_running = false;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Run
+// Description: Called by the notifier at the rate of the fastest task; runs each
+//              task that is due
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::Run()
+{
+    if ( !m_threadInitialized )
+    {
+        InitializeThread();
+    }
+
+    ScopedLoopTimer loopTimer( PROFILE_CONTROL_LOOP );
+
+    // The notifier can wake up a little early, so allow half of the fastest period
+    double slack = m_basePeriod / 2.0;
+    for ( int inx=0; inx<m_taskCount; ++inx )
+    {
+        Task&  task  = m_tasks[inx];
+        double start = Timer::GetFPGATimestamp();
+        if ( start + slack >= task.nextRelease )
+        {
+            task.function();
+
+            double finish   = Timer::GetFPGATimestamp();
+            double runTime  = finish - start;
+            double deadline = task.nextRelease + task.period;
+            task.runs++;
+            task.maxRunTime = ( runTime > task.maxRunTime ) ? runTime : task.maxRunTime;
+
+            // Missed this deadline, plus any releases that went by completely
+            if ( finish > deadline )
+            {
+                task.misses++;
+            }
+            task.nextRelease = deadline;
+            while ( task.nextRelease + task.period <= finish )
+            {
+                task.nextRelease += task.period;
+                task.misses++;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PublishStats
+// Description: Sends the deadline misses and longest run time of each task to
+//              the dashboard.  This can be run as one of the tasks.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::PublishStats()
+{
+    for ( int inx=0; inx<m_taskCount; ++inx )
+    {
+        m_dashboard->PutNumber( m_tasks[inx].missChannel, m_tasks[inx].misses );
+        m_dashboard->PutNumber( m_tasks[inx].runTimeChannel, m_tasks[inx].maxRunTime * 1000.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Dump
+// Description: Prints the statistics for each task to the console and then clears
+//              them.  Only call this while the tasks are stopped.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::Dump()
+{
+    printf( "Tasks\n" );
+    for ( int inx=0; inx<m_taskCount; ++inx )
+    {
+        Task& task = m_tasks[inx];
+        printf( "  %-14s %6.1f Hz  priority %3d  runs %7u  misses %7u  max %7.3f ms\n",
+                task.name,
+                1.0 / task.period,
+                task.priority,
+                task.runs,
+                task.misses,
+                task.maxRunTime * 1000.0 );
+
+        task.runs       = 0;
+        task.misses     = 0;
+        task.maxRunTime = 0.0;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      InitializeThread
+// Description: Raises the priority of the notifier thread and lets it send
+//              dashboard values.  Runs the first time the thread wakes up.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void TaskExecutor::InitializeThread()
+{
+    sched_param param;
+    param.sched_priority = EXECUTOR_PRIORITY;
+    pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+
+    m_dashboard->AttachProducerThread();
+    m_threadInitialized = true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~TaskExecutor <<destructor>>
+// Description: This will stop the tasks and clean up the object
+//----------------------------------------------------------------------------------
+TaskExecutor::~TaskExecutor()
+{
+    Stop();
+    delete m_notifier;
+    m_notifier = nullptr;
+}
@@ -0,0 +1,154 @@
+/*=============================================================================================
+ * TaskExecutor.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This runs a set of periodic tasks, each at its own rate, on one high priority thread.  The
+ * thread wakes up at the rate of the fastest task and runs every task whose release time has
+ * come, highest priority first.  Tasks run to completion, so a slow low priority task delays
+ * (but never preempts) the others; keep each task short.
+ *
+ * A task misses its deadline when it finishes after its next release time.  Releases that are
+ * skipped completely because the thread was busy also count as misses.  The miss counts and
+ * the longest run time of each task can be published to the dashboard and dumped to the
+ * console.
+ *
+ * Tasks must be added before Start() is called.
+ *=============================================================================================*/
+
+#ifndef SRC_TASKEXECUTOR_H_
+#define SRC_TASKEXECUTOR_H_
+
+// Standard includes
+#include <functional>               // std::function
+
+// WPILib includes
+#include <Notifier.h>               // Wakes up the thread periodically
+
+// Team 302 includes
+#include <DashboardPublisher.h>     // Sends the task statistics from a background thread
+
+typedef std::function<void()> TaskFunction;
+
+class TaskExecutor
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      TaskExecutor <<constructor>>
+        // Description: This will construct and initialize the object.  No tasks run
+        //              until Start() is called.
+        //----------------------------------------------------------------------------------
+        TaskExecutor();
+
+        //----------------------------------------------------------------------------------
+        // Method:      AddTask
+        // Description: Adds a periodic task.  Higher priority tasks run first when more
+        //              than one task is due.
+        // Returns:     bool    true  = task added
+        //                      false = too many tasks, bad rate or already started
+        //----------------------------------------------------------------------------------
+        bool AddTask
+        (
+            const char*     name,           // <I> - name for the dashboard (string literal)
+            TaskFunction    function,       // <I> - what to run
+            double          rate,           // <I> - how often (Hz) to run it
+            int             priority        // <I> - larger numbers run first
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Start
+        // Description: Starts running the tasks
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Start();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Stop
+        // Description: Stops running the tasks.  A task that is running finishes first.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Stop();
+
+        //----------------------------------------------------------------------------------
+        // Method:      IsRunning
+        // Description: Returns whether the tasks are running
+        // Returns:     bool    true  = running
+        //----------------------------------------------------------------------------------
+        inline bool IsRunning() const { return m_running; }
+
+        //----------------------------------------------------------------------------------
+        // Method:      PublishStats
+        // Description: Sends the deadline misses and longest run time of each task to
+        //              the dashboard.  This can be run as one of the tasks.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void PublishStats();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Dump
+        // Description: Prints the statistics for each task to the console and then clears
+        //              them.  Only call this while the tasks are stopped.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Dump();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~TaskExecutor <<destructor>>
+        // Description: This will stop the tasks and clean up the object
+        //----------------------------------------------------------------------------------
+        virtual ~TaskExecutor();
+
+    private:
+        struct Task
+        {
+            const char*         name;
+            TaskFunction        function;
+            double              period;         // seconds between releases
+            int                 priority;       // larger numbers run first
+            double              nextRelease;    // FPGA time the task is due next
+            unsigned int        runs;           // times run since the last Dump()
+            unsigned int        misses;         // deadlines missed since the last Dump()
+            double              maxRunTime;     // longest run (seconds) since the last Dump()
+            DASHBOARD_CHANNEL   missChannel;
+            DASHBOARD_CHANNEL   runTimeChannel;
+        };
+
+        //----------------------------------------------------------------------------------
+        // Method:      Run
+        // Description: Called by the notifier at the rate of the fastest task; runs each
+        //              task that is due
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void Run();
+
+        //----------------------------------------------------------------------------------
+        // Method:      InitializeThread
+        // Description: Raises the priority of the notifier thread and lets it send
+        //              dashboard values.  Runs the first time the thread wakes up.
+        // Returns:     void
+        //----------------------------------------------------------------------------------
+        void InitializeThread();
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static const int        MAX_TASKS = 8;
+        const int               EXECUTOR_PRIORITY = 40;     // real-time priority (above the robot thread)
+
+        Task                    m_tasks[MAX_TASKS];         // sorted highest priority first
+        int                     m_taskCount;
+        double                  m_basePeriod;               // period of the fastest task
+
+        Notifier*               m_notifier;
+        bool                    m_running;
+        bool                    m_threadInitialized;
+        DashboardPublisher*     m_dashboard;
+
+        // Default methods we don't want the compiler to implement for us
+        TaskExecutor( const TaskExecutor& ) = delete;
+        TaskExecutor& operator= ( const TaskExecutor& ) = delete;
+        explicit TaskExecutor( TaskExecutor* other ) = delete;
+};
+
+#endif /* SRC_TASKEXECUTOR_H_ */
@@ -0,0 +1,208 @@
+/*=============================================================================================
+ * TrajectoryFile.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This memory maps the trajectory file made by the TrajectoryGenerator host tool and looks up
+ * trajectories in it without copying them.
+ *=============================================================================================*/
+
+// Standard includes
+#include <cmath>                    // fabs
+#include <cstdio>                   // printf
+#include <cstring>                  // strncmp, memchr
+#include <fcntl.h>                  // open
+#include <sys/mman.h>               // mmap, munmap
+#include <sys/stat.h>               // fstat
+#include <unistd.h>                 // close
+
+// Team 302 includes
+#include <TrajectoryFile.h>         // This class
+
+
+TrajectoryFile* TrajectoryFile::m_instance = nullptr; // initialize the instance variable to nullptr
+
+//----------------------------------------------------------------------------------
+// Method:      GetInstance
+// Description: If there isn't an instance of this class, it will create one.  The
+//              single class instance will be returned.
+// Returns:     TrajectoryFile*     instance of this class
+//----------------------------------------------------------------------------------
+TrajectoryFile* TrajectoryFile::GetInstance()
+{
+    if ( TrajectoryFile::m_instance == nullptr )
+    {
+        TrajectoryFile::m_instance = new TrajectoryFile();
+    }
+    return TrajectoryFile::m_instance;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      TrajectoryFile <<constructor>>
+// Description: This will construct the object with no file
+//----------------------------------------------------------------------------------
+TrajectoryFile::TrajectoryFile() : m_mapping( nullptr ),
+                                   m_size( 0 ),
+                                   m_header( nullptr ),
+                                   m_index( nullptr ),
+                                   m_samples( nullptr )
+{
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Open
+// Description: Maps the trajectory file and checks it.  Only call this once, from
+//              RobotInit().  Problems are printed to the console.
+// Returns:     bool    true  = trajectories available
+//                      false = missing file, wrong version, generated for another
+//                              track width or damaged (no trajectories are found)
+//----------------------------------------------------------------------------------
+bool TrajectoryFile::Open
+(
+    const char*     path,           // <I> - trajectory file
+    float           trackWidth      // <I> - feet between this robot's wheel centers
+)
+{
+    if ( m_mapping != nullptr )
+    {
+        return true;
+    }
+
+    int fd = open( path, O_RDONLY );
+    if ( fd < 0 )
+    {
+        printf( "Trajectories: can't open %s\n", path );
+        return false;
+    }
+
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if ( fstat( fd, &info ) == 0 && info.st_size >= static_cast<off_t>( sizeof( TrajectoryFileHeader ) ) )
+    {
+        mapping = mmap( nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    }
+    close( fd );        // the mapping keeps the file
+    if ( mapping == MAP_FAILED )
+    {
+        printf( "Trajectories: can't map %s\n", path );
+        return false;
+    }
+
+    // The sections are multiples of 4 bytes, so each one is aligned in the page-aligned mapping
+    m_mapping = mapping;
+    m_size    = info.st_size;
+    m_header  = static_cast<const TrajectoryFileHeader*>( mapping );
+    m_index   = reinterpret_cast<const TrajectoryIndexEntry*>( m_header + 1 );
+
+    const char* problem = Check( trackWidth );
+    if ( problem != nullptr )
+    {
+        printf( "Trajectories: %s %s\n", path, problem );
+        munmap( mapping, m_size );
+        m_mapping = nullptr;
+        m_size    = 0;
+        m_header  = nullptr;
+        m_index   = nullptr;
+        m_samples = nullptr;
+        return false;
+    }
+
+    m_samples = reinterpret_cast<const TrajectorySample*>( m_index + m_header->trajectoryCount );
+    printf( "Trajectories: %u trajectories from %s\n", m_header->trajectoryCount, path );
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Find
+// Description: Looks up a trajectory by name
+// Returns:     bool    true  = found
+//                      false = not in the file (or no file)
+//----------------------------------------------------------------------------------
+bool TrajectoryFile::Find
+(
+    const char*     name,           // <I> - trajectory name
+    Trajectory&     trajectory      // <O> - samples of the trajectory
+) const
+{
+    if ( m_mapping == nullptr )
+    {
+        return false;
+    }
+
+    for ( uint32_t inx=0; inx<m_header->trajectoryCount; ++inx )
+    {
+        const TrajectoryIndexEntry& entry = m_index[inx];
+        if ( strncmp( entry.name, name, TRAJECTORY_NAME_LENGTH ) == 0 )
+        {
+            trajectory.name           = entry.name;
+            trajectory.samples        = m_samples + entry.firstSample;
+            trajectory.sampleCount    = entry.sampleCount;
+            trajectory.samplePeriodMs = m_header->samplePeriodMs;
+            return true;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      Check
+// Description: Checks that the header and index match the mapped size
+// Returns:     const char*     nullptr = the file is good, otherwise the problem
+//----------------------------------------------------------------------------------
+const char* TrajectoryFile::Check
+(
+    float           trackWidth      // <I> - feet between this robot's wheel centers
+) const
+{
+    if ( m_header->magic != TRAJECTORY_FILE_MAGIC )
+    {
+        return "isn't a trajectory file";
+    }
+    if ( m_header->version != TRAJECTORY_FILE_VERSION || m_header->sampleSize != sizeof( TrajectorySample ) )
+    {
+        return "is the wrong version (run the TrajectoryGenerator again)";
+    }
+    if ( fabs( m_header->trackWidth - trackWidth ) > TRACK_WIDTH_TOLERANCE )
+    {
+        return "was generated for another track width";
+    }
+    if ( m_header->samplePeriodMs == 0 )
+    {
+        return "has no sample period";
+    }
+
+    // Sizes in 64 bits, so a damaged count can't wrap around
+    unsigned long long expected = sizeof( TrajectoryFileHeader ) +
+                                  static_cast<unsigned long long>( m_header->trajectoryCount ) * sizeof( TrajectoryIndexEntry ) +
+                                  static_cast<unsigned long long>( m_header->sampleCount ) * sizeof( TrajectorySample );
+    if ( expected != m_size )
+    {
+        return "is the wrong size";
+    }
+
+    for ( uint32_t inx=0; inx<m_header->trajectoryCount; ++inx )
+    {
+        const TrajectoryIndexEntry& entry = m_index[inx];
+        if ( memchr( entry.name, '\0', TRAJECTORY_NAME_LENGTH ) == nullptr ||
+             entry.sampleCount == 0 ||
+             entry.firstSample > m_header->sampleCount ||
+             entry.sampleCount > m_header->sampleCount - entry.firstSample )
+        {
+            return "has a damaged index";
+        }
+    }
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ~TrajectoryFile <<destructor>>
+// Description: This will unmap the file
+//----------------------------------------------------------------------------------
+TrajectoryFile::~TrajectoryFile()
+{
+    if ( m_mapping != nullptr )
+    {
+        munmap( const_cast<void*>( m_mapping ), m_size );
+    }
+}
@@ -0,0 +1,114 @@
+/*=============================================================================================
+ * TrajectoryFile.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This gives the robot the trajectories made ahead of time by the TrajectoryGenerator host
+ * tool (see TrajectoryFormat.h for the file layout).  Open() memory maps the file read-only
+ * and checks its header, index and size once; after that Find() just hands back pointers into
+ * the mapping, so starting a trajectory doesn't parse, copy or allocate anything.  It is a
+ * Singleton.
+ *
+ * Open() should be called from RobotInit().  The mapping stays valid (and Find() can be called
+ * from any thread) until the program exits.
+ *=============================================================================================*/
+
+#ifndef SRC_TRAJECTORYFILE_H_
+#define SRC_TRAJECTORYFILE_H_
+
+// Standard includes
+#include <cstddef>                  // size_t
+
+// Team 302 includes
+#include <TrajectoryFormat.h>       // Layout of the file
+
+// One trajectory in the mapped file
+struct Trajectory
+{
+    const char*             name;
+    const TrajectorySample* samples;        // points into the mapping
+    int                     sampleCount;
+    int                     samplePeriodMs;
+};
+
+class TrajectoryFile
+{
+    public:
+        //----------------------------------------------------------------------------------
+        // Method:      GetInstance
+        // Description: If there isn't an instance of this class, it will create one.  The
+        //              single class instance will be returned.
+        // Returns:     TrajectoryFile*     instance of this class
+        //----------------------------------------------------------------------------------
+        static TrajectoryFile* GetInstance();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Open
+        // Description: Maps the trajectory file and checks it.  Only call this once, from
+        //              RobotInit().  Problems are printed to the console.
+        // Returns:     bool    true  = trajectories available
+        //                      false = missing file, wrong version, generated for another
+        //                              track width or damaged (no trajectories are found)
+        //----------------------------------------------------------------------------------
+        bool Open
+        (
+            const char*     path,           // <I> - trajectory file
+            float           trackWidth      // <I> - feet between this robot's wheel centers
+        );
+
+        //----------------------------------------------------------------------------------
+        // Method:      Find
+        // Description: Looks up a trajectory by name
+        // Returns:     bool    true  = found
+        //                      false = not in the file (or no file)
+        //----------------------------------------------------------------------------------
+        bool Find
+        (
+            const char*     name,           // <I> - trajectory name
+            Trajectory&     trajectory      // <O> - samples of the trajectory
+        ) const;
+
+    private:
+        //----------------------------------------------------------------------------------
+        // Method:      TrajectoryFile <<constructor>>
+        // Description: This will construct the object with no file
+        //----------------------------------------------------------------------------------
+        TrajectoryFile();
+
+        //----------------------------------------------------------------------------------
+        // Method:      ~TrajectoryFile <<destructor>>
+        // Description: This will unmap the file
+        //----------------------------------------------------------------------------------
+        virtual ~TrajectoryFile();
+
+        //----------------------------------------------------------------------------------
+        // Method:      Check
+        // Description: Checks that the header and index match the mapped size
+        // Returns:     const char*     nullptr = the file is good, otherwise the problem
+        //----------------------------------------------------------------------------------
+        const char* Check
+        (
+            float           trackWidth      // <I> - feet between this robot's wheel centers
+        ) const;
+
+        //----------------------------------------------------------------------------------
+        // Attributes
+        //----------------------------------------------------------------------------------
+        static TrajectoryFile*  m_instance;     // Singleton instance of this class
+
+        const float             TRACK_WIDTH_TOLERANCE = 0.01;   // feet
+
+        const void*                 m_mapping;      // nullptr = no file
+        size_t                      m_size;         // bytes mapped
+        const TrajectoryFileHeader* m_header;
+        const TrajectoryIndexEntry* m_index;
+        const TrajectorySample*     m_samples;
+
+        // Default methods we don't want the compiler to implement for us
+        TrajectoryFile( const TrajectoryFile& ) = delete;
+        TrajectoryFile& operator= ( const TrajectoryFile& ) = delete;
+        explicit TrajectoryFile( TrajectoryFile* other ) = delete;
+};
+
+#endif /* SRC_TRAJECTORYFILE_H_ */
@@ -0,0 +1,71 @@
+/*=============================================================================================
+ * TrajectoryFormat.h
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This is the layout of the trajectory file written by the TrajectoryGenerator host tool
+ * (tools/TrajectoryGenerator.cpp) and memory mapped by TrajectoryFile on the robot.  The file
+ * is the structures below back to back, with no parsing needed to use them:
+ *
+ *      TrajectoryFileHeader
+ *      TrajectoryIndexEntry    x trajectoryCount
+ *      TrajectorySample        x sampleCount       (every trajectory's samples, in order)
+ *
+ * Every field is 4 bytes, so the structures have no padding, and the values are stored
+ * little-endian (the byte order of both the development PCs and the roboRIO).  Any change to
+ * the layout must bump TRAJECTORY_FILE_VERSION, so the robot refuses a file it can't read.
+ *
+ * A trajectory is a drive motion profile: sample n is where the robot should be at the end of
+ * the n-th period of samplePeriodMs.  The side positions start at 0.0 and are added to the
+ * side distances when the trajectory is started; the last sample is stopped.
+ *=============================================================================================*/
+
+#ifndef SRC_TRAJECTORYFORMAT_H_
+#define SRC_TRAJECTORYFORMAT_H_
+
+// Standard includes
+#include <cstdint>                  // uint32_t
+
+const uint32_t TRAJECTORY_FILE_MAGIC    = 0x4A415254;   // "TRAJ" in the first bytes of the file
+const uint32_t TRAJECTORY_FILE_VERSION  = 1;
+const int      TRAJECTORY_NAME_LENGTH   = 32;           // including the terminating nul
+
+struct TrajectoryFileHeader
+{
+    uint32_t    magic;              // TRAJECTORY_FILE_MAGIC
+    uint32_t    version;            // TRAJECTORY_FILE_VERSION
+    uint32_t    trajectoryCount;    // index entries after the header
+    uint32_t    sampleCount;        // samples after the index
+    uint32_t    sampleSize;         // sizeof( TrajectorySample ) when the file was written
+    uint32_t    samplePeriodMs;     // time between samples
+    float       trackWidth;         // feet; the side positions are only right for this robot
+    uint32_t    reserved;           // 0
+};
+
+struct TrajectoryIndexEntry
+{
+    char        name[TRAJECTORY_NAME_LENGTH];   // nul terminated
+    uint32_t    firstSample;        // index of the first sample in the file's samples
+    uint32_t    sampleCount;        // samples in this trajectory
+};
+
+struct TrajectorySample
+{
+    float       x;                  // feet forward of the start
+    float       y;                  // feet to the left of the start
+    float       heading;            // radians counterclockwise
+    float       velocity;           // feet per second (negative is backward)
+    float       acceleration;       // feet per second per second
+    float       curvature;          // 1 / feet (positive turns counterclockwise)
+    float       leftPosition;       // feet driven by the left side since the start
+    float       leftVelocity;       // feet per second
+    float       rightPosition;      // feet driven by the right side since the start
+    float       rightVelocity;      // feet per second
+};
+
+static_assert( sizeof( TrajectoryFileHeader ) == 32, "TrajectoryFileHeader layout changed; bump TRAJECTORY_FILE_VERSION" );
+static_assert( sizeof( TrajectoryIndexEntry ) == 40, "TrajectoryIndexEntry layout changed; bump TRAJECTORY_FILE_VERSION" );
+static_assert( sizeof( TrajectorySample ) == 40, "TrajectorySample layout changed; bump TRAJECTORY_FILE_VERSION" );
+
+#endif /* SRC_TRAJECTORYFORMAT_H_ */
@@ -31,16 +31,54 @@
     const bool IS_LEFT_DRIVE_MOTOR_INVERTED     = true;
     const bool IS_RIGHT_DRIVE_MOTOR_INVERTED    = false;
 
+    // The drive encoders count up when their side drives forward (the left motor is mirrored,
+    // its encoder isn't)
+    const bool IS_LEFT_DRIVE_SENSOR_REVERSED    = false;  // true = encoder counts down when the side drives forward
+    const bool IS_RIGHT_DRIVE_SENSOR_REVERSED   = false;
+
     const bool IS_SHOOTER_WHEEL_MOTOR_INVERTED  = true;
     const bool IS_SHOOTER_LOAD_MOTOR_INVERTED   = false;
     const bool IS_SHOOTER_ALIGN_MOTOR_INVERTED  = true;
 
+    const bool IS_SHOOTER_WHEEL_SENSOR_REVERSED = false;  // true = encoder counts down when the wheel shoots
+
     //==========================================================================================
     // Drive Encoder conversion rates to convert from counts to feet and feet per second
     //==========================================================================================
     const float ENCODER_DISTANCE_CONVERSION = 0.0010908307638889; // encoder counts to feet
     const float ENCODER_VELOCITY_CONVERSION = 0.0109083076388889; // encoder counts per 0.1 sec to feet per second
 
+    //==========================================================================================
+    // Drive velocity closed loop (runs on the Talons, units are encoder counts per 0.1 sec)
+    //==========================================================================================
+    const float DRIVE_MAX_VELOCITY          = 12.0;   // feet per second at full output
+    const int   DRIVE_VELOCITY_PROFILE      = 0;      // Talon gain slot
+    const float DRIVE_VELOCITY_P            = 0.8;
+    const float DRIVE_VELOCITY_I            = 0.0;
+    const float DRIVE_VELOCITY_D            = 0.0;
+    const int   MOTION_PROFILE_FRAME_PERIOD = 5;      // ms between motion profile frames (half the point duration)
+
+    //==========================================================================================
+    // Shooter wheel velocity closed loop (runs on the Talon, units are encoder counts per 0.1 sec)
+    //==========================================================================================
+    const float  SHOOTER_VELOCITY_CONVERSION    = 0.5859375; // encoder counts per 0.1 sec to RPM (256 line encoder)
+    const float  SHOOTER_WHEEL_MAX_RPM          = 5000.0; // RPM at full output
+    const int    SHOOTER_VELOCITY_PROFILE       = 0;      // Talon gain slot
+    const float  SHOOTER_VELOCITY_P             = 0.2;
+    const float  SHOOTER_VELOCITY_I             = 0.0;
+    const float  SHOOTER_VELOCITY_D             = 0.0;
+
+    //==========================================================================================
+    // Drive motor model (nominal feedforward until the drive is characterized in test mode)
+    //==========================================================================================
+    const float DRIVE_NOMINAL_VOLTAGE       = 12.0;   // volts at full output (DRIVE_MAX_VELOCITY)
+    const float DRIVE_TIME_CONSTANT         = 0.2;    // seconds to reach 63% of the velocity for a voltage
+
+    //==========================================================================================
+    // Drive geometry
+    //==========================================================================================
+    const float DRIVE_TRACK_WIDTH           = 2.0;    // feet between the left and right wheel centers
+
     //==========================================================================================
     // Analog Input Devices
     //==========================================================================================
@@ -8,15 +8,19 @@
  *
  *=============================================================================================*/
 
+// Standard includes
+#include <climits>                          // INT_MAX
+
 // WPILib includes
 #include <CANTalon.h>                       // Motor Controllers
 #include <DigitalInput.h>
-#include <SmartDashboard/SmartDashboard.h>  // Smart Dashboard
 
 
 // Team 302 includes
 #include <Year1Chassis.h>                   // This class'
 #include <IChassis.h>                       // Interface this class implements'
+#include <DashboardPublisher.h>             // Sends dashboard values from a background thread
+#include <DriveCharacterization.h>          // Saved drive feedforward
 #include <LimitValue.h>                     // Contains utility to force values within the valid range
 #include <Y1BotMap.h>                       // Contains the CAN IDs and Digital IO
 
@@ -26,22 +30,46 @@
 // Description: Create the motor controllers and set whether they are inverted or not.
 //----------------------------------------------------------------------------------
 Year1Chassis::Year1Chassis() :  IChassis(),
-                                m_leftMotor( new CANTalon( LEFT_DRIVE_MOTOR ) ) ,
-                                m_rightMotor( new CANTalon( RIGHT_DRIVE_MOTOR ) ),
+                                m_leftMotor( new DragonTalon( LEFT_DRIVE_MOTOR, "left drive" ) ) ,
+                                m_rightMotor( new DragonTalon( RIGHT_DRIVE_MOTOR, "right drive" ) ),
+                                m_feedforward(),
+                                m_leftEstimator( nullptr ),
+                                m_rightEstimator( nullptr ),
                                 m_bumperSwitch( new DigitalInput( GOAL_DETECTION_SENSOR ) ),
                                 m_leftLineTracker( new LineTracker( LEFT_LINE_TRACKER ) ),
                                 m_leftLineIndicator( new DigitalOutput( LEFT_LINE_TRACKER_LIGHT ) ),
                                 m_centerLineTracker( new LineTracker( CENTER_LINE_TRACKER ) ),
                                 m_centerLineIndicator( new DigitalOutput( CENTER_LINE_TRACKER_LIGHT ) ),
                                 m_rightLineTracker( new LineTracker( RIGHT_LINE_TRACKER ) ),
-                                m_rightLineIndicator( new DigitalOutput( RIGHT_LINE_TRACKER_LIGHT ) )
+                                m_rightLineIndicator( new DigitalOutput( RIGHT_LINE_TRACKER_LIGHT ) ),
+                                m_dashboard( DashboardPublisher::GetInstance() ),
+                                m_leftInputChannel( m_dashboard->RegisterChannel(" left input") ),
+                                m_rightInputChannel( m_dashboard->RegisterChannel(" right input") ),
+                                m_leftSpeedChannel( m_dashboard->RegisterChannel(" left speed") ),
+                                m_rightSpeedChannel( m_dashboard->RegisterChannel(" right speed") )
 {
-    // Create each drive motor and set whether it is inverted or not
-    m_leftMotor->SetInverted( IS_LEFT_DRIVE_MOTOR_INVERTED );
-    m_leftMotor->SetSensorDirection( true );
-
-    m_rightMotor->SetInverted( IS_RIGHT_DRIVE_MOTOR_INVERTED );
-    m_rightMotor->SetSensorDirection( true );
+    // Drive constants from the last characterization (nominal ones until there is one)
+    m_feedforward.kS = 0.0;
+    m_feedforward.kV = DRIVE_NOMINAL_VOLTAGE / DRIVE_MAX_VELOCITY;
+    m_feedforward.kA = m_feedforward.kV * DRIVE_TIME_CONSTANT;
+    DriveCharacterization::LoadFeedforward( m_feedforward );
+    m_leftEstimator  = new DriveSideEstimator( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+    m_rightEstimator = new DriveSideEstimator( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+
+    // Set whether each drive motor is inverted or not; start in brake mode so we don't
+    // roll until a drive asks for coast
+    const DragonTalonConfig leftConfig  = { IS_LEFT_DRIVE_MOTOR_INVERTED,  IS_LEFT_DRIVE_SENSOR_REVERSED,  CANSpeedController::kNeutralMode_Brake };
+    const DragonTalonConfig rightConfig = { IS_RIGHT_DRIVE_MOTOR_INVERTED, IS_RIGHT_DRIVE_SENSOR_REVERSED, CANSpeedController::kNeutralMode_Brake };
+    m_leftMotor->Configure( leftConfig );
+    m_rightMotor->Configure( rightConfig );
+
+    // Load the velocity gains once, so SetVelocities() only has to switch modes
+    ConfigVelocityControl( m_leftMotor );
+    ConfigVelocityControl( m_rightMotor );
+
+    // Get the encoder readings as often as the control loop runs
+    m_leftMotor->SetStatusFrameProfile( DRIVE_STATUS_FRAMES );
+    m_rightMotor->SetStatusFrameProfile( DRIVE_STATUS_FRAMES );
 
     ResetDistance();
 }
@@ -61,8 +89,12 @@ void Year1Chassis::SetMotorSpeeds
     const float rightSideSpeeds // <I> - Speed for the right side of the robot (range -1.0 to 1.0)
 ) const
 {
-    SmartDashboard::PutNumber(" left input", leftSideSpeeds );
-    SmartDashboard::PutNumber(" right input", rightSideSpeeds );
+    m_dashboard->PutNumber( m_leftInputChannel, leftSideSpeeds );
+    m_dashboard->PutNumber( m_rightInputChannel, rightSideSpeeds );
+
+    // Open loop (no-op when already in this mode)
+    m_leftMotor->SetControlMode( CANSpeedController::kPercentVbus );
+    m_rightMotor->SetControlMode( CANSpeedController::kPercentVbus );
 
     // Make sure the left side speed is within range and then set both left motors to this speed
     float leftSpeed = LimitValue::ForceInRange( leftSideSpeeds, -1.0, 1.0 );
@@ -72,8 +104,166 @@ void Year1Chassis::SetMotorSpeeds
     float rightSpeed = LimitValue::ForceInRange( rightSideSpeeds, -1.0, 1.0 );
     m_rightMotor->Set( rightSpeed );
 
-    SmartDashboard::PutNumber(" left speed", GetLeftSideVelocity() );
-    SmartDashboard::PutNumber(" right speed", GetRightSideVelocity() );
+    m_dashboard->PutNumber( m_leftSpeedChannel, GetLeftSideVelocity() );
+    m_dashboard->PutNumber( m_rightSpeedChannel, GetRightSideVelocity() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetVelocities
+// Description: This will have the motor controllers hold the left and right side
+//              velocities with their own closed loop (PIDF on the drive encoders).
+//              The setpoints aren't negated for an inverted side: its Talon
+//              reverses the closed loop output instead.
+//              Velocities outside of the range are limited to the range.  The next
+//              call to SetMotorSpeeds() goes back to open loop.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::SetVelocities
+(
+    const float leftSideVelocity,   // <I> - feet per second for the left side (positive is forward)
+    const float rightSideVelocity   // <I> - feet per second for the right side (positive is forward)
+) const
+{
+    m_dashboard->PutNumber( m_leftInputChannel, leftSideVelocity );
+    m_dashboard->PutNumber( m_rightInputChannel, rightSideVelocity );
+
+    // Closed loop on the Talons (no-op when already in this mode)
+    m_leftMotor->SetControlMode( CANSpeedController::kSpeed );
+    m_rightMotor->SetControlMode( CANSpeedController::kSpeed );
+
+    // The Talons want encoder counts per 0.1 sec
+    float leftVelocity = LimitValue::ForceInRange( leftSideVelocity, -DRIVE_MAX_VELOCITY, DRIVE_MAX_VELOCITY );
+    m_leftMotor->Set( leftVelocity / ENCODER_VELOCITY_CONVERSION );
+
+    float rightVelocity = LimitValue::ForceInRange( rightSideVelocity, -DRIVE_MAX_VELOCITY, DRIVE_MAX_VELOCITY );
+    m_rightMotor->Set( rightVelocity / ENCODER_VELOCITY_CONVERSION );
+
+    m_dashboard->PutNumber( m_leftSpeedChannel, GetLeftSideVelocity() );
+    m_dashboard->PutNumber( m_rightSpeedChannel, GetRightSideVelocity() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetMaxVelocity
+// Description: This will return the fastest a side can be told to go with
+//              SetVelocities()
+// Returns:     float   feet per second
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetMaxVelocity() const
+{
+    return DRIVE_MAX_VELOCITY;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      StartProfile
+// Description: This will throw away the points of any earlier motion profile and
+//              put the drive motors in motion profile mode with the output disabled.
+//              The next call to SetMotorSpeeds() or SetVelocities() leaves motion
+//              profile mode.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::StartProfile() const
+{
+    m_leftMotor->SetControlMode( CANSpeedController::kMotionProfile );
+    m_leftMotor->Set( CANTalon::SetValueMotionProfileDisable );
+    m_leftMotor->ClearMotionProfileTrajectories();
+    m_leftMotor->ClearMotionProfileHasUnderrun();
+    m_leftMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+
+    m_rightMotor->SetControlMode( CANSpeedController::kMotionProfile );
+    m_rightMotor->Set( CANTalon::SetValueMotionProfileDisable );
+    m_rightMotor->ClearMotionProfileTrajectories();
+    m_rightMotor->ClearMotionProfileHasUnderrun();
+    m_rightMotor->ChangeMotionControlFramePeriod( MOTION_PROFILE_FRAME_PERIOD );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      PushProfilePoint
+// Description: This will add a point to the end of the motion profile (the top
+//              buffer on the roboRIO).  Check topBufferRemaining first; a point is
+//              only added when every drive motor has room for it.
+// Returns:     bool        true  = point added
+//                          false = buffer full
+//----------------------------------------------------------------------------------
+bool Year1Chassis::PushProfilePoint
+(
+    const DriveProfilePoint&    point   // <I> - next point of the profile
+) const
+{
+    return ( PushMotorProfilePoint( m_leftMotor, point.leftPosition, point.leftVelocity, point.durationMs, point.isLastPoint ) &&
+             PushMotorProfilePoint( m_rightMotor, point.rightPosition, point.rightVelocity, point.durationMs, point.isLastPoint ) );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      ProcessProfileBuffer
+// Description: This will move points from the top buffer into the motor controllers.
+//              Call this at least twice per point duration while a profile runs.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::ProcessProfileBuffer() const
+{
+    m_leftMotor->ProcessMotionProfileBuffer();
+    m_rightMotor->ProcessMotionProfileBuffer();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetProfileStatus
+// Description: This will return the state of the motion profile buffers
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::GetProfileStatus
+(
+    DriveProfileStatus&         status  // <O> - buffer state of the drive motors
+) const
+{
+    status.topBufferRemaining = INT_MAX;
+    status.bottomBufferCount  = INT_MAX;
+    status.hasUnderrun        = false;
+    status.isLastPointActive  = true;
+
+    AddMotorProfileStatus( m_leftMotor, status );
+    AddMotorProfileStatus( m_rightMotor, status );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetProfileOutput
+// Description: This will start, hold or stop running the loaded motion profile
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::SetProfileOutput
+(
+    DRIVE_PROFILE_OUTPUT        output  // <I> - what the motors should do
+) const
+{
+    CANTalon::SetValueMotionProfile value = CANTalon::SetValueMotionProfileDisable;
+    switch ( output )
+    {
+        case PROFILE_OUTPUT_ENABLE:
+            value = CANTalon::SetValueMotionProfileEnable;
+            break;
+
+        case PROFILE_OUTPUT_HOLD:
+            value = CANTalon::SetValueMotionProfileHold;
+            break;
+
+        default:
+            break;
+    }
+
+    // These are mode codes, not outputs, so they are the same for an inverted side
+    m_leftMotor->Set( value );
+    m_rightMotor->Set( value );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      IsInProfile
+// Description: This will check whether the drive motors are in motion profile mode
+//              (StartProfile() was called and SetMotorSpeeds() or SetVelocities()
+//              hasn't been called since), so a motion profile owns them
+// Returns:     bool        true  = motion profile mode
+//----------------------------------------------------------------------------------
+bool Year1Chassis::IsInProfile() const
+{
+    return ( m_leftMotor->GetControlMode() == CANSpeedController::kMotionProfile );    // cached, so no CAN traffic
 }
 
 //----------------------------------------------------------------------------------
@@ -97,7 +287,7 @@ void Year1Chassis::ResetDistance()
 //----------------------------------------------------------------------------------
 float Year1Chassis::GetLeftSideDistance() const
 {
-    float distance = static_cast<float>( m_leftMotor->GetEncPosition() );
+    float distance = static_cast<float>( m_leftMotor->GetSensorPosition() );
     return ( distance * ENCODER_DISTANCE_CONVERSION );
 }
 
@@ -110,7 +300,7 @@ float Year1Chassis::GetLeftSideDistance() const
 //----------------------------------------------------------------------------------
 float Year1Chassis::GetRightSideDistance() const
 {
-    float distance = static_cast<float>( m_rightMotor->GetEncPosition() );
+    float distance = static_cast<float>( m_rightMotor->GetSensorPosition() );
     return ( distance * ENCODER_DISTANCE_CONVERSION );
 }
 
@@ -123,7 +313,7 @@ float Year1Chassis::GetRightSideDistance() const
 //----------------------------------------------------------------------------------
 float Year1Chassis::GetLeftSideVelocity() const
 {
-    float velocity = static_cast<float>( m_leftMotor->GetEncVel() );
+    float velocity = static_cast<float>( m_leftMotor->GetSensorVelocity() );
     return ( velocity*ENCODER_VELOCITY_CONVERSION );
 }
 
@@ -135,10 +325,146 @@ float Year1Chassis::GetLeftSideVelocity() const
 //----------------------------------------------------------------------------------
 float Year1Chassis::GetRightSideVelocity() const
 {
-    float velocity = static_cast<float>( m_rightMotor->GetEncVel() );
+    float velocity = static_cast<float>( m_rightMotor->GetSensorVelocity() );
     return ( velocity*ENCODER_VELOCITY_CONVERSION );
 }
 
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideSampleAge
+// Description: This will return the expected age of a left side encoder reading
+//              (half the encoder status frame period; a reading is at most twice
+//              this old)
+// Returns:     float   seconds
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetLeftSideSampleAge() const
+{
+    return static_cast<float>( m_leftMotor->GetEncoderSampleAge() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideSampleAge
+// Description: This will return the expected age of a right side encoder reading
+//              (half the encoder status frame period; a reading is at most twice
+//              this old)
+// Returns:     float   seconds
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetRightSideSampleAge() const
+{
+    return static_cast<float>( m_rightMotor->GetEncoderSampleAge() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideVoltage
+// Description: This will return the voltage applied to the left side motors
+// Returns:     float   volts (positive is forward)
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetLeftSideVoltage() const
+{
+    return static_cast<float>( m_leftMotor->GetOutputVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideVoltage
+// Description: This will return the voltage applied to the right side motors
+// Returns:     float   volts (positive is forward)
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetRightSideVoltage() const
+{
+    return static_cast<float>( m_rightMotor->GetOutputVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetFeedforward
+// Description: This will return the drive feedforward constants (the last saved
+//              characterization, or the robot's nominal values)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::GetFeedforward
+(
+    DriveFeedforward&   feedforward // <O> - drive constants
+) const
+{
+    feedforward = m_feedforward;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SetFeedforward
+// Description: This will start using new drive feedforward constants (e.g. a new
+//              characterization): the Talon velocity gains, the state estimates'
+//              motor model and what GetFeedforward() returns.  A path follower
+//              picks them up the next time a path is set.  Only call this while
+//              the control loop is stopped.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::SetFeedforward
+(
+    const DriveFeedforward&     feedforward // <I> - drive constants
+)
+{
+    m_feedforward = feedforward;
+    m_leftEstimator->SetModel( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+    m_rightEstimator->SetModel( 1.0 / m_feedforward.kV, m_feedforward.kA / m_feedforward.kV );
+
+    // The velocity feedforward gain comes from kV
+    ConfigVelocityControl( m_leftMotor );
+    ConfigVelocityControl( m_rightMotor );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      UpdateStateEstimates
+// Description: This will fold the latest encoder readings and applied motor voltages
+//              into the left and right side state estimates.  Call it once per sample
+//              of the chassis, from the thread that samples it.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::UpdateStateEstimates
+(
+    double              timestamp   // <I> - FPGA time (seconds) of the sample
+)
+{
+    // The output voltage comes from the same status frames as the encoders (no extra CAN traffic)
+    m_leftEstimator->Update( timestamp, GetLeftSideDistance(), GetLeftSideSampleAge(), GetLeftSideVoltage() );
+    m_rightEstimator->Update( timestamp, GetRightSideDistance(), GetRightSideSampleAge(), GetRightSideVoltage() );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLeftSideState
+// Description: This will return the left side estimate from the last
+//              UpdateStateEstimates() (no hardware is read)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::GetLeftSideState
+(
+    DriveSideState&     state       // <O> - position, velocity and acceleration
+) const
+{
+    m_leftEstimator->GetState( state );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetRightSideState
+// Description: This will return the right side estimate from the last
+//              UpdateStateEstimates() (no hardware is read)
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::GetRightSideState
+(
+    DriveSideState&     state       // <O> - position, velocity and acceleration
+) const
+{
+    m_rightEstimator->GetState( state );
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetTrackWidth
+// Description: This will return the distance between the left and right wheels
+// Returns:     float   track width in feet
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetTrackWidth() const
+{
+    return DRIVE_TRACK_WIDTH;
+}
+
 //----------------------------------------------------------------------------------
 // Method:      SetBrakeMode
 // Description: This will set the drive motors to brake mode
@@ -170,10 +496,92 @@ void Year1Chassis::SetCoastMode() const
 //----------------------------------------------------------------------------------
 bool Year1Chassis::IsBumperPressed()
 {
-   SmartDashboard::PutBoolean(" bumper tripped ", !m_bumperSwitch->Get() );
    return !m_bumperSwitch->Get();
 }
 
+//----------------------------------------------------------------------------------
+// Method:      CheckDriveEncoders
+// Description: This will compare the drive encoders on the same side of the robot
+//              (on chassis that have more than one).  Call it once per cycle; the
+//              encoders are only compared every so often.  Once they disagree they
+//              stay unhealthy until ResetDistance() is called.
+// Returns:     bool        true  = encoders agree (or there is nothing to compare)
+//                          false = encoders on a side disagree
+//----------------------------------------------------------------------------------
+bool Year1Chassis::CheckDriveEncoders()
+{
+    // Only one encoder per side, so there is nothing to compare
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      SampleLineTrackers
+// Description: This will read each of the line trackers once.  GetLineTrackerVoltage,
+//              GetLineTrackerState and UpdateLineTrackerLights use these readings
+//              until the next time this is called.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::SampleLineTrackers()
+{
+    m_leftLineTracker->Sample();
+    m_centerLineTracker->Sample();
+    m_rightLineTracker->Sample();
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerVoltage
+// Description: This will return the voltage read by the last SampleLineTrackers()
+// Returns:     float       voltage of the line tracker
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetLineTrackerVoltage
+(
+    LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+) const
+{
+    const LineTracker* lineTracker = GetLineTracker( tracker );
+    return ( lineTracker != nullptr ) ? lineTracker->GetSampledVoltage() : 0.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerRate
+// Description: This will return how fast the line tracker voltage was changing at
+//              the last SampleLineTrackers()
+// Returns:     float       volts per second
+//----------------------------------------------------------------------------------
+float Year1Chassis::GetLineTrackerRate
+(
+    LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+) const
+{
+    const LineTracker* lineTracker = GetLineTracker( tracker );
+    return ( lineTracker != nullptr ) ? lineTracker->GetVoltageRate() : 0.0;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerMask
+// Description: This will return the line trackers (from the last SampleLineTrackers())
+//              packed into a mask of LINE_MASK_ bits
+// Returns:     unsigned int    LINE_MASK_ bits
+//----------------------------------------------------------------------------------
+unsigned int Year1Chassis::GetLineTrackerMask()
+{
+    LINE_TRACKER_COLOR left   = m_leftLineTracker->GetColor();
+    LINE_TRACKER_COLOR center = m_centerLineTracker->GetColor();
+    LINE_TRACKER_COLOR right  = m_rightLineTracker->GetColor();
+
+    unsigned int mask = 0;
+    mask |= ( left   == LINE_TRACKER_WHITE ) ? LINE_MASK_LEFT_WHITE   : 0;
+    mask |= ( center == LINE_TRACKER_WHITE ) ? LINE_MASK_CENTER_WHITE : 0;
+    mask |= ( right  == LINE_TRACKER_WHITE ) ? LINE_MASK_RIGHT_WHITE  : 0;
+    if ( left   == LINE_TRACKER_INDETERMINATE ||
+         center == LINE_TRACKER_INDETERMINATE ||
+         right  == LINE_TRACKER_INDETERMINATE )
+    {
+        mask |= LINE_MASK_INDETERMINATE;
+    }
+    return mask;
+}
+
 //----------------------------------------------------------------------------------
 // Method:      GetLineTrackerState
 // Description: This will return the state of the line trackers
@@ -182,76 +590,180 @@ bool Year1Chassis::IsBumperPressed()
 //----------------------------------------------------------------------------------
 LINE_TRACK_STATE Year1Chassis::GetLineTrackerState()
 {
+    return DecodeLineTrackMask( GetLineTrackerMask() );
+}
 
-    SmartDashboard::PutNumber(" left line tracker", m_leftLineTracker->GetVoltage() );
-    SmartDashboard::PutNumber(" center line tracker", m_centerLineTracker->GetVoltage() );
-    SmartDashboard::PutNumber(" right line tracker", m_rightLineTracker->GetVoltage() );
+//----------------------------------------------------------------------------------
+// Method:      UpdateLineTrackerLights
+// Description: This will update the line tracker lights
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::UpdateLineTrackerLights()
+{
+    m_leftLineIndicator-> Set( m_leftLineTracker-> IsWhite() );
+    m_centerLineIndicator-> Set( m_centerLineTracker-> IsWhite() );
+    m_rightLineIndicator-> Set( m_rightLineTracker-> IsWhite() );
+}
 
+//----------------------------------------------------------------------------------
+// Method:      StartLineTrackerCalibration
+// Description: This will start learning the white and black levels of each line
+//              tracker.  Sweep the robot over the line while sampling the trackers.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::StartLineTrackerCalibration()
+{
+    m_leftLineTracker->StartCalibration();
+    m_centerLineTracker->StartCalibration();
+    m_rightLineTracker->StartCalibration();
+}
 
+//----------------------------------------------------------------------------------
+// Method:      FinishLineTrackerCalibration
+// Description: This will stop learning the levels.  The levels of each tracker
+//              that saw both white and black are changed and saved.
+// Returns:     bool        true  = every tracker was calibrated
+//                          false = at least one tracker kept its old levels
+//----------------------------------------------------------------------------------
+bool Year1Chassis::FinishLineTrackerCalibration()
+{
+    // finish all of them, even if one fails
+    bool left   = m_leftLineTracker->FinishCalibration();
+    bool center = m_centerLineTracker->FinishCalibration();
+    bool right  = m_rightLineTracker->FinishCalibration();
+    return ( left && center && right );
+}
 
-    LINE_TRACK_STATE state = UNKNOWN;
+//----------------------------------------------------------------------------------
+// Method:      GetLineTrackerLevels
+// Description: This will return the voltages a line tracker reads over white
+//              and over black
+// Returns:     bool        true  = levels returned
+//                          false = no such line tracker
+//----------------------------------------------------------------------------------
+bool Year1Chassis::GetLineTrackerLevels
+(
+    LINE_TRACKER_IDENTIFIER tracker,        // <I> - line tracker to query
+    float&                  whiteLevel,     // <O> - voltage over the line
+    float&                  blackLevel      // <O> - voltage over black
+) const
+{
+    const LineTracker* lineTracker = GetLineTracker( tracker );
+    if ( lineTracker != nullptr )
+    {
+        whiteLevel = lineTracker->GetWhiteLevel();
+        blackLevel = lineTracker->GetBlackLevel();
+    }
+    return ( lineTracker != nullptr );
+}
 
-    bool IsBlackleft = m_leftLineTracker-> IsBlack();
-    bool IsWhiteleft = m_leftLineTracker-> IsWhite();
 
-    bool IsBlackright = m_rightLineTracker-> IsBlack();
-    bool IsWhiteright = m_rightLineTracker-> IsWhite();
+//----------------------------------------------------------------------------------
+// Method:      GetLineTracker
+// Description: This will return the line tracker for an identifier
+// Returns:     LineTracker*    line tracker (nullptr if there isn't one)
+//----------------------------------------------------------------------------------
+LineTracker* Year1Chassis::GetLineTracker
+(
+    LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to find
+) const
+{
+    LineTracker* lineTracker = nullptr;
+    switch ( tracker )
+    {
+        case LEFT_TRACKER:
+            lineTracker = m_leftLineTracker;
+            break;
 
-    bool IsBlackcenter = m_centerLineTracker-> IsBlack();
-    bool IsWhitecenter = m_centerLineTracker-> IsWhite();
+        case CENTER_TRACKER:
+            lineTracker = m_centerLineTracker;
+            break;
 
-    if (IsWhiteleft && IsWhitecenter  && IsWhiteright)
-    {
-        state = LEFT_WHITE_CENTER_WHITE_RIGHT_WHITE;
-    }
-    else if ( IsWhiteleft && IsBlackcenter && IsWhiteright )
-    {
-       state = LEFT_WHITE_CENTER_BLACK_RIGHT_WHITE;
-    }
-    else if ( IsBlackleft && IsBlackcenter && IsBlackright )
-    {
-        state = LEFT_BLACK_CENTER_BLACK_RIGHT_BLACK;
-    }
-    else if (IsWhiteleft && IsWhitecenter && IsBlackright )
-    {
-       state = LEFT_WHITE_CENTER_WHITE_RIGHT_BLACK;
-    }
-    else if (IsWhiteleft && IsBlackcenter && IsBlackright)
-    {
-        state = LEFT_WHITE_CENTER_BLACK_RIGHT_BLACK;
-    }
-    else if (IsBlackleft && IsWhitecenter && IsWhiteright)
-    {
-        state = LEFT_BLACK_CENTER_WHITE_RIGHT_WHITE;
-    }
-    else if (IsBlackleft && IsBlackcenter && IsWhiteright)
-    {
-        state = LEFT_BLACK_CENTER_BLACK_RIGHT_WHITE;
-    }
-    else if (IsBlackleft && IsWhitecenter && IsBlackright)
-    {
-        state = LEFT_BLACK_CENTER_WHITE_RIGHT_BLACK;
-    }
-    else
-    {
-        state = UNKNOWN;
+        case RIGHT_TRACKER:
+            lineTracker = m_rightLineTracker;
+            break;
+
+        default:
+            break;
     }
+    return lineTracker;
+}
 
-    return state;
+//----------------------------------------------------------------------------------
+// Method:      PushMotorProfilePoint
+// Description: This will add one side's part of a profile point to a drive motor.
+//              The point is in the motor's closed loop sensor counts, which count
+//              up going forward on both sides, so it isn't negated for an inverted
+//              side: that side's Talon reverses its closed loop output.
+// Returns:     bool        true  = point added
+//                          false = buffer full
+//----------------------------------------------------------------------------------
+bool Year1Chassis::PushMotorProfilePoint
+(
+    DragonTalon*    motor,          // <I> - drive motor
+    float           position,       // <I> - feet (positive is forward)
+    float           velocity,       // <I> - feet per second (positive is forward)
+    int         durationMs,         // <I> - how long the point lasts
+    bool        isLastPoint         // <I> - true = last point of the profile
+) const
+{
+    // The Talons want closed loop sensor counts and counts per 0.1 sec (the same
+    // counts GetLeftSideDistance() and GetRightSideDistance() read, so a profile
+    // started from the current distances starts where the Talon is)
+    CANTalon::TrajectoryPoint point;
+    point.position          = position / ENCODER_DISTANCE_CONVERSION;
+    point.velocity          = velocity / ENCODER_VELOCITY_CONVERSION;
+    point.timeDurMs         = durationMs;
+    point.profileSlotSelect = DRIVE_VELOCITY_PROFILE;
+    point.velocityOnly      = false;
+    point.isLastPoint       = isLastPoint;
+    point.zeroPos           = false;
+    return motor->PushMotionProfileTrajectory( point );
 }
 
 //----------------------------------------------------------------------------------
-// Method:      UpdateLineTrackerLights
-// Description: This will update the line tracker lights
+// Method:      AddMotorProfileStatus
+// Description: This will fold a drive motor's buffer state into the status (keeping
+//              the worst of the motors)
 // Returns:     void
 //----------------------------------------------------------------------------------
-void Year1Chassis::UpdateLineTrackerLights()
+void Year1Chassis::AddMotorProfileStatus
+(
+    CANTalon*           motor,      // <I> - drive motor
+    DriveProfileStatus& status      // <IO> - status of the motors checked so far
+) const
 {
-    m_leftLineIndicator-> Set( m_leftLineTracker-> IsWhite() );
-    m_centerLineIndicator-> Set( m_centerLineTracker-> IsWhite() );
-    m_rightLineIndicator-> Set( m_rightLineTracker-> IsWhite() );
+    CANTalon::MotionProfileStatus motorStatus;
+    motor->GetMotionProfileStatus( motorStatus );
+
+    int topBufferRemaining = static_cast<int>( motorStatus.topBufferRem );
+    int bottomBufferCount  = static_cast<int>( motorStatus.btmBufferCnt );
+    status.topBufferRemaining = ( topBufferRemaining < status.topBufferRemaining ) ? topBufferRemaining : status.topBufferRemaining;
+    status.bottomBufferCount  = ( bottomBufferCount < status.bottomBufferCount ) ? bottomBufferCount : status.bottomBufferCount;
+    status.hasUnderrun        = status.hasUnderrun || motorStatus.hasUnderrun;
+    status.isLastPointActive  = status.isLastPointActive &&
+                                motorStatus.activePointValid && motorStatus.activePoint.isLastPoint;
 }
 
+//----------------------------------------------------------------------------------
+// Method:      ConfigVelocityControl
+// Description: This will point the Talon's closed loop at the drive encoder and
+//              load the drive velocity gains.  The sensor and output directions
+//              come from the motor's Configure(), so the setpoints are positive
+//              forward on both sides.
+// Returns:     void
+//----------------------------------------------------------------------------------
+void Year1Chassis::ConfigVelocityControl
+(
+    CANTalon*   motor               // <I> - drive motor to configure
+) const
+{
+    motor->SetFeedbackDevice( CANTalon::QuadEncoder );
+    motor->SelectProfileSlot( DRIVE_VELOCITY_PROFILE );
+    // The feedforward gain is full output (1023) per encoder count per 0.1 sec at kV
+    float feedforwardGain = 1023.0 * m_feedforward.kV / DRIVE_NOMINAL_VOLTAGE * ENCODER_VELOCITY_CONVERSION;
+    motor->SetPID( DRIVE_VELOCITY_P, DRIVE_VELOCITY_I, DRIVE_VELOCITY_D, feedforwardGain );
+}
 
 //----------------------------------------------------------------------------------
 // Method:      ~Year1Chassis <<Destructor>>
@@ -264,5 +776,11 @@ Year1Chassis::~Year1Chassis()
 
     delete m_rightMotor;
     m_rightMotor = nullptr;
+
+    delete m_leftEstimator;
+    m_leftEstimator = nullptr;
+
+    delete m_rightEstimator;
+    m_rightEstimator = nullptr;
 }
 
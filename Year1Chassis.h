@@ -17,8 +17,11 @@
 #include <LineTracker.h>
 
 // Team 302 includes
+#include <DragonTalon.h>
+#include <DriveSideEstimator.h>
 #include <IChassis.h>
 #include <IChassisFactory.h>
+#include <DashboardPublisher.h>
 
 class Year1Chassis : public IChassis
 {
@@ -40,6 +43,90 @@ public:
     ) const override;
 
 
+    //----------------------------------------------------------------------------------
+    // Method:      SetVelocities
+    // Description: This will have the motor controllers hold the left and right side
+    //              velocities with their own closed loop (PIDF on the drive encoders).
+    //              The setpoints aren't negated for an inverted side: its Talon
+    //              reverses the closed loop output instead.
+    //              Velocities outside of the range are limited to the range.  The next
+    //              call to SetMotorSpeeds() goes back to open loop.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void SetVelocities
+    (
+        const float leftSideVelocity,   // <I> - feet per second for the left side (positive is forward)
+        const float rightSideVelocity   // <I> - feet per second for the right side (positive is forward)
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetMaxVelocity
+    // Description: This will return the fastest a side can be told to go with
+    //              SetVelocities()
+    // Returns:     float   feet per second
+    //----------------------------------------------------------------------------------
+    float GetMaxVelocity() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      StartProfile
+    // Description: This will throw away the points of any earlier motion profile and
+    //              put the drive motors in motion profile mode with the output disabled.
+    //              The next call to SetMotorSpeeds() or SetVelocities() leaves motion
+    //              profile mode.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void StartProfile() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      PushProfilePoint
+    // Description: This will add a point to the end of the motion profile (the top
+    //              buffer on the roboRIO).  Check topBufferRemaining first; a point is
+    //              only added when every drive motor has room for it.
+    // Returns:     bool        true  = point added
+    //                          false = buffer full
+    //----------------------------------------------------------------------------------
+    bool PushProfilePoint
+    (
+        const DriveProfilePoint&    point   // <I> - next point of the profile
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      ProcessProfileBuffer
+    // Description: This will move points from the top buffer into the motor controllers.
+    //              Call this at least twice per point duration while a profile runs.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void ProcessProfileBuffer() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetProfileStatus
+    // Description: This will return the state of the motion profile buffers
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void GetProfileStatus
+    (
+        DriveProfileStatus&         status  // <O> - buffer state of the drive motors
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SetProfileOutput
+    // Description: This will start, hold or stop running the loaded motion profile
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void SetProfileOutput
+    (
+        DRIVE_PROFILE_OUTPUT        output  // <I> - what the motors should do
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      IsInProfile
+    // Description: This will check whether the drive motors are in motion profile mode
+    //              (StartProfile() was called and SetMotorSpeeds() or SetVelocities()
+    //              hasn't been called since), so a motion profile owns them
+    // Returns:     bool        true  = motion profile mode
+    //----------------------------------------------------------------------------------
+    bool IsInProfile() const override;
+
     //----------------------------------------------------------------------------------
     // Method:      ResetDistance
     // Description: This will reset the distance, so calls to get the distance will
@@ -82,6 +169,104 @@ public:
     //----------------------------------------------------------------------------------
     float GetRightSideVelocity() const override;
 
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideSampleAge
+    // Description: This will return the expected age of a left side encoder reading
+    //              (half the encoder status frame period; a reading is at most twice
+    //              this old)
+    // Returns:     float   seconds
+    //----------------------------------------------------------------------------------
+    float GetLeftSideSampleAge() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideSampleAge
+    // Description: This will return the expected age of a right side encoder reading
+    //              (half the encoder status frame period; a reading is at most twice
+    //              this old)
+    // Returns:     float   seconds
+    //----------------------------------------------------------------------------------
+    float GetRightSideSampleAge() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideVoltage
+    // Description: This will return the voltage applied to the left side motors
+    // Returns:     float   volts (positive is forward)
+    //----------------------------------------------------------------------------------
+    float GetLeftSideVoltage() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideVoltage
+    // Description: This will return the voltage applied to the right side motors
+    // Returns:     float   volts (positive is forward)
+    //----------------------------------------------------------------------------------
+    float GetRightSideVoltage() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetFeedforward
+    // Description: This will return the drive feedforward constants (the last saved
+    //              characterization, or the robot's nominal values)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void GetFeedforward
+    (
+        DriveFeedforward&   feedforward // <O> - drive constants
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SetFeedforward
+    // Description: This will start using new drive feedforward constants (e.g. a new
+    //              characterization): the Talon velocity gains, the state estimates'
+    //              motor model and what GetFeedforward() returns.  A path follower
+    //              picks them up the next time a path is set.  Only call this while
+    //              the control loop is stopped.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void SetFeedforward
+    (
+        const DriveFeedforward&     feedforward // <I> - drive constants
+    ) override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      UpdateStateEstimates
+    // Description: This will fold the latest encoder readings and applied motor voltages
+    //              into the left and right side state estimates.  Call it once per sample
+    //              of the chassis, from the thread that samples it.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void UpdateStateEstimates
+    (
+        double              timestamp   // <I> - FPGA time (seconds) of the sample
+    ) override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLeftSideState
+    // Description: This will return the left side estimate from the last
+    //              UpdateStateEstimates() (no hardware is read)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void GetLeftSideState
+    (
+        DriveSideState&     state       // <O> - position, velocity and acceleration
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetRightSideState
+    // Description: This will return the right side estimate from the last
+    //              UpdateStateEstimates() (no hardware is read)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void GetRightSideState
+    (
+        DriveSideState&     state       // <O> - position, velocity and acceleration
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetTrackWidth
+    // Description: This will return the distance between the left and right wheels
+    // Returns:     float   track width in feet
+    //----------------------------------------------------------------------------------
+    float GetTrackWidth() const override;
+
 
     //----------------------------------------------------------------------------------
     // Method:      SetBrakeMode
@@ -106,6 +291,55 @@ public:
     //----------------------------------------------------------------------------------
     bool IsBumperPressed() override;
 
+    //----------------------------------------------------------------------------------
+    // Method:      CheckDriveEncoders
+    // Description: This will compare the drive encoders on the same side of the robot
+    //              (on chassis that have more than one).  Call it once per cycle; the
+    //              encoders are only compared every so often.  Once they disagree they
+    //              stay unhealthy until ResetDistance() is called.
+    // Returns:     bool        true  = encoders agree (or there is nothing to compare)
+    //                          false = encoders on a side disagree
+    //----------------------------------------------------------------------------------
+    bool CheckDriveEncoders() override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      SampleLineTrackers
+    // Description: This will read each of the line trackers once.  GetLineTrackerVoltage,
+    //              GetLineTrackerState and UpdateLineTrackerLights use these readings
+    //              until the next time this is called.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void SampleLineTrackers() override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerVoltage
+    // Description: This will return the voltage read by the last SampleLineTrackers()
+    // Returns:     float       voltage of the line tracker
+    //----------------------------------------------------------------------------------
+    float GetLineTrackerVoltage
+    (
+        LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerRate
+    // Description: This will return how fast the line tracker voltage was changing at
+    //              the last SampleLineTrackers()
+    // Returns:     float       volts per second
+    //----------------------------------------------------------------------------------
+    float GetLineTrackerRate
+    (
+        LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to query
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerMask
+    // Description: This will return the line trackers (from the last SampleLineTrackers())
+    //              packed into a mask of LINE_MASK_ bits
+    // Returns:     unsigned int    LINE_MASK_ bits
+    //----------------------------------------------------------------------------------
+    unsigned int GetLineTrackerMask() override;
+
     //----------------------------------------------------------------------------------
     // Method:      GetLineTrackerState
     // Description: This will return the state of the line trackers
@@ -121,6 +355,37 @@ public:
     //----------------------------------------------------------------------------------
     void UpdateLineTrackerLights() override;
 
+    //----------------------------------------------------------------------------------
+    // Method:      StartLineTrackerCalibration
+    // Description: This will start learning the white and black levels of each line
+    //              tracker.  Sweep the robot over the line while sampling the trackers.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void StartLineTrackerCalibration() override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      FinishLineTrackerCalibration
+    // Description: This will stop learning the levels.  The levels of each tracker
+    //              that saw both white and black are changed and saved.
+    // Returns:     bool        true  = every tracker was calibrated
+    //                          false = at least one tracker kept its old levels
+    //----------------------------------------------------------------------------------
+    bool FinishLineTrackerCalibration() override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTrackerLevels
+    // Description: This will return the voltages a line tracker reads over white
+    //              and over black
+    // Returns:     bool        true  = levels returned
+    //                          false = no such line tracker
+    //----------------------------------------------------------------------------------
+    bool GetLineTrackerLevels
+    (
+        LINE_TRACKER_IDENTIFIER tracker,        // <I> - line tracker to query
+        float&                  whiteLevel,     // <O> - voltage over the line
+        float&                  blackLevel      // <O> - voltage over black
+    ) const override;
+
 
 private:
     friend class IChassisFactory;
@@ -137,9 +402,69 @@ private:
     //----------------------------------------------------------------------------------
     virtual ~Year1Chassis();
 
+    //----------------------------------------------------------------------------------
+    // Method:      PushMotorProfilePoint
+    // Description: This will add one side's part of a profile point to a drive motor.
+    //              The point is in the motor's closed loop sensor counts, which count
+    //              up going forward on both sides, so it isn't negated for an inverted
+    //              side: that side's Talon reverses its closed loop output.
+    // Returns:     bool        true  = point added
+    //                          false = buffer full
+    //----------------------------------------------------------------------------------
+    bool PushMotorProfilePoint
+    (
+        DragonTalon*    motor,          // <I> - drive motor
+        float           position,       // <I> - feet (positive is forward)
+        float           velocity,       // <I> - feet per second (positive is forward)
+        int         durationMs,         // <I> - how long the point lasts
+        bool        isLastPoint         // <I> - true = last point of the profile
+    ) const;
+
+    //----------------------------------------------------------------------------------
+    // Method:      AddMotorProfileStatus
+    // Description: This will fold a drive motor's buffer state into the status (keeping
+    //              the worst of the motors)
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void AddMotorProfileStatus
+    (
+        CANTalon*           motor,      // <I> - drive motor
+        DriveProfileStatus& status      // <IO> - status of the motors checked so far
+    ) const;
+
+    //----------------------------------------------------------------------------------
+    // Method:      ConfigVelocityControl
+    // Description: This will point the Talon's closed loop at the drive encoder and
+    //              load the drive velocity gains.  The sensor and output directions
+    //              come from the motor's Configure(), so the setpoints are positive
+    //              forward on both sides.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void ConfigVelocityControl
+    (
+        CANTalon*   motor               // <I> - drive motor to configure
+    ) const;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLineTracker
+    // Description: This will return the line tracker for an identifier
+    // Returns:     LineTracker*    line tracker (nullptr if there isn't one)
+    //----------------------------------------------------------------------------------
+    LineTracker* GetLineTracker
+    (
+        LINE_TRACKER_IDENTIFIER tracker     // <I> - line tracker to find
+    ) const;
+
     // Drive Motors
-    CANTalon*           m_leftMotor;
-    CANTalon*           m_rightMotor;
+    DragonTalon*        m_leftMotor;
+    DragonTalon*        m_rightMotor;
+
+    // Drive feedforward (from the last characterization)
+    DriveFeedforward    m_feedforward;
+
+    // Filtered drive state (only touched by the thread that samples the chassis)
+    DriveSideEstimator* m_leftEstimator;
+    DriveSideEstimator* m_rightEstimator;
 
     // Bumper Switch
     DigitalInput*       m_bumperSwitch;
@@ -153,6 +478,13 @@ private:
 
     LineTracker*            m_rightLineTracker;
     DigitalOutput*          m_rightLineIndicator;
+
+    // Dashboard
+    DashboardPublisher*     m_dashboard;
+    const DASHBOARD_CHANNEL m_leftInputChannel;
+    const DASHBOARD_CHANNEL m_rightInputChannel;
+    const DASHBOARD_CHANNEL m_leftSpeedChannel;
+    const DASHBOARD_CHANNEL m_rightSpeedChannel;
 };
 
 #endif /* SRC_YEAR1CHASSIS_H_ */
@@ -10,13 +10,19 @@
 #ifndef SRC_YEAR1SHOOTER_H_
 #define SRC_YEAR1SHOOTER_H_
 
+// Standard includes
+#include <atomic>                   // std::atomic
+#include <cstdint>                  // uint32_t
+
 // WPILib includes
 #include <CANTalon.h>
 #include <DigitalInput.h>
 
 // Team 302 includes
+#include <DragonTalon.h>
 #include <IShooter.h>
 #include <IShooterFactory.h>
+#include <DashboardPublisher.h>
 
 class Year1Shooter : public IShooter
 {
@@ -24,7 +30,7 @@ public:
 
     //----------------------------------------------------------------------------------
     // Method:      SetShooterSpeed
-    // Description: This will set the motor speed for the shooter wheel.
+    // Description: This will set the motor speed for the shooter wheel (open loop).
     //              If a value is specified that is outside the range, the value
     //              used will be the closest bounding value (e.g. if 2.0 is passed in and
     //              the range is -1.0 to 1.0, 1.0 will be used.
@@ -35,6 +41,26 @@ public:
         const float speed   // <I> - Speed for the shooter wheel (range -1.0 to 1.0)
     ) const override;
 
+    //----------------------------------------------------------------------------------
+    // Method:      SetShooterVelocity
+    // Description: This will have the motor controller hold the shooter wheel speed with
+    //              its own closed loop (PIDF on the wheel encoder).  Speeds outside of the
+    //              range are limited to the range.  The next call to SetShooterSpeed()
+    //              goes back to open loop.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    void SetShooterVelocity
+    (
+        const float rpm     // <I> - Wheel speed (range -SHOOTER_WHEEL_MAX_RPM to SHOOTER_WHEEL_MAX_RPM)
+    ) const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetShooterVelocity
+    // Description: This will return the shooter wheel speed measured by its encoder
+    // Returns:     float       RPM (positive is shooting)
+    //----------------------------------------------------------------------------------
+    float GetShooterVelocity() const override;
+
 
     //----------------------------------------------------------------------------------
     // Method:      SetBallLoadMotor
@@ -54,6 +80,22 @@ public:
     //----------------------------------------------------------------------------------
     bool IsLoaderInPosition() const override;
 
+    //----------------------------------------------------------------------------------
+    // Method:      GetLoaderReturns
+    // Description: This will return how many times the loader has come back to its load
+    //              position.  The sensor edge is caught by an interrupt, so a cycle is
+    //              counted even when the loader leaves and comes back between samples.
+    // Returns:     unsigned int    returns since the robot started (wraps around)
+    //----------------------------------------------------------------------------------
+    unsigned int GetLoaderReturns() const override;
+
+    //----------------------------------------------------------------------------------
+    // Method:      GetLoaderReturnTimestamp
+    // Description: This will return when the loader last came back to its load position.
+    // Returns:     double      FPGA time (seconds) of the sensor edge
+    //----------------------------------------------------------------------------------
+    double GetLoaderReturnTimestamp() const override;
+
     //----------------------------------------------------------------------------------
     // Method:      AlignShooter
     // Description: This will set the motor speed for shooter alignment.
@@ -98,13 +140,35 @@ private:
     //----------------------------------------------------------------------------------
     virtual ~Year1Shooter();
 
+    //----------------------------------------------------------------------------------
+    // Method:      LoaderReturned
+    // Description: Interrupt handler for the edge where the loader gets back to its
+    //              load position.  This runs on the WPILib interrupt thread.
+    // Returns:     void
+    //----------------------------------------------------------------------------------
+    static void LoaderReturned
+    (
+        uint32_t    interruptAssertedMask,  // <I> - edges that fired (unused; only one is enabled)
+        void*       param                   // <I> - the shooter
+    );
+
     // Drive Motors
-    CANTalon*           m_shooterWheel;
-    CANTalon*           m_shooterLoader;
-    CANTalon*           m_shooterAlign;
+    DragonTalon*        m_shooterWheel;
+    DragonTalon*        m_shooterLoader;
+    DragonTalon*        m_shooterAlign;
 
     DigitalInput*       m_loaderPosition;
+    std::atomic<unsigned int>   m_loaderReturns;            // set by LoaderReturned()
+    std::atomic<double>         m_loaderReturnTimestamp;    // set by LoaderReturned()
     DigitalInput*       m_shooterMaxAlign;
+
+    // Dashboard
+    DashboardPublisher*     m_dashboard;
+    const DASHBOARD_CHANNEL m_shooterInputChannel;
+    const DASHBOARD_CHANNEL m_shooterVelocityChannel;
+    const DASHBOARD_CHANNEL m_shooterLoadChannel;
+    const DASHBOARD_CHANNEL m_shooterAlignChannel;
+    const DASHBOARD_CHANNEL m_maxAngleChannel;
 };
 
 #endif /* SRC_YEAR1SHOOTER_H_ */
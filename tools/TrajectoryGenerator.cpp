@@ -0,0 +1,399 @@
+/*=============================================================================================
+ * TrajectoryGenerator.cpp
+ *=============================================================================================
+ *
+ * File Description:
+ *
+ * This host tool makes the trajectories for our autonomous routines ahead of time, so the
+ * roboRIO doesn't spend seconds of CPU on them at the start of autonomous.  For each routine
+ * in ROUTINES it:
+ *
+ *  - joins the waypoints with quintic Hermite splines (the position and heading of each
+ *    waypoint are matched and the curvature is zero at each waypoint, so the heading and
+ *    curvature are continuous)
+ *  - samples the splines finely and limits the speed at each point for the turn (lateral
+ *    acceleration, and the outside side staying under the maximum velocity), then speeds up
+ *    from a stop and slows down to a stop at the maximum acceleration
+ *  - steps through the result in time and writes a sample every SAMPLE_PERIOD_MS, with the
+ *    distance and speed of each side of the drive for the track width it was given
+ *
+ * and writes everything to one file in the layout of TrajectoryFormat.h, for TrajectoryFile to
+ * memory map on the robot.
+ *
+ * It is built and run on a development PC, not the robot.  The robot build compiles every
+ * source file, so the whole tool is inside #ifdef TRAJECTORY_GENERATOR.  From this directory:
+ *
+ *      g++ -std=c++11 -O2 -DTRAJECTORY_GENERATOR -I.. -o TrajectoryGenerator TrajectoryGenerator.cpp
+ *      ./TrajectoryGenerator trajectories.bin 2.0
+ *      scp trajectories.bin lvuser@roboRIO-302-frc.local:/home/lvuser/
+ *
+ * The track width must be the robot's DRIVE_TRACK_WIDTH; the robot won't use a file made for
+ * another one.
+ *=============================================================================================*/
+
+#ifdef TRAJECTORY_GENERATOR
+
+// Standard includes
+#include <cmath>                    // sqrt, atan2, cos, sin, fabs
+#include <cstdio>                   // printf, fopen, fwrite
+#include <cstdlib>                  // atof
+#include <cstring>                  // strncpy
+#include <vector>                   // std::vector
+
+// Team 302 includes
+#include <TrajectoryFormat.h>       // Layout of the file
+
+
+// One waypoint of a routine; the robot faces heading as it passes through (x, y)
+struct RoutineWaypoint
+{
+    double      x;                  // feet forward of the start
+    double      y;                  // feet to the left of the start
+    double      heading;            // degrees counterclockwise
+};
+
+struct Routine
+{
+    const char*             name;               // name the robot finds it by
+    bool                    reversed;           // true = drive it backwards
+    double                  maxVelocity;        // feet per second
+    double                  maxAcceleration;    // feet per second per second
+    double                  maxLateralAcceleration; // feet per second per second in the turns
+    int                     waypointCount;
+    const RoutineWaypoint*  waypoints;          // the first one is the start (0, 0, 0)
+};
+
+// One point of the finely sampled path
+struct PathPoint
+{
+    double      x;
+    double      y;
+    double      heading;            // radians, direction of travel
+    double      curvature;          // 1 / feet, for the direction of travel
+    double      distance;           // feet along the path
+    double      velocity;           // feet per second
+    double      time;               // seconds
+};
+
+static const int    SAMPLE_PERIOD_MS = 10;          // MotionProfileExecutor point period
+static const int    MAX_SAMPLES = 1500;             // MotionProfileExecutor point buffer
+static const int    STEPS_PER_SPLINE = 2000;        // fine samples between two waypoints
+static const double TANGENT_SCALE = 1.2;            // spline tangent length / waypoint spacing
+
+static const RoutineWaypoint CROSS_DEFENSE[] =
+{
+    {  0.0, 0.0, 0.0 },
+    { 14.0, 0.0, 0.0 }
+};
+
+static const RoutineWaypoint CROSS_AND_AIM[] =
+{
+    {  0.0, 0.0,  0.0 },
+    { 10.0, 0.0,  0.0 },
+    { 16.0, 4.0, 45.0 }
+};
+
+static const RoutineWaypoint BACK_UP_TO_SHOT[] =
+{
+    {  0.0, 0.0, 0.0 },
+    { -3.0, 0.0, 0.0 }
+};
+
+static const Routine ROUTINES[] =
+{
+    { "CrossDefense",   false, 6.0, 4.0, 4.0, 2, CROSS_DEFENSE },
+    { "CrossAndAim",    false, 6.0, 4.0, 4.0, 3, CROSS_AND_AIM },
+    { "BackUpToShot",   true,  3.0, 3.0, 4.0, 2, BACK_UP_TO_SHOT }
+};
+
+
+//----------------------------------------------------------------------------------
+// Method:      AddSpline
+// Description: Samples the quintic Hermite spline between two waypoints (first
+//              and second derivatives at the ends: heading * tangent length and 0)
+// Returns:     void
+//----------------------------------------------------------------------------------
+static void AddSpline
+(
+    const RoutineWaypoint&  start,      // <I> - first waypoint
+    const RoutineWaypoint&  end,        // <I> - second waypoint
+    bool                    reversed,   // <I> - true = travel is opposite the heading
+    std::vector<PathPoint>& path        // <IO> - fine samples (the first one isn't repeated)
+)
+{
+    double flip   = reversed ? M_PI : 0.0;
+    double scale  = TANGENT_SCALE * hypot( end.x - start.x, end.y - start.y );
+    double h0     = start.heading * M_PI / 180.0 + flip;
+    double h1     = end.heading * M_PI / 180.0 + flip;
+
+    // p(t) = sum c[n] t^n for each axis
+    double p0[2] = { start.x, start.y };
+    double p1[2] = { end.x, end.y };
+    double v0[2] = { scale * cos( h0 ), scale * sin( h0 ) };
+    double v1[2] = { scale * cos( h1 ), scale * sin( h1 ) };
+    double c[2][6];
+    for ( int axis=0; axis<2; ++axis )
+    {
+        c[axis][0] = p0[axis];
+        c[axis][1] = v0[axis];
+        c[axis][2] = 0.0;
+        c[axis][3] = -10.0 * p0[axis] - 6.0 * v0[axis] - 4.0 * v1[axis] + 10.0 * p1[axis];
+        c[axis][4] =  15.0 * p0[axis] + 8.0 * v0[axis] + 7.0 * v1[axis] - 15.0 * p1[axis];
+        c[axis][5] =  -6.0 * p0[axis] - 3.0 * v0[axis] - 3.0 * v1[axis] +  6.0 * p1[axis];
+    }
+
+    for ( int step=( path.empty() ? 0 : 1 ); step<=STEPS_PER_SPLINE; ++step )
+    {
+        double t = static_cast<double>( step ) / STEPS_PER_SPLINE;
+        double value[2];
+        double first[2];
+        double second[2];
+        for ( int axis=0; axis<2; ++axis )
+        {
+            const double* k = c[axis];
+            value[axis]  = k[0] + t * ( k[1] + t * ( k[2] + t * ( k[3] + t * ( k[4] + t * k[5] ) ) ) );
+            first[axis]  = k[1] + t * ( 2.0 * k[2] + t * ( 3.0 * k[3] + t * ( 4.0 * k[4] + t * 5.0 * k[5] ) ) );
+            second[axis] = 2.0 * k[2] + t * ( 6.0 * k[3] + t * ( 12.0 * k[4] + t * 20.0 * k[5] ) );
+        }
+
+        PathPoint point = {};
+        point.x       = value[0];
+        point.y       = value[1];
+        point.heading = atan2( first[1], first[0] );
+        double speed  = hypot( first[0], first[1] );
+        if ( speed > 0.0 )
+        {
+            point.curvature = ( first[0] * second[1] - first[1] * second[0] ) / ( speed * speed * speed );
+        }
+        if ( !path.empty() )
+        {
+            const PathPoint& last = path.back();
+            point.distance = last.distance + hypot( point.x - last.x, point.y - last.y );
+        }
+        path.push_back( point );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      TimeParameterize
+// Description: Sets the speed at each fine sample (turn and acceleration limits,
+//              starting and ending stopped) and the time it is reached
+// Returns:     void
+//----------------------------------------------------------------------------------
+static void TimeParameterize
+(
+    const Routine&          routine,    // <I> - limits
+    double                  trackWidth, // <I> - feet
+    std::vector<PathPoint>& path        // <IO> - fine samples
+)
+{
+    size_t count = path.size();
+    for ( size_t inx=0; inx<count; ++inx )
+    {
+        double curvature = fabs( path[inx].curvature );
+        double velocity  = routine.maxVelocity / ( 1.0 + curvature * trackWidth / 2.0 );
+        if ( curvature * velocity * velocity > routine.maxLateralAcceleration )
+        {
+            velocity = sqrt( routine.maxLateralAcceleration / curvature );
+        }
+        path[inx].velocity = velocity;
+    }
+
+    path[0].velocity = 0.0;
+    for ( size_t inx=1; inx<count; ++inx )
+    {
+        double step  = path[inx].distance - path[inx-1].distance;
+        double limit = sqrt( path[inx-1].velocity * path[inx-1].velocity + 2.0 * routine.maxAcceleration * step );
+        path[inx].velocity = fmin( path[inx].velocity, limit );
+    }
+
+    path[count-1].velocity = 0.0;
+    for ( size_t inx=count-1; inx>0; --inx )
+    {
+        double step  = path[inx].distance - path[inx-1].distance;
+        double limit = sqrt( path[inx].velocity * path[inx].velocity + 2.0 * routine.maxAcceleration * step );
+        path[inx-1].velocity = fmin( path[inx-1].velocity, limit );
+    }
+
+    // Constant acceleration between fine samples
+    path[0].time = 0.0;
+    for ( size_t inx=1; inx<count; ++inx )
+    {
+        double step = path[inx].distance - path[inx-1].distance;
+        double sum  = path[inx].velocity + path[inx-1].velocity;
+        path[inx].time = path[inx-1].time + ( ( sum > 0.0 ) ? 2.0 * step / sum : 0.0 );
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Method:      MakeSamples
+// Description: Steps through the path in time and makes the samples the robot
+//              drives (in the direction of the robot, with the side distances)
+// Returns:     bool    true  = made, false = too long for the robot's buffer
+//----------------------------------------------------------------------------------
+static bool MakeSamples
+(
+    const Routine&                  routine,    // <I> - reversed or not
+    double                          trackWidth, // <I> - feet
+    const std::vector<PathPoint>&   path,       // <I> - time parameterized fine samples
+    std::vector<TrajectorySample>&  samples     // <IO> - samples are added to the end
+)
+{
+    double period    = SAMPLE_PERIOD_MS / 1000.0;
+    double totalTime = path.back().time;
+    int    count     = static_cast<int>( ceil( totalTime / period ) );
+    if ( count < 1 )
+    {
+        count = 1;
+    }
+    if ( count > MAX_SAMPLES )
+    {
+        printf( "%s takes %.2f seconds; the robot can only run %.2f\n",
+                routine.name, totalTime, MAX_SAMPLES * period );
+        return false;
+    }
+
+    // Side distances along the fine samples (each side drives ds * ( 1 -/+ curvature * w / 2 ))
+    std::vector<double> left( path.size(), 0.0 );
+    std::vector<double> right( path.size(), 0.0 );
+    for ( size_t inx=1; inx<path.size(); ++inx )
+    {
+        double step      = path[inx].distance - path[inx-1].distance;
+        double curvature = ( path[inx].curvature + path[inx-1].curvature ) / 2.0;
+        left[inx]  = left[inx-1]  + step * ( 1.0 - curvature * trackWidth / 2.0 );
+        right[inx] = right[inx-1] + step * ( 1.0 + curvature * trackWidth / 2.0 );
+    }
+
+    size_t fine = 1;
+    for ( int inx=0; inx<count; ++inx )
+    {
+        // Each sample is where the robot should be at the end of its period
+        double time = fmin( ( inx + 1 ) * period, totalTime );
+        while ( fine < path.size() - 1 && path[fine].time < time )
+        {
+            ++fine;
+        }
+        const PathPoint& a = path[fine-1];
+        const PathPoint& b = path[fine];
+        double span     = b.time - a.time;
+        double fraction = ( span > 0.0 ) ? ( time - a.time ) / span : 1.0;
+        double accel    = ( span > 0.0 ) ? ( b.velocity - a.velocity ) / span : 0.0;
+        double velocity = a.velocity + accel * ( time - a.time );
+        double curvature = a.curvature + ( b.curvature - a.curvature ) * fraction;
+        if ( inx == count - 1 )
+        {
+            fraction = 1.0;
+            velocity = 0.0;
+        }
+
+        double heading = a.heading + remainder( b.heading - a.heading, 2.0 * M_PI ) * fraction;
+        double leftVelocity  = velocity * ( 1.0 - curvature * trackWidth / 2.0 );
+        double rightVelocity = velocity * ( 1.0 + curvature * trackWidth / 2.0 );
+
+        TrajectorySample sample = {};
+        sample.x            = a.x + ( b.x - a.x ) * fraction;
+        sample.y            = a.y + ( b.y - a.y ) * fraction;
+        sample.curvature    = curvature;
+        if ( routine.reversed )
+        {
+            // Backwards, the robot's left side drives the path's right side
+            sample.heading       = remainder( heading + M_PI, 2.0 * M_PI );
+            sample.velocity      = -velocity;
+            sample.acceleration  = -accel;
+            sample.leftPosition  = -( right[fine-1] + ( right[fine] - right[fine-1] ) * fraction );
+            sample.leftVelocity  = -rightVelocity;
+            sample.rightPosition = -( left[fine-1] + ( left[fine] - left[fine-1] ) * fraction );
+            sample.rightVelocity = -leftVelocity;
+        }
+        else
+        {
+            sample.heading       = heading;
+            sample.velocity      = velocity;
+            sample.acceleration  = accel;
+            sample.leftPosition  = left[fine-1] + ( left[fine] - left[fine-1] ) * fraction;
+            sample.leftVelocity  = leftVelocity;
+            sample.rightPosition = right[fine-1] + ( right[fine] - right[fine-1] ) * fraction;
+            sample.rightVelocity = rightVelocity;
+        }
+        samples.push_back( sample );
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Method:      main
+// Description: Makes every routine and writes the trajectory file
+// Returns:     int     0 = written
+//----------------------------------------------------------------------------------
+int main
+(
+    int         argc,
+    char**      argv
+)
+{
+    if ( argc != 3 || atof( argv[2] ) <= 0.0 )
+    {
+        printf( "usage: %s <output file> <track width in feet>\n", argv[0] );
+        return 1;
+    }
+    const char* output     = argv[1];
+    double      trackWidth = atof( argv[2] );
+
+    std::vector<TrajectoryIndexEntry> index;
+    std::vector<TrajectorySample>     samples;
+    for ( const Routine& routine : ROUTINES )
+    {
+        if ( routine.waypointCount < 2 || strlen( routine.name ) >= TRAJECTORY_NAME_LENGTH )
+        {
+            printf( "%s needs at least 2 waypoints and a shorter name\n", routine.name );
+            return 1;
+        }
+
+        std::vector<PathPoint> path;
+        for ( int inx=1; inx<routine.waypointCount; ++inx )
+        {
+            AddSpline( routine.waypoints[inx-1], routine.waypoints[inx], routine.reversed, path );
+        }
+        TimeParameterize( routine, trackWidth, path );
+
+        TrajectoryIndexEntry entry = {};
+        strncpy( entry.name, routine.name, TRAJECTORY_NAME_LENGTH - 1 );
+        entry.firstSample = samples.size();
+        if ( !MakeSamples( routine, trackWidth, path, samples ) )
+        {
+            return 1;
+        }
+        entry.sampleCount = samples.size() - entry.firstSample;
+        index.push_back( entry );
+
+        printf( "%-31s %6.2f ft  %5.2f s  %4u samples\n", routine.name,
+                path.back().distance, path.back().time, entry.sampleCount );
+    }
+
+    TrajectoryFileHeader header = {};
+    header.magic           = TRAJECTORY_FILE_MAGIC;
+    header.version         = TRAJECTORY_FILE_VERSION;
+    header.trajectoryCount = index.size();
+    header.sampleCount     = samples.size();
+    header.sampleSize      = sizeof( TrajectorySample );
+    header.samplePeriodMs  = SAMPLE_PERIOD_MS;
+    header.trackWidth      = trackWidth;
+
+    FILE* file = fopen( output, "wb" );
+    bool  written = ( file != nullptr ) &&
+                    fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+                    fwrite( index.data(), sizeof( TrajectoryIndexEntry ), index.size(), file ) == index.size() &&
+                    fwrite( samples.data(), sizeof( TrajectorySample ), samples.size(), file ) == samples.size();
+    if ( file != nullptr && fclose( file ) != 0 )
+    {
+        written = false;
+    }
+    if ( !written )
+    {
+        printf( "can't write %s\n", output );
+        return 1;
+    }
+    return 0;
+}
+
+#endif /* TRAJECTORY_GENERATOR */